@@ -0,0 +1,78 @@
+/*
+ * Copyright (c) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef OHOS_HIVIEWDFX_SYS_EVENT_LISTENER_QUEUE_H
+#define OHOS_HIVIEWDFX_SYS_EVENT_LISTENER_QUEUE_H
+
+#include <atomic>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+
+#include "isys_event_callback.h"
+
+namespace OHOS {
+namespace HiviewDFX {
+struct SysEventPayload {
+    std::u16string domain;
+    std::u16string name;
+    uint32_t eventType = 0;
+    std::u16string detail;
+};
+using SysEventPayloadPtr = std::shared_ptr<const SysEventPayload>;
+
+/*
+ * Bounded delivery queue of one listener. Payloads are handed over to the
+ * remote callback on the ffrt worker pool with at most one drain task in flight,
+ * so the order of events is kept and a slow client only delays itself.
+ */
+class SysEventListenerQueue : public std::enable_shared_from_this<SysEventListenerQueue> {
+public:
+    SysEventListenerQueue(const sptr<ISysEventCallback>& callback, int32_t pid,
+        size_t maxPendingNum = DEFAULT_MAX_PENDING_NUM);
+    ~SysEventListenerQueue() = default;
+
+public:
+    bool Enqueue(SysEventPayloadPtr payload);
+    void Stop();
+    size_t GetPendingCount();
+    uint64_t GetDeliveredCount() const;
+    uint64_t GetDroppedCount() const;
+
+public:
+    static constexpr size_t DEFAULT_MAX_PENDING_NUM = 1000;
+    static constexpr size_t MAX_BATCH_NUM = 50;
+
+private:
+    void ScheduleDrain();
+    void Drain();
+
+private:
+    sptr<ISysEventCallback> callback_;
+    int32_t pid_ = 0;
+    size_t maxPendingNum_ = DEFAULT_MAX_PENDING_NUM;
+    std::mutex deliverMutex_; // held across each callback, so Stop waits for the one in flight
+    std::mutex mutex_;
+    std::deque<SysEventPayloadPtr> pending_;
+    bool isScheduled_ = false;
+    bool isStopped_ = false;
+    std::atomic<uint64_t> deliveredCnt_ = 0;
+    std::atomic<uint64_t> droppedCnt_ = 0;
+};
+} // namespace HiviewDFX
+} // namespace OHOS
+
+#endif // OHOS_HIVIEWDFX_SYS_EVENT_LISTENER_QUEUE_H
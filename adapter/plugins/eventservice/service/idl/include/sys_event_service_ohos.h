@@ -18,6 +18,8 @@
 
 #include <atomic>
 #include <functional>
+#include <memory>
+#include <regex>
 #include <vector>
 #include <unordered_map>
 
@@ -30,6 +32,7 @@
 #include "query_argument.h"
 #include "singleton.h"
 #include "sys_event_dao.h"
+#include "sys_event_listener_queue.h"
 #include "sys_event_query.h"
 #include "sys_event_query_rule.h"
 #include "sys_event_rule.h"
@@ -80,11 +83,28 @@ public:
     void SetWorkLoop(std::shared_ptr<EventLoop> looper);
 
 private:
+    struct CompiledContent {
+        std::string content;
+        std::shared_ptr<const std::regex> pattern;
+        bool isValid = true;
+    };
+
+    struct CompiledRule {
+        uint32_t ruleType = 0;
+        uint32_t eventType = 0;
+        bool hasTag = false;
+        CompiledContent domain;
+        CompiledContent eventName;
+        CompiledContent tag;
+    };
+
     struct ListenerInfo {
         int32_t pid = 0;
         int32_t uid = 0;
-        std::vector<SysEventRule> rules;
+        std::vector<CompiledRule> rules;
+        std::shared_ptr<SysEventListenerQueue> queue;
     };
+    using ListenerSnapshot = std::vector<std::shared_ptr<const ListenerInfo>>;
 
 private:
     bool HasAccessPermission() const;
@@ -93,11 +113,18 @@ private:
     std::string GetTagByDomainAndName(const std::string& eventDomain, const std::string& eventName);
     uint32_t GetTypeByDomainAndName(const std::string& eventDomain, const std::string& eventName);
     void MergeEventList(const std::vector<SysEventQueryRule>& rules, std::vector<std::string>& events) const;
+    static CompiledContent CompileContent(uint32_t ruleType, const std::string& content);
+    static std::vector<CompiledRule> CompileRules(const std::vector<SysEventRule>& rules);
+    static bool MatchContent(uint32_t ruleType, const CompiledContent& rule, const std::string& match);
+    static bool MatchRules(const std::vector<CompiledRule>& rules, const std::string& domain,
+        const std::string& eventName, const std::string& tag, uint32_t eventType);
+    void RefreshListenerSnapshot();
 
 private:
     sptr<CallbackDeathRecipient> deathRecipient_;
     std::mutex listenersMutex_;
-    std::map<OHOS::sptr<OHOS::IRemoteObject>, ListenerInfo> registeredListeners_;
+    std::map<OHOS::sptr<OHOS::IRemoteObject>, std::shared_ptr<const ListenerInfo>> registeredListeners_;
+    std::shared_ptr<const ListenerSnapshot> listenerSnapshot_;
     bool isDebugMode_;
     OHOS::sptr<ISysEventCallback> debugModeCallback_;
     GetTagByDomainNameFunc getTagFunc_;
@@ -0,0 +1,127 @@
+/*
+ * Copyright (c) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "sys_event_listener_queue.h"
+
+#include <algorithm>
+#include <cinttypes>
+#include <iterator>
+#include <vector>
+
+#include "ffrt.h"
+#include "hiview_logger.h"
+
+namespace OHOS {
+namespace HiviewDFX {
+DEFINE_LOG_TAG("HiView-SysEventListenerQueue");
+namespace {
+constexpr uint64_t DROP_LOG_INTERVAL = 100;
+}
+
+SysEventListenerQueue::SysEventListenerQueue(const sptr<ISysEventCallback>& callback, int32_t pid,
+    size_t maxPendingNum) : callback_(callback), pid_(pid), maxPendingNum_(maxPendingNum)
+{}
+
+bool SysEventListenerQueue::Enqueue(SysEventPayloadPtr payload)
+{
+    if (payload == nullptr) {
+        return false;
+    }
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (isStopped_) {
+        return false;
+    }
+    if (pending_.size() >= maxPendingNum_) {
+        auto droppedCnt = ++droppedCnt_;
+        if (droppedCnt % DROP_LOG_INTERVAL == 1) {
+            HIVIEW_LOGW("queue of pid %{public}d is full, %{public}" PRIu64 " events dropped.", pid_, droppedCnt);
+        }
+        return false;
+    }
+    pending_.emplace_back(std::move(payload));
+    if (!isScheduled_) {
+        isScheduled_ = true;
+        ScheduleDrain();
+    }
+    return true;
+}
+
+void SysEventListenerQueue::ScheduleDrain()
+{
+    auto self = shared_from_this();
+    ffrt::submit([self] () {
+            self->Drain();
+        }, {}, {}, ffrt::task_attr().name("dft_sysevent_cb").qos(ffrt::qos_default));
+}
+
+void SysEventListenerQueue::Drain()
+{
+    std::vector<SysEventPayloadPtr> batch;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        size_t batchNum = std::min(pending_.size(), MAX_BATCH_NUM);
+        batch.assign(std::make_move_iterator(pending_.begin()),
+            std::make_move_iterator(pending_.begin() + batchNum));
+        pending_.erase(pending_.begin(), pending_.begin() + batchNum);
+    }
+    for (const auto& payload : batch) {
+        std::lock_guard<std::mutex> deliverLock(deliverMutex_);
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (isStopped_) {
+                // the listener is removed or dead, drop the rest of the batch
+                isScheduled_ = false;
+                return;
+            }
+        }
+        if (callback_ != nullptr) {
+            callback_->Handle(payload->domain, payload->name, payload->eventType, payload->detail);
+        }
+        ++deliveredCnt_;
+    }
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (isStopped_ || pending_.empty()) {
+        isScheduled_ = false;
+        return;
+    }
+    // yield the worker between batches so that other listeners are not starved
+    ScheduleDrain();
+}
+
+void SysEventListenerQueue::Stop()
+{
+    std::lock_guard<std::mutex> deliverLock(deliverMutex_);
+    std::lock_guard<std::mutex> lock(mutex_);
+    isStopped_ = true;
+    pending_.clear();
+}
+
+size_t SysEventListenerQueue::GetPendingCount()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return pending_.size();
+}
+
+uint64_t SysEventListenerQueue::GetDeliveredCount() const
+{
+    return deliveredCnt_;
+}
+
+uint64_t SysEventListenerQueue::GetDroppedCount() const
+{
+    return droppedCnt_;
+}
+} // namespace HiviewDFX
+} // namespace OHOS
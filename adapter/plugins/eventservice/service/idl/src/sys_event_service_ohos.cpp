@@ -15,6 +15,7 @@
 
 #include "sys_event_service_ohos.h"
 
+#include <cinttypes>
 #include <codecvt>
 #include <regex>
 #include <set>
@@ -51,70 +52,11 @@ const string READ_DFX_SYSEVENT_PERMISSION = "ohos.permission.READ_DFX_SYSEVENT";
 const string DFX_DUMP_PERMISSION = "ohos.permission.DUMP";
 constexpr size_t REGEX_LEN_LIMIT = 32; // max(domainLen, nameLen, tagLen)
 
-bool IsMatchedWithRegex(const string& rule, const string& match)
-{
-    if (rule.empty()) {
-        return true;
-    }
-    if ((rule.length() > REGEX_LEN_LIMIT) || !StringUtil::IsValidRegex(rule)) {
-        return false;
-    }
-    smatch result;
-    const regex pattern(rule);
-    return regex_search(match, result, pattern);
-}
-
-bool MatchContent(int type, const string& rule, const string& match)
-{
-    if (match.empty()) {
-        return false;
-    }
-    switch (type) {
-        case RuleType::WHOLE_WORD:
-            return rule.empty() || match.compare(rule) == 0;
-        case RuleType::PREFIX:
-            return rule.empty() || match.find(rule) == 0;
-        case RuleType::REGULAR:
-            return IsMatchedWithRegex(rule, match);
-        default:
-            HIVIEW_LOGE("invalid rule type %{public}d.", type);
-            return false;
-    }
-}
-
-bool MatchEventType(int rule, int match)
+bool MatchEventType(uint32_t rule, uint32_t match)
 {
     return rule == INVALID_EVENT_TYPE || rule == match;
 }
 
-bool IsMatchedRule(const OHOS::HiviewDFX::SysEventRule& rule, const string& domain,
-    const string& eventName, const string& tag, uint32_t eventType)
-{
-    if (rule.tag.empty()) {
-        return MatchContent(rule.ruleType, rule.domain, domain)
-            && MatchContent(rule.ruleType, rule.eventName, eventName)
-            && MatchEventType(rule.eventType, eventType);
-    }
-    return MatchContent(rule.ruleType, rule.tag, tag)
-        && MatchEventType(rule.eventType, eventType);
-}
-
-bool MatchRules(const std::vector<SysEventRule>& rules, const string& domain, const string& eventName,
-    const string& tag, uint32_t eventType)
-{
-    return any_of(rules.begin(), rules.end(), [domain, eventName, tag, eventType] (auto& rule) {
-        if (IsMatchedRule(rule, domain, eventName, tag, eventType)) {
-            HIVIEW_LOGD("rule type is %{public}d, domain is %{public}s, eventName is %{public}s, "
-                "tag is %{public}s, eventType is %{public}u for matched",
-                rule.ruleType, rule.domain.empty() ? "empty" : rule.domain.c_str(),
-                rule.eventName.empty() ? "empty" : rule.eventName.c_str(),
-                rule.tag.empty() ? "empty" : rule.tag.c_str(), eventType);
-            return true;
-        }
-        return false;
-    });
-}
-
 int32_t CheckEventSubscriberAddingValidity(const std::vector<std::string>& events)
 {
     size_t maxEventNum = 30;  // count of total events is limited to 30.
@@ -179,33 +121,123 @@ uint32_t SysEventServiceOhos::GetTypeByDomainAndName(const string& eventDomain,
     return getTypeFunc_(eventDomain, eventName);
 }
 
+SysEventServiceOhos::CompiledContent SysEventServiceOhos::CompileContent(uint32_t ruleType, const string& content)
+{
+    CompiledContent compiled {content, nullptr, true};
+    if (ruleType != RuleType::REGULAR || content.empty()) {
+        return compiled;
+    }
+    if ((content.length() > REGEX_LEN_LIMIT) || !StringUtil::IsValidRegex(content)) {
+        HIVIEW_LOGW("invalid regex rule %{public}s.", content.c_str());
+        compiled.isValid = false;
+        return compiled;
+    }
+    compiled.pattern = std::make_shared<const regex>(content);
+    return compiled;
+}
+
+std::vector<SysEventServiceOhos::CompiledRule> SysEventServiceOhos::CompileRules(
+    const std::vector<SysEventRule>& rules)
+{
+    std::vector<CompiledRule> compiledRules;
+    compiledRules.reserve(rules.size());
+    for (const auto& rule : rules) {
+        CompiledRule compiledRule;
+        compiledRule.ruleType = rule.ruleType;
+        compiledRule.eventType = rule.eventType;
+        compiledRule.hasTag = !rule.tag.empty();
+        if (compiledRule.hasTag) {
+            compiledRule.tag = CompileContent(rule.ruleType, rule.tag);
+        } else {
+            compiledRule.domain = CompileContent(rule.ruleType, rule.domain);
+            compiledRule.eventName = CompileContent(rule.ruleType, rule.eventName);
+        }
+        compiledRules.emplace_back(std::move(compiledRule));
+    }
+    return compiledRules;
+}
+
+bool SysEventServiceOhos::MatchContent(uint32_t ruleType, const CompiledContent& rule, const string& match)
+{
+    if (match.empty()) {
+        return false;
+    }
+    switch (ruleType) {
+        case RuleType::WHOLE_WORD:
+            return rule.content.empty() || match.compare(rule.content) == 0;
+        case RuleType::PREFIX:
+            return rule.content.empty() || match.compare(0, rule.content.length(), rule.content) == 0;
+        case RuleType::REGULAR:
+            if (!rule.isValid) {
+                return false;
+            }
+            return rule.pattern == nullptr || regex_search(match, *rule.pattern);
+        default:
+            HIVIEW_LOGE("invalid rule type %{public}u.", ruleType);
+            return false;
+    }
+}
+
+bool SysEventServiceOhos::MatchRules(const std::vector<CompiledRule>& rules, const string& domain,
+    const string& eventName, const string& tag, uint32_t eventType)
+{
+    return any_of(rules.begin(), rules.end(), [&domain, &eventName, &tag, eventType] (const auto& rule) {
+        if (!MatchEventType(rule.eventType, eventType)) {
+            return false;
+        }
+        if (rule.hasTag) {
+            return MatchContent(rule.ruleType, rule.tag, tag);
+        }
+        return MatchContent(rule.ruleType, rule.domain, domain) &&
+            MatchContent(rule.ruleType, rule.eventName, eventName);
+    });
+}
+
+void SysEventServiceOhos::RefreshListenerSnapshot()
+{
+    auto snapshot = std::make_shared<ListenerSnapshot>();
+    snapshot->reserve(registeredListeners_.size());
+    for (const auto& listener : registeredListeners_) {
+        snapshot->emplace_back(listener.second);
+    }
+    std::atomic_store(&listenerSnapshot_, std::shared_ptr<const ListenerSnapshot>(snapshot));
+}
+
 void SysEventServiceOhos::OnSysEvent(std::shared_ptr<SysEvent>& event)
 {
     {
         lock_guard<mutex> lock(publisherMutex_);
         dataPublisher_->OnSysEvent(event);
     }
-    lock_guard<mutex> lock(listenersMutex_);
-    CompliantEventChecker compliantEventChecker;
-    for (auto listener = registeredListeners_.begin(); listener != registeredListeners_.end(); ++listener) {
-        OHOS::sptr<ISysEventCallback> callback = iface_cast<ISysEventCallback>(listener->first);
-        if (callback == nullptr) {
-            HIVIEW_LOGE("interface is null, no need to match rules.");
-            continue;
+    auto listeners = std::atomic_load(&listenerSnapshot_);
+    if (listeners == nullptr || listeners->empty()) {
+        return;
+    }
+    std::string tag = event->GetTag();
+    uint32_t eventType = static_cast<uint32_t>(event->eventType_);
+    // the payload and the compliance result are shared by all matched listeners of this event
+    SysEventPayloadPtr payload = nullptr;
+    int isCompliant = -1;
+    for (const auto& listener : *listeners) {
+        if (listener->uid == HID_SHELL) {
+            if (isCompliant < 0) {
+                isCompliant = CompliantEventChecker().IsCompliantEvent(event->domain_, event->eventName_) ? 1 : 0;
+            }
+            if (isCompliant == 0) {
+                HIVIEW_LOGD("event [%{public}s|%{public}s] isn't compliant for the process with uid %{public}d",
+                    event->domain_.c_str(), event->eventName_.c_str(), listener->uid);
+                continue;
+            }
         }
-        if ((listener->second.uid == HID_SHELL) &&
-            !compliantEventChecker.IsCompliantEvent(event->domain_, event->eventName_)) {
-            HIVIEW_LOGD("event [%{public}s|%{public}s] isn't compliant for the process with uid %{public}d",
-                event->domain_.c_str(), event->eventName_.c_str(), listener->second.uid);
+        if (!MatchRules(listener->rules, event->domain_, event->eventName_, tag, eventType)) {
             continue;
         }
-        bool isMatched = MatchRules(listener->second.rules, event->domain_, event->eventName_,
-            event->GetTag(), event->eventType_);
-        HIVIEW_LOGD("pid %{public}d rules match %{public}s.", listener->second.pid, isMatched ? "success" : "fail");
-        if (isMatched) {
-            callback->Handle(Str8ToStr16(event->domain_), Str8ToStr16(event->eventName_),
-                static_cast<uint32_t>(event->eventType_), Str8ToStr16(event->AsJsonStr()));
+        HIVIEW_LOGD("pid %{public}d rules match success.", listener->pid);
+        if (payload == nullptr) {
+            payload = std::make_shared<const SysEventPayload>(SysEventPayload {Str8ToStr16(event->domain_),
+                Str8ToStr16(event->eventName_), eventType, Str8ToStr16(event->AsJsonStr())});
         }
+        listener->queue->Enqueue(payload);
     }
 }
 
@@ -235,8 +267,10 @@ void SysEventServiceOhos::OnRemoteDied(const wptr<IRemoteObject>& remote)
     auto listener = registeredListeners_.find(remoteObject);
     if (listener != registeredListeners_.end()) {
         listener->first->RemoveDeathRecipient(deathRecipient_);
-        HIVIEW_LOGE("pid %{public}d has died and remove listener.", listener->second.pid);
+        HIVIEW_LOGE("pid %{public}d has died and remove listener.", listener->second->pid);
+        listener->second->queue->Stop();
         registeredListeners_.erase(listener);
+        RefreshListenerSnapshot();
     }
 }
 
@@ -290,20 +324,29 @@ int32_t SysEventServiceOhos::AddListener(const std::vector<SysEventRule>& rules,
         HIVIEW_LOGE("subscribe fail, object in callback is null.");
         return ERR_LISTENER_STATUS_INVALID;
     }
-    ListenerInfo listenerInfo {IPCSkeleton::GetCallingPid(), IPCSkeleton::GetCallingUid(), rules};
-    if (registeredListeners_.find(callbackObject) != registeredListeners_.end()) {
-        registeredListeners_[callbackObject] = listenerInfo;
+    auto listenerInfo = std::make_shared<ListenerInfo>();
+    listenerInfo->pid = IPCSkeleton::GetCallingPid();
+    listenerInfo->uid = IPCSkeleton::GetCallingUid();
+    listenerInfo->rules = CompileRules(rules);
+    auto registeredListener = registeredListeners_.find(callbackObject);
+    if (registeredListener != registeredListeners_.end()) {
+        // keep the delivery queue so that pending events survive the rules update
+        listenerInfo->queue = registeredListener->second->queue;
+        registeredListener->second = listenerInfo;
+        RefreshListenerSnapshot();
         HIVIEW_LOGD("uid %{public}d pid %{public}d listener has been added and update rules.",
-            listenerInfo.uid, listenerInfo.pid);
+            listenerInfo->uid, listenerInfo->pid);
         return IPC_CALL_SUCCEED;
     }
     if (!callbackObject->AddDeathRecipient(deathRecipient_)) {
         HIVIEW_LOGE("subscribe fail, can not add death recipient.");
         return ERR_ADD_DEATH_RECIPIENT;
     }
+    listenerInfo->queue = std::make_shared<SysEventListenerQueue>(callback, listenerInfo->pid);
     registeredListeners_.insert(make_pair(callbackObject, listenerInfo));
+    RefreshListenerSnapshot();
     HIVIEW_LOGD("uid %{public}d pid %{public}d listener is added successfully, total is %{public}zu.",
-        listenerInfo.uid, listenerInfo.pid, registeredListeners_.size());
+        listenerInfo->uid, listenerInfo->pid, registeredListeners_.size());
     return IPC_CALL_SUCCEED;
 }
 
@@ -339,7 +382,9 @@ int32_t SysEventServiceOhos::RemoveListener(const OHOS::sptr<ISysEventCallback>&
             HIVIEW_LOGE("uid %{public}d pid %{public}d listener can not remove death recipient.", uid, pid);
             return ERR_ADD_DEATH_RECIPIENT;
         }
+        registeredListener->second->queue->Stop();
         registeredListeners_.erase(registeredListener);
+        RefreshListenerSnapshot();
         HIVIEW_LOGD("uid %{public}d pid %{public}d has found listener and removes it.", uid, pid);
         return IPC_CALL_SUCCEED;
     } else {
@@ -469,6 +514,16 @@ int SysEventServiceOhos::Dump(int32_t fd, const std::vector<std::u16string> &arg
         return -1;
     }
     dprintf(fd, "%s\n", "Hiview SysEventService");
+    auto listeners = std::atomic_load(&listenerSnapshot_);
+    if (listeners == nullptr) {
+        return 0;
+    }
+    dprintf(fd, "listeners: %zu\n", listeners->size());
+    for (const auto& listener : *listeners) {
+        dprintf(fd, "pid=%d, uid=%d, rules=%zu, pending=%zu, delivered=%" PRIu64 ", dropped=%" PRIu64 "\n",
+            listener->pid, listener->uid, listener->rules.size(), listener->queue->GetPendingCount(),
+            listener->queue->GetDeliveredCount(), listener->queue->GetDroppedCount());
+    }
     return 0;
 }
 
@@ -15,9 +15,12 @@
 
 #include "sys_event_service_ohos_test.h"
 
+#include <chrono>
 #include <cstdlib>
+#include <future>
 #include <semaphore.h>
 #include <string>
+#include <thread>
 #include <vector>
 
 #include "ash_mem_utils.h"
@@ -45,6 +48,7 @@
 #include "string_ex.h"
 #include "string_util.h"
 #include "sys_event_callback_proxy.h"
+#include "sys_event_listener_queue.h"
 #include "sys_event_service_stub.h"
 #include "time_util.h"
 
@@ -124,6 +128,29 @@ public:
     };
 };
 
+class BlockedSysEventCallback : public ISysEventCallback {
+public:
+    void Handle(const std::u16string& domain, const std::u16string& eventName, uint32_t eventType,
+        const std::u16string& eventDetail) override
+    {
+        if (!isEntered_) {
+            isEntered_ = true;
+            entered_.set_value();
+            released_.get_future().wait();
+        }
+    }
+
+    sptr<IRemoteObject> AsObject() override
+    {
+        return nullptr;
+    }
+
+public:
+    bool isEntered_ = false;
+    std::promise<void> entered_;
+    std::promise<void> released_;
+};
+
 class HiviewTestContext : public HiviewContext {
 public:
     std::string GetHiViewDirectory(DirectoryType type __UNUSED)
@@ -434,5 +461,75 @@ HWTEST_F(SysEventServiceOhosTest, QueryWrapperTest02, testing::ext::TestSize.Lev
     auto queryWrapper = queryWrapperBuilder->Build();
     ASSERT_TRUE(queryWrapper != nullptr);
 }
+
+/**
+ * @tc.name: SysEventListenerQueueTest001
+ * @tc.desc: a blocked listener keeps a bounded backlog and counts the dropped events.
+ * @tc.type: FUNC
+ * @tc.require: issueI62WJT
+ */
+HWTEST_F(SysEventServiceOhosTest, SysEventListenerQueueTest001, testing::ext::TestSize.Level1)
+{
+    sptr<BlockedSysEventCallback> callback = new BlockedSysEventCallback();
+    auto enteredFuture = callback->entered_.get_future();
+    constexpr size_t maxPendingNum = 2;
+    auto queue = std::make_shared<SysEventListenerQueue>(callback, 0, maxPendingNum);
+    auto payload = std::make_shared<const SysEventPayload>(
+        SysEventPayload {u"DOMAIN", u"NAME", 1, u"{\"domain_\":\"DOMAIN\"}"});
+    ASSERT_TRUE(queue->Enqueue(payload));
+    ASSERT_EQ(enteredFuture.wait_for(std::chrono::seconds(5)), std::future_status::ready);
+
+    // the first event is being handled, so the queue takes two more and drops the rest
+    ASSERT_TRUE(queue->Enqueue(payload));
+    ASSERT_TRUE(queue->Enqueue(payload));
+    ASSERT_FALSE(queue->Enqueue(payload));
+    ASSERT_EQ(queue->GetPendingCount(), maxPendingNum);
+    ASSERT_EQ(queue->GetDroppedCount(), 1);
+
+    callback->released_.set_value();
+    constexpr int maxWaitTimes = 100;
+    for (int i = 0; i < maxWaitTimes && queue->GetDeliveredCount() < 3; ++i) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(50)); // 50ms
+    }
+    ASSERT_EQ(queue->GetDeliveredCount(), 3);
+    ASSERT_EQ(queue->GetPendingCount(), 0);
+
+    queue->Stop();
+    ASSERT_FALSE(queue->Enqueue(payload));
+    ASSERT_EQ(queue->GetDroppedCount(), 1);
+}
+
+/**
+ * @tc.name: SysEventListenerQueueTest002
+ * @tc.desc: no event is handed to the callback after the queue is stopped.
+ * @tc.type: FUNC
+ * @tc.require: issueI62WJT
+ */
+HWTEST_F(SysEventServiceOhosTest, SysEventListenerQueueTest002, testing::ext::TestSize.Level1)
+{
+    sptr<BlockedSysEventCallback> callback = new BlockedSysEventCallback();
+    auto enteredFuture = callback->entered_.get_future();
+    auto queue = std::make_shared<SysEventListenerQueue>(callback, 0);
+    auto payload = std::make_shared<const SysEventPayload>(
+        SysEventPayload {u"DOMAIN", u"NAME", 1, u"{\"domain_\":\"DOMAIN\"}"});
+    ASSERT_TRUE(queue->Enqueue(payload));
+    ASSERT_EQ(enteredFuture.wait_for(std::chrono::seconds(5)), std::future_status::ready);
+    constexpr int pendingNum = 10;
+    for (int i = 0; i < pendingNum; ++i) {
+        ASSERT_TRUE(queue->Enqueue(payload));
+    }
+
+    // stop waits for the callback in flight and nothing is delivered after it returns
+    auto stopFuture = std::async(std::launch::async, [queue] () {
+        queue->Stop();
+    });
+    std::this_thread::sleep_for(std::chrono::milliseconds(50)); // 50ms
+    callback->released_.set_value();
+    ASSERT_EQ(stopFuture.wait_for(std::chrono::seconds(5)), std::future_status::ready);
+    auto deliveredCnt = queue->GetDeliveredCount();
+    std::this_thread::sleep_for(std::chrono::milliseconds(200)); // 200ms
+    ASSERT_EQ(queue->GetDeliveredCount(), deliveredCnt);
+    ASSERT_EQ(queue->GetPendingCount(), 0);
+}
 } // namespace HiviewDFX
-} // namespace OHOS
\ No newline at end of file
+} // namespace OHOS
@@ -142,6 +142,27 @@ void RawData::Reset()
     len_ = 0;
 }
 
+bool RawData::Reset(size_t capacity)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    len_ = 0;
+    if (data_ != nullptr && capacity_ >= capacity) {
+        // keep the buffer, it is big enough to be written again
+        return true;
+    }
+    if (data_ != nullptr) {
+        delete[] data_;
+        data_ = nullptr;
+    }
+    capacity_ = 0;
+    data_ = new(std::nothrow) uint8_t[capacity];
+    if (data_ == nullptr) {
+        return false;
+    }
+    capacity_ = capacity;
+    return true;
+}
+
 bool RawData::Append(uint8_t* data, size_t len)
 {
     if (len == 0) {
@@ -206,6 +227,11 @@ size_t RawData::GetDataLength() const
 {
     return len_;
 }
+
+size_t RawData::GetCapacity() const
+{
+    return capacity_;
+}
 } // namespace EventRaw
 } // namespace HiviewDFX
 } // namespace OHOS
\ No newline at end of file
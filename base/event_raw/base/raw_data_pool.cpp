@@ -0,0 +1,86 @@
+/*
+ * Copyright (c) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "base/raw_data_pool.h"
+
+#include <new>
+
+#include "hiview_logger.h"
+
+namespace OHOS {
+namespace HiviewDFX {
+namespace EventRaw {
+DEFINE_LOG_TAG("HiView-RawDataPool");
+namespace {
+constexpr size_t MAX_IDLE_CNT = 256;
+// buffers bigger than this are rare, keeping them would pin too much memory
+constexpr size_t MAX_RECYCLE_CAPACITY = 16 * 1024;
+}
+
+RawDataPool& RawDataPool::GetInstance()
+{
+    // never destroyed, raw datas may still be released while statics are torn down
+    static RawDataPool* instance = new RawDataPool();
+    return *instance;
+}
+
+std::shared_ptr<RawData> RawDataPool::Acquire(size_t capacity)
+{
+    RawData* rawData = nullptr;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (!idleDatas_.empty()) {
+            rawData = idleDatas_.back();
+            idleDatas_.pop_back();
+        }
+    }
+    if (rawData == nullptr) {
+        rawData = new(std::nothrow) RawData(capacity);
+        if (rawData == nullptr) {
+            HIVIEW_LOGE("failed to new raw data.");
+            return nullptr;
+        }
+    } else if (!rawData->Reset(capacity)) {
+        HIVIEW_LOGE("failed to reset raw data, capacity=%{public}zu.", capacity);
+        delete rawData;
+        return nullptr;
+    }
+    return std::shared_ptr<RawData>(rawData, [this] (RawData* data) {
+        Recycle(data);
+    });
+}
+
+size_t RawDataPool::GetIdleCount()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return idleDatas_.size();
+}
+
+void RawDataPool::Recycle(RawData* rawData)
+{
+    if (rawData == nullptr) {
+        return;
+    }
+    if (rawData->GetCapacity() <= MAX_RECYCLE_CAPACITY) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (idleDatas_.size() < MAX_IDLE_CNT) {
+            idleDatas_.emplace_back(rawData);
+            return;
+        }
+    }
+    delete rawData;
+}
+} // namespace EventRaw
+} // namespace HiviewDFX
+} // namespace OHOS
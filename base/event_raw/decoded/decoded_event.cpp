@@ -15,13 +15,11 @@
 
 #include "decoded/decoded_event.h"
 
-#include <functional>
 #include <securec.h>
-#include <sstream>
-#include <unordered_map>
 
 #include "base/raw_data_base_def.h"
 #include "decoded/raw_data_decoder.h"
+#include "decoded/raw_data_json_writer.h"
 #include "hiview_logger.h"
 
 namespace OHOS {
@@ -31,18 +29,6 @@ DEFINE_LOG_TAG("HiView-DecodedEvent");
 namespace {
 constexpr size_t MAX_BLOCK_SIZE = 384 * 1024; // 384K
 constexpr size_t MAX_PARAM_CNT = 128 + 10; // 128 for Write, 10 for hiview
-
-std::string TransUInt64ToFixedLengthStr(uint64_t src)
-{
-    const size_t maxIdLen = 20;
-    std::string uint64Str = std::to_string(src);
-    if (uint64Str.size() >= maxIdLen) {
-        return uint64Str;
-    }
-    std::string dest(maxIdLen, '0');
-    dest.replace(maxIdLen - uint64Str.size(), uint64Str.size(), uint64Str);
-    return dest;
-}
 }
 
 DecodedEvent::DecodedEvent(uint8_t* src)
@@ -76,160 +62,19 @@ DecodedEvent::~DecodedEvent()
     }
 }
 
-void DecodedEvent::AppendBaseInfo(std::stringstream& ss)
-{
-    char* domain = new(std::nothrow) char[MAX_DOMAIN_LENGTH + 1];
-    if (domain == nullptr) {
-        return;
-    }
-    if (memcpy_s(domain, MAX_DOMAIN_LENGTH, header_.domain, MAX_DOMAIN_LENGTH) != EOK) {
-        delete[] domain;
-        return;
-    }
-    domain[MAX_DOMAIN_LENGTH] = '\0';
-    auto eventDomain = std::string(domain);
-    AppendValue(ss, BASE_INFO_KEY_DOMAIN, eventDomain);
-    delete[] domain;
-    char* name = new(std::nothrow) char[MAX_EVENT_NAME_LENGTH + 1];
-    if (name == nullptr) {
-        return;
-    }
-    if (memcpy_s(name, MAX_EVENT_NAME_LENGTH, header_.name, MAX_EVENT_NAME_LENGTH) != EOK) {
-        delete[] name;
-        return;
-    }
-    name[MAX_EVENT_NAME_LENGTH] = '\0';
-    auto eventName = std::string(name);
-    AppendValue(ss, BASE_INFO_KEY_NAME, eventName);
-    delete[] name;
-    AppendValue(ss, BASE_INFO_KEY_TYPE, (static_cast<int>(header_.type) + 1)); // header_.type is only 2 bits which has
-                                                                          // been subtracted 1 before wrote.
-    AppendValue(ss, BASE_INFO_KEY_TIME_STAMP, header_.timestamp);
-    auto timeZone = ParseTimeZone(static_cast<size_t>(header_.timeZone));
-    AppendValue(ss, BASE_INFO_KEY_TIME_ZONE, timeZone);
-    AppendValue(ss, BASE_INFO_KEY_PID, header_.pid);
-    AppendValue(ss, BASE_INFO_KEY_TID, header_.tid);
-    AppendValue(ss, BASE_INFO_KEY_UID, header_.uid);
-    AppendValue(ss, BASE_INFO_KEY_LOG, static_cast<uint32_t>(header_.log));
-    AppendValue(ss, BASE_INFO_KEY_ID, TransUInt64ToFixedLengthStr(header_.id));
-    if (header_.isTraceOpened == 1) {
-        AppendValue(ss, BASE_INFO_KEY_TRACE_FLAG, static_cast<int>(traceInfo_.traceFlag));
-        AppendValue(ss, BASE_INFO_KEY_TRACE_ID, TransNumToHexStr(traceInfo_.traceId));
-        AppendValue(ss, BASE_INFO_KEY_SPAN_ID, TransNumToHexStr(traceInfo_.spanId));
-        AppendValue(ss, BASE_INFO_KEY_PARENT_SPAN_ID, TransNumToHexStr(traceInfo_.pSpanId));
-    }
-}
-
-void DecodedEvent::AppendCustomizedArrayParam(std::stringstream& ss, std::shared_ptr<DecodedParam> param)
-{
-    std::unordered_map<DataCodedType, std::function<void(std::shared_ptr<DecodedParam>)>> allFuncs = {
-        {DataCodedType::UNSIGNED_VARINT_ARRAY, [this, &ss](std::shared_ptr<DecodedParam> param) {
-                std::vector<uint64_t> u64Vec;
-                if (param->AsUint64Vec(u64Vec)) {
-                    this->AppendValue(ss, param->GetKey(), u64Vec);
-                }
-            }
-        },
-        {DataCodedType::SIGNED_VARINT_ARRAY, [this, &ss](std::shared_ptr<DecodedParam> param) {
-                std::vector<int64_t> i64Vec;
-                if (param->AsInt64Vec(i64Vec)) {
-                    this->AppendValue(ss, param->GetKey(), i64Vec);
-                }
-            }
-        },
-        {DataCodedType::FLOATING_ARRAY, [this, &ss](std::shared_ptr<DecodedParam> param) {
-                std::vector<double> dVec;
-                if (param->AsDoubleVec(dVec)) {
-                    this->AppendValue(ss, param->GetKey(), dVec);
-                }
-            }
-        },
-        {DataCodedType::DSTRING_ARRAY, [this, &ss](std::shared_ptr<DecodedParam> param) {
-                std::vector<std::string> strVec;
-                if (param->AsStringVec(strVec)) {
-                    this->AppendValue(ss, param->GetKey(), strVec);
-                }
-            }
-        }
-    };
-    auto iter = allFuncs.find(param->GetDataCodedType());
-    if (iter == allFuncs.end()) {
-        return;
-    }
-    iter->second(param);
-}
-
-void DecodedEvent::AppendCustomizedParam(std::stringstream& ss, std::shared_ptr<DecodedParam> param)
-{
-    std::unordered_map<DataCodedType, std::function<void(std::shared_ptr<DecodedParam>)>> allFuncs = {
-        {DataCodedType::UNSIGNED_VARINT, [this, &ss](std::shared_ptr<DecodedParam> param) {
-                uint64_t uint64DecodedVal;
-                if (param->AsUint64(uint64DecodedVal)) {
-                    this->AppendValue(ss, param->GetKey(), uint64DecodedVal);
-                }
-            }
-        },
-        {DataCodedType::SIGNED_VARINT, [this, &ss](std::shared_ptr<DecodedParam> param) {
-                int64_t int64DecodedVal;
-                if (param->AsInt64(int64DecodedVal)) {
-                    this->AppendValue(ss, param->GetKey(), int64DecodedVal);
-                }
-            }
-        },
-        {DataCodedType::FLOATING, [this, &ss](std::shared_ptr<DecodedParam> param) {
-                double dDecodedVal;
-                if (param->AsDouble(dDecodedVal)) {
-                    this->AppendValue(ss, param->GetKey(), dDecodedVal);
-                }
-            }
-        },
-        {DataCodedType::DSTRING, [this, &ss](std::shared_ptr<DecodedParam> param) {
-                std::string strDecodedVal;
-                if (param->AsString(strDecodedVal)) {
-                    this->AppendValue(ss, param->GetKey(), strDecodedVal);
-                }
-            }
-        }
-    };
-    auto iter = allFuncs.find(param->GetDataCodedType());
-    if (iter == allFuncs.end()) {
-        return;
-    }
-    iter->second(param);
-}
-
-void DecodedEvent::AppendCustomizedParams(std::stringstream& ss)
-{
-    for (auto param: allParams_) {
-        if (param == nullptr) {
-            continue;
-        }
-        std::vector<DataCodedType> noArrayEncodedTypes = {
-            DataCodedType::UNSIGNED_VARINT,
-            DataCodedType::SIGNED_VARINT,
-            DataCodedType::FLOATING,
-            DataCodedType::DSTRING,
-        };
-        if (find(noArrayEncodedTypes.begin(), noArrayEncodedTypes.end(), param->GetDataCodedType()) !=
-            noArrayEncodedTypes.end()) {
-            AppendCustomizedParam(ss, param);
-            continue;
-        }
-        AppendCustomizedArrayParam(ss, param);
-    }
-}
-
 std::string DecodedEvent::AsJsonStr()
 {
-    std::stringstream jsonStream;
-    jsonStream << "{";
-    AppendBaseInfo(jsonStream);
-    AppendCustomizedParams(jsonStream);
-    if (jsonStream.tellp() != 0) {
-        jsonStream.seekp(-1, std::ios_base::end);
+    std::string jsonStr;
+    RawDataJsonWriter writer(jsonStr);
+    writer.WriteHeader(header_, traceInfo_);
+    if (rawData_ != nullptr) {
+        size_t blockSize = static_cast<size_t>(*(reinterpret_cast<int32_t*>(rawData_)));
+        size_t paramPos = sizeof(int32_t) + sizeof(struct HiSysEventHeader) +
+            ((header_.isTraceOpened == 1) ? sizeof(struct TraceInfo) : 0); // 1: include trace info
+        (void)writer.WriteCustomizedParams(rawData_, blockSize, paramPos);
     }
-    jsonStream << "}";
-    return jsonStream.str();
+    writer.Finish();
+    return jsonStr;
 }
 
 std::shared_ptr<RawData> DecodedEvent::GetRawData()
@@ -84,6 +84,24 @@ bool RawDataDecoder::StringValueDecoded(uint8_t* rawData, const size_t maxLen, s
     return true;
 }
 
+bool RawDataDecoder::StringValueRefDecoded(uint8_t* rawData, const size_t maxLen, size_t& pos, const char*& dest,
+    size_t& destLen)
+{
+    if (rawData == nullptr || pos >= maxLen) {
+        return false;
+    }
+    uint64_t valByteCnt = 0; // default 0
+    if (!UnsignedVarintDecoded(rawData, maxLen, pos, valByteCnt) ||
+        valByteCnt > maxLen || // for value flip
+        ((pos + valByteCnt) > maxLen)) {
+        return false;
+    }
+    dest = reinterpret_cast<char*>(rawData + pos);
+    destLen = static_cast<size_t>(valByteCnt);
+    pos += valByteCnt;
+    return true;
+}
+
 bool RawDataDecoder::UnsignedVarintDecoded(uint8_t* rawData, const size_t maxLen, size_t& pos, uint64_t& dest)
 {
     if (rawData == nullptr || pos >= maxLen) {
@@ -0,0 +1,330 @@
+/*
+ * Copyright (c) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "decoded/raw_data_index.h"
+
+#include <cstring>
+
+#include "decoded/raw_data_decoder.h"
+
+namespace OHOS {
+namespace HiviewDFX {
+namespace EventRaw {
+namespace {
+constexpr size_t MAX_BLOCK_SIZE = 384 * 1024; // 384K
+constexpr size_t MAX_PARAM_CNT = 128 + 10; // 128 for Write, 10 for hiview
+
+DataCodedType GetDataCodedType(const struct ParamValueType& valueType, bool& isValid)
+{
+    bool isArray = (valueType.isArray == 1);
+    isValid = true;
+    switch (ValueType(valueType.valueType)) {
+        case ValueType::STRING:
+            return isArray ? DataCodedType::DSTRING_ARRAY : DataCodedType::DSTRING;
+        case ValueType::FLOAT:
+        case ValueType::DOUBLE:
+            return isArray ? DataCodedType::FLOATING_ARRAY : DataCodedType::FLOATING;
+        case ValueType::UINT8:
+        case ValueType::UINT16:
+        case ValueType::UINT32:
+        case ValueType::UINT64:
+            return isArray ? DataCodedType::UNSIGNED_VARINT_ARRAY : DataCodedType::UNSIGNED_VARINT;
+        case ValueType::BOOL:
+        case ValueType::INT8:
+        case ValueType::INT16:
+        case ValueType::INT32:
+        case ValueType::INT64:
+            return isArray ? DataCodedType::SIGNED_VARINT_ARRAY : DataCodedType::SIGNED_VARINT;
+        default:
+            isValid = false;
+            return DataCodedType::DSTRING;
+    }
+}
+
+template<typename T>
+bool DecodeArray(uint8_t* rawData, const size_t maxLen, size_t pos, std::vector<T>& dest,
+    bool (*itemDecoder)(uint8_t*, const size_t, size_t&, T&))
+{
+    dest.clear();
+    uint64_t size = 0;
+    if (!RawDataDecoder::UnsignedVarintDecoded(rawData, maxLen, pos, size)) {
+        return false;
+    }
+    for (; size > 0; --size) {
+        T item {};
+        if (!itemDecoder(rawData, maxLen, pos, item)) {
+            return false;
+        }
+        dest.emplace_back(std::move(item));
+    }
+    return true;
+}
+}
+
+RawDataIndex::RawDataIndex(std::shared_ptr<RawData> rawData) : rawData_(rawData)
+{
+    Init();
+}
+
+void RawDataIndex::Init()
+{
+    if (rawData_ == nullptr || rawData_->GetData() == nullptr ||
+        rawData_->GetDataLength() < GetValidDataMinimumByteCount()) {
+        return;
+    }
+    uint8_t* data = rawData_->GetData();
+    maxLen_ = static_cast<size_t>(*(reinterpret_cast<int32_t*>(data)));
+    if (maxLen_ < GetValidDataMinimumByteCount() || maxLen_ > MAX_BLOCK_SIZE ||
+        maxLen_ > rawData_->GetDataLength()) {
+        return;
+    }
+    isValid_ = true;
+    size_t pos = sizeof(int32_t) + sizeof(struct HiSysEventHeader);
+    if (GetHeader().isTraceOpened == 1) { // 1: include trace info, 0: exclude trace info
+        pos += sizeof(struct TraceInfo);
+    }
+    if ((pos + sizeof(int32_t)) > maxLen_) {
+        return;
+    }
+    auto paramCnt = static_cast<size_t>(*(reinterpret_cast<int32_t*>(data + pos)));
+    if (paramCnt > MAX_PARAM_CNT) {
+        return;
+    }
+    pos += sizeof(int32_t);
+    params_.reserve(paramCnt);
+    for (; paramCnt > 0; --paramCnt) {
+        const char* key = nullptr;
+        size_t keyLen = 0;
+        struct ParamValueType valueType {
+            .isArray = 0,
+            .valueType = static_cast<uint8_t>(ValueType::UNKNOWN),
+            .valueByteCnt = 0,
+        };
+        if (!RawDataDecoder::StringValueRefDecoded(data, maxLen_, pos, key, keyLen) ||
+            !RawDataDecoder::ValueTypeDecoded(data, maxLen_, pos, valueType)) {
+            return;
+        }
+        bool isTypeValid = false;
+        ParamEntry entry {GetDataCodedType(valueType, isTypeValid), pos};
+        if (!isTypeValid || !SkipValue(valueType, pos)) {
+            // keep the params indexed before, which is the same as DecodedEvent
+            return;
+        }
+        // the latter one wins if the key is duplicated, which is the same as RawDataBuilder
+        params_[std::string_view(key, keyLen)] = entry;
+    }
+}
+
+bool RawDataIndex::SkipValue(const struct ParamValueType& valueType, size_t& pos) const
+{
+    uint8_t* data = rawData_->GetData();
+    uint64_t size = 1;
+    if (valueType.isArray == 1 && !RawDataDecoder::UnsignedVarintDecoded(data, maxLen_, pos, size)) {
+        return false;
+    }
+    for (; size > 0; --size) {
+        bool ret = false;
+        switch (ValueType(valueType.valueType)) {
+            case ValueType::STRING: {
+                const char* val = nullptr;
+                size_t len = 0;
+                ret = RawDataDecoder::StringValueRefDecoded(data, maxLen_, pos, val, len);
+                break;
+            }
+            case ValueType::FLOAT:
+            case ValueType::DOUBLE: {
+                double val = 0.0;
+                ret = RawDataDecoder::FloatingNumberDecoded(data, maxLen_, pos, val);
+                break;
+            }
+            default: {
+                uint64_t val = 0;
+                ret = RawDataDecoder::UnsignedVarintDecoded(data, maxLen_, pos, val);
+                break;
+            }
+        }
+        if (!ret) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool RawDataIndex::IsValid() const
+{
+    return isValid_;
+}
+
+std::shared_ptr<RawData> RawDataIndex::GetRawData() const
+{
+    return rawData_;
+}
+
+size_t RawDataIndex::GetParamCnt() const
+{
+    return params_.size();
+}
+
+struct HiSysEventHeader RawDataIndex::GetHeader() const
+{
+    return *(reinterpret_cast<struct HiSysEventHeader*>(rawData_->GetData() + sizeof(int32_t)));
+}
+
+struct TraceInfo RawDataIndex::GetTraceInfo() const
+{
+    struct TraceInfo traceInfo {
+        .traceFlag = 0,
+        .traceId = 0,
+        .spanId = 0,
+        .pSpanId = 0,
+    };
+    size_t pos = sizeof(int32_t) + sizeof(struct HiSysEventHeader);
+    if (GetHeader().isTraceOpened == 1 && (pos + sizeof(struct TraceInfo)) <= maxLen_) {
+        traceInfo = *(reinterpret_cast<struct TraceInfo*>(rawData_->GetData() + pos));
+    }
+    return traceInfo;
+}
+
+bool RawDataIndex::IsBaseInfo(const std::string& key)
+{
+    // all keys of base info end with '_' while the customized ones are checked to be not
+    return !key.empty() && key.back() == '_' && (key == BASE_INFO_KEY_DOMAIN || key == BASE_INFO_KEY_NAME ||
+        key == BASE_INFO_KEY_TYPE || key == BASE_INFO_KEY_TIME_STAMP || key == BASE_INFO_KEY_LOG ||
+        key == BASE_INFO_KEY_TIME_ZONE || key == BASE_INFO_KEY_ID || key == BASE_INFO_KEY_PID ||
+        key == BASE_INFO_KEY_TID || key == BASE_INFO_KEY_UID || key == BASE_INFO_KEY_TRACE_ID ||
+        key == BASE_INFO_KEY_SPAN_ID || key == BASE_INFO_KEY_PARENT_SPAN_ID || key == BASE_INFO_KEY_TRACE_FLAG);
+}
+
+bool RawDataIndex::ParseBaseInfoValue(const std::string& key, uint64_t& dest) const
+{
+    auto header = GetHeader();
+    if (key == BASE_INFO_KEY_TIME_STAMP) {
+        dest = header.timestamp;
+    } else if (key == BASE_INFO_KEY_TIME_ZONE) {
+        dest = header.timeZone;
+    } else if (key == BASE_INFO_KEY_ID) {
+        dest = header.id;
+    } else if (key == BASE_INFO_KEY_PID) {
+        dest = header.pid;
+    } else if (key == BASE_INFO_KEY_TID) {
+        dest = header.tid;
+    } else if (key == BASE_INFO_KEY_UID) {
+        dest = header.uid;
+    } else if (key == BASE_INFO_KEY_LOG) {
+        dest = header.log;
+    } else if (key == BASE_INFO_KEY_TRACE_ID) {
+        dest = GetTraceInfo().traceId;
+    } else if (key == BASE_INFO_KEY_SPAN_ID) {
+        dest = GetTraceInfo().spanId;
+    } else if (key == BASE_INFO_KEY_PARENT_SPAN_ID) {
+        dest = GetTraceInfo().pSpanId;
+    } else if (key == BASE_INFO_KEY_TRACE_FLAG) {
+        dest = GetTraceInfo().traceFlag;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+bool RawDataIndex::ParseBaseInfoValue(const std::string& key, int64_t& dest) const
+{
+    if (key != BASE_INFO_KEY_TYPE) {
+        return false;
+    }
+    dest = static_cast<int64_t>(GetHeader().type) + 1; // header.type is only 2 bits which has been subtracted 1
+    return true;
+}
+
+bool RawDataIndex::ParseBaseInfoValue(const std::string& key, std::string& dest) const
+{
+    auto header = GetHeader();
+    if (key == BASE_INFO_KEY_DOMAIN) {
+        dest = std::string(header.domain, strnlen(header.domain, MAX_DOMAIN_LENGTH));
+    } else if (key == BASE_INFO_KEY_NAME) {
+        dest = std::string(header.name, strnlen(header.name, MAX_EVENT_NAME_LENGTH));
+    } else if (key == BASE_INFO_KEY_TIME_ZONE) {
+        dest = ParseTimeZone(header.timeZone);
+    } else if (key == BASE_INFO_KEY_TRACE_ID) {
+        dest = TransNumToHexStr(GetTraceInfo().traceId);
+    } else if (key == BASE_INFO_KEY_SPAN_ID) {
+        dest = TransNumToHexStr(GetTraceInfo().spanId);
+    } else if (key == BASE_INFO_KEY_PARENT_SPAN_ID) {
+        dest = TransNumToHexStr(GetTraceInfo().pSpanId);
+    } else {
+        return false;
+    }
+    return true;
+}
+
+bool RawDataIndex::ParseParamValue(const ParamEntry& entry, uint64_t& dest) const
+{
+    size_t pos = entry.pos;
+    return entry.codedType == DataCodedType::UNSIGNED_VARINT &&
+        RawDataDecoder::UnsignedVarintDecoded(rawData_->GetData(), maxLen_, pos, dest);
+}
+
+bool RawDataIndex::ParseParamValue(const ParamEntry& entry, int64_t& dest) const
+{
+    size_t pos = entry.pos;
+    return entry.codedType == DataCodedType::SIGNED_VARINT &&
+        RawDataDecoder::SignedVarintDecoded(rawData_->GetData(), maxLen_, pos, dest);
+}
+
+bool RawDataIndex::ParseParamValue(const ParamEntry& entry, double& dest) const
+{
+    size_t pos = entry.pos;
+    return entry.codedType == DataCodedType::FLOATING &&
+        RawDataDecoder::FloatingNumberDecoded(rawData_->GetData(), maxLen_, pos, dest);
+}
+
+bool RawDataIndex::ParseParamValue(const ParamEntry& entry, std::string& dest) const
+{
+    size_t pos = entry.pos;
+    const char* val = nullptr;
+    size_t len = 0;
+    if (entry.codedType != DataCodedType::DSTRING ||
+        !RawDataDecoder::StringValueRefDecoded(rawData_->GetData(), maxLen_, pos, val, len)) {
+        return false;
+    }
+    dest.assign(val, len);
+    return true;
+}
+
+bool RawDataIndex::ParseParamValue(const ParamEntry& entry, std::vector<uint64_t>& dest) const
+{
+    return entry.codedType == DataCodedType::UNSIGNED_VARINT_ARRAY &&
+        DecodeArray(rawData_->GetData(), maxLen_, entry.pos, dest, RawDataDecoder::UnsignedVarintDecoded);
+}
+
+bool RawDataIndex::ParseParamValue(const ParamEntry& entry, std::vector<int64_t>& dest) const
+{
+    return entry.codedType == DataCodedType::SIGNED_VARINT_ARRAY &&
+        DecodeArray(rawData_->GetData(), maxLen_, entry.pos, dest, RawDataDecoder::SignedVarintDecoded);
+}
+
+bool RawDataIndex::ParseParamValue(const ParamEntry& entry, std::vector<double>& dest) const
+{
+    return entry.codedType == DataCodedType::FLOATING_ARRAY &&
+        DecodeArray(rawData_->GetData(), maxLen_, entry.pos, dest, RawDataDecoder::FloatingNumberDecoded);
+}
+
+bool RawDataIndex::ParseParamValue(const ParamEntry& entry, std::vector<std::string>& dest) const
+{
+    return entry.codedType == DataCodedType::DSTRING_ARRAY &&
+        DecodeArray(rawData_->GetData(), maxLen_, entry.pos, dest, RawDataDecoder::StringValueDecoded);
+}
+} // namespace EventRaw
+} // namespace HiviewDFX
+} // namespace OHOS
@@ -0,0 +1,302 @@
+/*
+ * Copyright (c) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "decoded/raw_data_json_writer.h"
+
+#include <algorithm>
+#include <charconv>
+#include <cstdio>
+#include <cstring>
+
+#include "decoded/raw_data_decoder.h"
+
+namespace OHOS {
+namespace HiviewDFX {
+namespace EventRaw {
+namespace {
+constexpr size_t MAX_BLOCK_SIZE = 384 * 1024; // 384K
+constexpr size_t MAX_PARAM_CNT = 128 + 10; // 128 for Write, 10 for hiview
+constexpr size_t MAX_NUM_STR_LEN = 32;
+constexpr size_t EVENT_ID_STR_LEN = 20;
+constexpr int HEX_BASE = 16;
+}
+
+void RawDataJsonWriter::AddExtraField(const std::string& key, const std::string& value)
+{
+    std::string quoted;
+    quoted.reserve(value.size() + 2); // 2: two quotation marks
+    quoted.append("\"").append(value).append("\"");
+    extraFields_.push_back({key, std::move(quoted), false});
+}
+
+void RawDataJsonWriter::AddExtraField(const std::string& key, int64_t value)
+{
+    extraFields_.push_back({key, std::to_string(value), false});
+}
+
+bool RawDataJsonWriter::Write(uint8_t* rawData)
+{
+    if (rawData == nullptr) {
+        return false;
+    }
+    size_t blockSize = static_cast<size_t>(*(reinterpret_cast<int32_t*>(rawData)));
+    if (blockSize < GetValidDataMinimumByteCount() || blockSize > MAX_BLOCK_SIZE) {
+        return false;
+    }
+    size_t pos = sizeof(int32_t);
+    auto header = *(reinterpret_cast<struct HiSysEventHeader*>(rawData + pos));
+    pos += sizeof(struct HiSysEventHeader);
+    struct TraceInfo traceInfo {
+        .traceFlag = 0,
+        .traceId = 0,
+        .spanId = 0,
+        .pSpanId = 0,
+    };
+    if (header.isTraceOpened == 1) { // 1: include trace info, 0: exclude trace info
+        if ((pos + sizeof(struct TraceInfo)) > blockSize) {
+            return false;
+        }
+        traceInfo = *(reinterpret_cast<struct TraceInfo*>(rawData + pos));
+        pos += sizeof(struct TraceInfo);
+    }
+    // the json string is about twice the size of the encoded bytes
+    buffer_.reserve(buffer_.size() + blockSize * 2);
+    WriteHeader(header, traceInfo);
+    bool ret = WriteCustomizedParams(rawData, blockSize, pos);
+    Finish();
+    return ret;
+}
+
+void RawDataJsonWriter::WriteHeader(const struct HiSysEventHeader& header, const struct TraceInfo& traceInfo)
+{
+    buffer_.push_back('{');
+    WriteKey(BASE_INFO_KEY_DOMAIN, sizeof(BASE_INFO_KEY_DOMAIN) - 1);
+    WriteString(header.domain, strnlen(header.domain, MAX_DOMAIN_LENGTH));
+    WriteKey(BASE_INFO_KEY_NAME, sizeof(BASE_INFO_KEY_NAME) - 1);
+    WriteString(header.name, strnlen(header.name, MAX_EVENT_NAME_LENGTH));
+    WriteKey(BASE_INFO_KEY_TYPE, sizeof(BASE_INFO_KEY_TYPE) - 1);
+    WriteInteger(static_cast<int>(header.type) + 1); // header.type is only 2 bits which has been subtracted 1
+    WriteKey(BASE_INFO_KEY_TIME_STAMP, sizeof(BASE_INFO_KEY_TIME_STAMP) - 1);
+    WriteInteger(header.timestamp);
+    WriteKey(BASE_INFO_KEY_TIME_ZONE, sizeof(BASE_INFO_KEY_TIME_ZONE) - 1);
+    auto timeZone = ParseTimeZone(header.timeZone);
+    WriteString(timeZone.c_str(), timeZone.size());
+    WriteKey(BASE_INFO_KEY_PID, sizeof(BASE_INFO_KEY_PID) - 1);
+    WriteInteger(header.pid);
+    WriteKey(BASE_INFO_KEY_TID, sizeof(BASE_INFO_KEY_TID) - 1);
+    WriteInteger(header.tid);
+    WriteKey(BASE_INFO_KEY_UID, sizeof(BASE_INFO_KEY_UID) - 1);
+    WriteInteger(header.uid);
+    WriteKey(BASE_INFO_KEY_LOG, sizeof(BASE_INFO_KEY_LOG) - 1);
+    WriteInteger(static_cast<uint32_t>(header.log));
+    WriteKey(BASE_INFO_KEY_ID, sizeof(BASE_INFO_KEY_ID) - 1);
+    char idStr[MAX_NUM_STR_LEN];
+    auto result = std::to_chars(idStr, idStr + sizeof(idStr), header.id);
+    size_t idLen = static_cast<size_t>(result.ptr - idStr);
+    buffer_.push_back('"');
+    if (idLen < EVENT_ID_STR_LEN) {
+        buffer_.append(EVENT_ID_STR_LEN - idLen, '0');
+    }
+    buffer_.append(idStr, idLen).push_back('"');
+    if (header.isTraceOpened != 1) {
+        return;
+    }
+    WriteKey(BASE_INFO_KEY_TRACE_FLAG, sizeof(BASE_INFO_KEY_TRACE_FLAG) - 1);
+    WriteInteger(static_cast<int>(traceInfo.traceFlag));
+    WriteKey(BASE_INFO_KEY_TRACE_ID, sizeof(BASE_INFO_KEY_TRACE_ID) - 1);
+    buffer_.push_back('"');
+    WriteInteger(traceInfo.traceId, HEX_BASE);
+    buffer_.push_back('"');
+    WriteKey(BASE_INFO_KEY_SPAN_ID, sizeof(BASE_INFO_KEY_SPAN_ID) - 1);
+    buffer_.push_back('"');
+    WriteInteger(traceInfo.spanId, HEX_BASE);
+    buffer_.push_back('"');
+    WriteKey(BASE_INFO_KEY_PARENT_SPAN_ID, sizeof(BASE_INFO_KEY_PARENT_SPAN_ID) - 1);
+    buffer_.push_back('"');
+    WriteInteger(traceInfo.pSpanId, HEX_BASE);
+    buffer_.push_back('"');
+}
+
+bool RawDataJsonWriter::WriteCustomizedParams(uint8_t* rawData, const size_t maxLen, size_t pos)
+{
+    if ((pos + sizeof(int32_t)) > maxLen) {
+        return false;
+    }
+    auto paramCnt = static_cast<size_t>(*(reinterpret_cast<int32_t*>(rawData + pos)));
+    if (paramCnt > MAX_PARAM_CNT) {
+        return false;
+    }
+    pos += sizeof(int32_t);
+    for (; paramCnt > 0; --paramCnt) {
+        size_t lastSize = buffer_.size();
+        bool lastIsFirstField = isFirstField_;
+        if (!WriteCustomizedParam(rawData, maxLen, pos)) {
+            // drop the broken param, the params decoded before are kept
+            buffer_.resize(lastSize);
+            isFirstField_ = lastIsFirstField;
+            return false;
+        }
+    }
+    return true;
+}
+
+void RawDataJsonWriter::Finish()
+{
+    for (const auto& field : extraFields_) {
+        if (field.isDuplicated) {
+            continue;
+        }
+        WriteKey(field.key.c_str(), field.key.size());
+        buffer_.append(field.value);
+    }
+    buffer_.push_back('}');
+}
+
+bool RawDataJsonWriter::WriteCustomizedParam(uint8_t* rawData, const size_t maxLen, size_t& pos)
+{
+    const char* key = nullptr;
+    size_t keyLen = 0;
+    if (!RawDataDecoder::StringValueRefDecoded(rawData, maxLen, pos, key, keyLen)) {
+        return false;
+    }
+    struct ParamValueType valueType {
+        .isArray = 0,
+        .valueType = static_cast<uint8_t>(ValueType::UNKNOWN),
+        .valueByteCnt = 0,
+    };
+    if (!RawDataDecoder::ValueTypeDecoded(rawData, maxLen, pos, valueType)) {
+        return false;
+    }
+    WriteKey(key, keyLen);
+    MarkDuplicatedExtraField(key, keyLen);
+    if (valueType.isArray == 1) {
+        return WriteArrayValue(rawData, maxLen, pos, valueType.valueType);
+    }
+    return WriteValue(rawData, maxLen, pos, valueType.valueType);
+}
+
+bool RawDataJsonWriter::WriteValue(uint8_t* rawData, const size_t maxLen, size_t& pos, uint8_t valueType)
+{
+    switch (ValueType(valueType)) {
+        case ValueType::STRING: {
+            const char* val = nullptr;
+            size_t len = 0;
+            if (!RawDataDecoder::StringValueRefDecoded(rawData, maxLen, pos, val, len)) {
+                return false;
+            }
+            WriteString(val, len);
+            return true;
+        }
+        case ValueType::FLOAT:
+        case ValueType::DOUBLE: {
+            double val = 0.0;
+            if (!RawDataDecoder::FloatingNumberDecoded(rawData, maxLen, pos, val)) {
+                return false;
+            }
+            WriteDouble(val);
+            return true;
+        }
+        case ValueType::UINT8:
+        case ValueType::UINT16:
+        case ValueType::UINT32:
+        case ValueType::UINT64: {
+            uint64_t val = 0;
+            if (!RawDataDecoder::UnsignedVarintDecoded(rawData, maxLen, pos, val)) {
+                return false;
+            }
+            WriteInteger(val);
+            return true;
+        }
+        case ValueType::BOOL:
+        case ValueType::INT8:
+        case ValueType::INT16:
+        case ValueType::INT32:
+        case ValueType::INT64: {
+            int64_t val = 0;
+            if (!RawDataDecoder::SignedVarintDecoded(rawData, maxLen, pos, val)) {
+                return false;
+            }
+            WriteInteger(val);
+            return true;
+        }
+        default:
+            return false;
+    }
+}
+
+bool RawDataJsonWriter::WriteArrayValue(uint8_t* rawData, const size_t maxLen, size_t& pos, uint8_t valueType)
+{
+    uint64_t size = 0;
+    if (!RawDataDecoder::UnsignedVarintDecoded(rawData, maxLen, pos, size)) {
+        return false;
+    }
+    buffer_.push_back('[');
+    for (uint64_t i = 0; i < size; ++i) {
+        if (i > 0) {
+            buffer_.push_back(',');
+        }
+        if (!WriteValue(rawData, maxLen, pos, valueType)) {
+            return false;
+        }
+    }
+    buffer_.push_back(']');
+    return true;
+}
+
+void RawDataJsonWriter::WriteKey(const char* key, size_t len)
+{
+    if (!isFirstField_) {
+        buffer_.push_back(',');
+    }
+    isFirstField_ = false;
+    buffer_.push_back('"');
+    buffer_.append(key, len).append("\":");
+}
+
+void RawDataJsonWriter::WriteString(const char* val, size_t len)
+{
+    buffer_.push_back('"');
+    buffer_.append(val, len).push_back('"');
+}
+
+void RawDataJsonWriter::WriteDouble(double val)
+{
+    // same as the default format of std::ostream
+    char numStr[MAX_NUM_STR_LEN];
+    int len = snprintf(numStr, sizeof(numStr), "%g", val);
+    if (len > 0) {
+        buffer_.append(numStr, std::min(static_cast<size_t>(len), sizeof(numStr) - 1));
+    }
+}
+
+template<typename T>
+void RawDataJsonWriter::WriteInteger(T val, int base)
+{
+    char numStr[MAX_NUM_STR_LEN];
+    auto result = std::to_chars(numStr, numStr + sizeof(numStr), val, base);
+    buffer_.append(numStr, static_cast<size_t>(result.ptr - numStr));
+}
+
+void RawDataJsonWriter::MarkDuplicatedExtraField(const char* key, size_t len)
+{
+    for (auto& field : extraFields_) {
+        if (field.key.size() == len && field.key.compare(0, len, key, len) == 0) {
+            field.isDuplicated = true;
+        }
+    }
+}
+} // namespace EventRaw
+} // namespace HiviewDFX
+} // namespace OHOS
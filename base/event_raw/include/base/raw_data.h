@@ -37,11 +37,13 @@ public:
 
 public:
     void Reset();
+    bool Reset(size_t capacity);
     bool Append(uint8_t* data, size_t len);
     bool Update(uint8_t* data, size_t len, size_t pos);
     bool IsEmpty();
     uint8_t* GetData() const;
     size_t GetDataLength() const;
+    size_t GetCapacity() const;
 
 private:
     uint8_t* data_ = nullptr;
@@ -0,0 +1,51 @@
+/*
+ * Copyright (c) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef BASE_EVENT_RAW_INCLUDE_RAW_DATA_POOL_H
+#define BASE_EVENT_RAW_INCLUDE_RAW_DATA_POOL_H
+
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "base/raw_data.h"
+
+namespace OHOS {
+namespace HiviewDFX {
+namespace EventRaw {
+/*
+ * Keeps the buffers of released raw datas, so receiving an event reuses a buffer instead of
+ * allocating one. A raw data acquired goes back to the pool once its last reference is dropped.
+ */
+class RawDataPool {
+public:
+    static RawDataPool& GetInstance();
+    std::shared_ptr<RawData> Acquire(size_t capacity);
+    size_t GetIdleCount();
+
+private:
+    RawDataPool() = default;
+    ~RawDataPool() = default;
+    void Recycle(RawData* rawData);
+
+private:
+    std::mutex mutex_;
+    std::vector<RawData*> idleDatas_;
+};
+} // namespace EventRaw
+} // namespace HiviewDFX
+} // namespace OHOS
+
+#endif // BASE_EVENT_RAW_INCLUDE_RAW_DATA_POOL_H
@@ -18,7 +18,6 @@
 
 #include <cstddef>
 #include <cstdint>
-#include <sstream>
 #include <string>
 #include <vector>
 
@@ -48,70 +47,6 @@ private:
     void ParseCustomizedParams(const size_t maxLen);
     std::shared_ptr<DecodedParam> ParseCustomizedParam(const size_t maxLen);
 
-private:
-    template<typename T>
-    void AppendValue(std::stringstream& ss, const std::string& key, T val)
-    {
-        if constexpr (std::is_same_v<std::decay_t<T>, std::string>) {
-            ss << "\"" << key << "\":\"" << val << "\",";
-            return;
-        }
-        if constexpr (std::is_same_v<std::decay_t<T>, bool> ||
-            std::is_same_v<std::decay_t<T>, int8_t> ||
-            std::is_same_v<std::decay_t<T>, uint8_t> ||
-            std::is_same_v<std::decay_t<T>, int16_t> ||
-            std::is_same_v<std::decay_t<T>, uint16_t> ||
-            std::is_same_v<std::decay_t<T>, int32_t> ||
-            std::is_same_v<std::decay_t<T>, uint32_t> ||
-            std::is_same_v<std::decay_t<T>, int64_t> ||
-            std::is_same_v<std::decay_t<T>, uint64_t> ||
-            std::is_same_v<std::decay_t<T>, float> ||
-            std::is_same_v<std::decay_t<T>, double>) {
-            ss << "\"" << key << "\":" << val << ",";
-            return;
-        }
-        AppendArrayValue(ss, key, val);
-    }
-
-    template<typename T>
-    void AppendArrayValue(std::stringstream& ss, const std::string& key, T vals)
-    {
-        ss << "\"" << key << "\":";
-        ss << "[";
-        bool arrayIsNotEmpty = false;
-        if constexpr (std::is_same_v<std::decay_t<T>, std::vector<std::string>>) {
-            arrayIsNotEmpty = (vals.size() > 0);
-            for (auto item : vals) {
-                ss << "\"" << item << "\",";
-            }
-        }
-        if constexpr (std::is_same_v<std::decay_t<T>, std::vector<bool>> ||
-            std::is_same_v<std::decay_t<T>, std::vector<int8_t>> ||
-            std::is_same_v<std::decay_t<T>, std::vector<uint8_t>> ||
-            std::is_same_v<std::decay_t<T>, std::vector<int16_t>> ||
-            std::is_same_v<std::decay_t<T>, std::vector<uint16_t>> ||
-            std::is_same_v<std::decay_t<T>, std::vector<int32_t>> ||
-            std::is_same_v<std::decay_t<T>, std::vector<uint32_t>> ||
-            std::is_same_v<std::decay_t<T>, std::vector<int64_t>> ||
-            std::is_same_v<std::decay_t<T>, std::vector<uint64_t>> ||
-            std::is_same_v<std::decay_t<T>, std::vector<float>> ||
-            std::is_same_v<std::decay_t<T>, std::vector<double>>) {
-            arrayIsNotEmpty = (vals.size() > 0);
-            for (auto item : vals) {
-                ss << "" << item << ",";
-            }
-        }
-        if (ss.tellp() != 0 && arrayIsNotEmpty) {
-            ss.seekp(-1, std::ios_base::end);
-        }
-        ss << "],";
-    }
-
-    void AppendBaseInfo(std::stringstream& ss);
-    void AppendCustomizedArrayParam(std::stringstream& ss, std::shared_ptr<DecodedParam> param);
-    void AppendCustomizedParam(std::stringstream& ss, std::shared_ptr<DecodedParam> param);
-    void AppendCustomizedParams(std::stringstream& ss);
-
 private:
     std::shared_ptr<DecodedParam> CreateFloatingNumTypeDecodedParam(const size_t maxLen, const std::string& key,
         bool isArray);
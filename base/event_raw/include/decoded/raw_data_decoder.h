@@ -26,6 +26,8 @@ public:
     static bool FloatingNumberDecoded(uint8_t* rawData, const size_t maxLen, size_t& pos, double& dest);
     static bool SignedVarintDecoded(uint8_t* rawData, const size_t maxLen, size_t& pos, int64_t& dest);
     static bool StringValueDecoded(uint8_t* rawData, const size_t maxLen, size_t& pos, std::string& dest);
+    static bool StringValueRefDecoded(uint8_t* rawData, const size_t maxLen, size_t& pos, const char*& dest,
+        size_t& destLen);
     static bool UnsignedVarintDecoded(uint8_t* rawData, const size_t maxLen, size_t& pos, uint64_t& dest);
     static bool ValueTypeDecoded(uint8_t* rawData, const size_t maxLen, size_t& pos, struct ParamValueType& dest);
 
@@ -0,0 +1,108 @@
+/*
+ * Copyright (c) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef BASE_EVENT_RAW_DECODE_INCLUDE_RAW_DATA_INDEX_H
+#define BASE_EVENT_RAW_DECODE_INCLUDE_RAW_DATA_INDEX_H
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "base/raw_data.h"
+#include "base/raw_data_base_def.h"
+#include "base/value_param.h"
+
+namespace OHOS {
+namespace HiviewDFX {
+namespace EventRaw {
+/*
+ * Read only index of the customized params of an encoded event, which maps each key to the
+ * coded type and the offset of its value. Values are decoded from the raw bytes on demand and
+ * follow the same typing rules as RawDataBuilder::ParseValueByKey.
+ */
+class RawDataIndex {
+public:
+    explicit RawDataIndex(std::shared_ptr<RawData> rawData);
+    ~RawDataIndex() = default;
+
+public:
+    template<typename T>
+    bool ParseValueByKey(const std::string& key, T& dest) const
+    {
+        if (!isValid_) {
+            return false;
+        }
+        if (IsBaseInfo(key)) {
+            return ParseBaseInfoValue(key, dest);
+        }
+        auto iter = params_.find(key);
+        if (iter == params_.end()) {
+            return false;
+        }
+        return ParseParamValue(iter->second, dest);
+    }
+
+    bool IsValid() const;
+    std::shared_ptr<RawData> GetRawData() const;
+    size_t GetParamCnt() const;
+
+private:
+    struct ParamEntry {
+        DataCodedType codedType;
+        size_t pos;
+    };
+
+private:
+    void Init();
+    bool SkipValue(const struct ParamValueType& valueType, size_t& pos) const;
+    struct HiSysEventHeader GetHeader() const;
+    struct TraceInfo GetTraceInfo() const;
+    static bool IsBaseInfo(const std::string& key);
+
+    bool ParseBaseInfoValue(const std::string& key, uint64_t& dest) const;
+    bool ParseBaseInfoValue(const std::string& key, int64_t& dest) const;
+    bool ParseBaseInfoValue(const std::string& key, std::string& dest) const;
+    template<typename T>
+    bool ParseBaseInfoValue(const std::string& key, T& dest) const
+    {
+        return false;
+    }
+
+    bool ParseParamValue(const ParamEntry& entry, uint64_t& dest) const;
+    bool ParseParamValue(const ParamEntry& entry, int64_t& dest) const;
+    bool ParseParamValue(const ParamEntry& entry, double& dest) const;
+    bool ParseParamValue(const ParamEntry& entry, std::string& dest) const;
+    bool ParseParamValue(const ParamEntry& entry, std::vector<uint64_t>& dest) const;
+    bool ParseParamValue(const ParamEntry& entry, std::vector<int64_t>& dest) const;
+    bool ParseParamValue(const ParamEntry& entry, std::vector<double>& dest) const;
+    bool ParseParamValue(const ParamEntry& entry, std::vector<std::string>& dest) const;
+
+private:
+    std::shared_ptr<RawData> rawData_;
+    size_t maxLen_ = 0;
+    bool isValid_ = false;
+    // keys refer to the bytes of rawData_ which is kept alive by this index, the header is read
+    // from the bytes every time since its fields may be updated in place
+    std::unordered_map<std::string_view, ParamEntry> params_;
+};
+} // namespace EventRaw
+} // namespace HiviewDFX
+} // namespace OHOS
+
+#endif // BASE_EVENT_RAW_DECODE_INCLUDE_RAW_DATA_INDEX_H
@@ -0,0 +1,74 @@
+/*
+ * Copyright (c) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef BASE_EVENT_RAW_DECODE_INCLUDE_RAW_DATA_JSON_WRITER_H
+#define BASE_EVENT_RAW_DECODE_INCLUDE_RAW_DATA_JSON_WRITER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "base/raw_data_base_def.h"
+
+namespace OHOS {
+namespace HiviewDFX {
+namespace EventRaw {
+/*
+ * Writes the json string of an encoded event in a single pass over the raw bytes,
+ * string values are stored escaped already and are copied as they are.
+ */
+class RawDataJsonWriter {
+public:
+    explicit RawDataJsonWriter(std::string& buffer) : buffer_(buffer) {}
+    ~RawDataJsonWriter() = default;
+
+public:
+    // extra fields are written after the customized params unless a param with the same key exists
+    void AddExtraField(const std::string& key, const std::string& value);
+    void AddExtraField(const std::string& key, int64_t value);
+    bool Write(uint8_t* rawData);
+    void WriteHeader(const struct HiSysEventHeader& header, const struct TraceInfo& traceInfo);
+    bool WriteCustomizedParams(uint8_t* rawData, const size_t maxLen, size_t pos);
+    void Finish();
+
+private:
+    struct ExtraField {
+        std::string key;
+        std::string value;
+        bool isDuplicated = false;
+    };
+
+private:
+    bool WriteCustomizedParam(uint8_t* rawData, const size_t maxLen, size_t& pos);
+    bool WriteValue(uint8_t* rawData, const size_t maxLen, size_t& pos, uint8_t valueType);
+    bool WriteArrayValue(uint8_t* rawData, const size_t maxLen, size_t& pos, uint8_t valueType);
+    void WriteKey(const char* key, size_t len);
+    void WriteString(const char* val, size_t len);
+    void WriteDouble(double val);
+    template<typename T>
+    void WriteInteger(T val, int base = 10); // 10: decimal
+    void MarkDuplicatedExtraField(const char* key, size_t len);
+
+private:
+    std::string& buffer_;
+    std::vector<ExtraField> extraFields_;
+    bool isFirstField_ = true;
+};
+} // namespace EventRaw
+} // namespace HiviewDFX
+} // namespace OHOS
+
+#endif // BASE_EVENT_RAW_DECODE_INCLUDE_RAW_DATA_JSON_WRITER_H
@@ -17,6 +17,7 @@
 
 #include "base/raw_data_base_def.h"
 #include "base/raw_data.h"
+#include "base/raw_data_pool.h"
 #include "base/value_param.h"
 
 namespace OHOS {
@@ -148,5 +149,38 @@ HWTEST_F(EventRawBaseTest, RawDataTest002, testing::ext::TestSize.Level1)
     ASSERT_EQ(data3.GetDataLength(), CAP);
     delete[] tmpData;
 }
+
+/**
+ * @tc.name: RawDataPoolTest001
+ * @tc.desc: Test raw data released is reused by RawDataPool
+ * @tc.type: FUNC
+ * @tc.require: issueI7X274
+ */
+HWTEST_F(EventRawBaseTest, RawDataPoolTest001, testing::ext::TestSize.Level1)
+{
+    auto& pool = RawDataPool::GetInstance();
+    uint8_t tmpData[CAP] = { 0 };
+    auto data1 = pool.Acquire(CAP);
+    ASSERT_TRUE(data1 != nullptr);
+    ASSERT_TRUE(data1->IsEmpty());
+    ASSERT_TRUE(data1->Append(tmpData, CAP));
+    RawData* recycledData = data1.get();
+    size_t idleCnt = pool.GetIdleCount();
+    data1.reset();
+    ASSERT_EQ(pool.GetIdleCount(), idleCnt + 1);
+
+    // buffer big enough is reused and cleared
+    auto data2 = pool.Acquire(CAP / 2); // 2 means half of the capacity
+    ASSERT_EQ(data2.get(), recycledData);
+    ASSERT_TRUE(data2->IsEmpty());
+    ASSERT_EQ(pool.GetIdleCount(), idleCnt);
+    data2.reset();
+
+    // buffer too small is reallocated
+    auto data3 = pool.Acquire(CAP * 2); // 2 means twice the capacity
+    ASSERT_TRUE(data3 != nullptr);
+    ASSERT_GE(data3->GetCapacity(), CAP * 2); // 2 means twice the capacity
+    ASSERT_TRUE(data3->IsEmpty());
+}
 } // namespace HiviewDFX
 } // namespace OHOS
\ No newline at end of file
@@ -15,12 +15,19 @@
 
 #include "event_raw_encoded_and_decoded_test.h"
 
+#include <chrono>
+#include <cinttypes>
+#include <cstring>
 #include <memory>
+#include <sstream>
+#include <utility>
 #include <vector>
 
 #include "decoded/decoded_event.h"
 #include "decoded/decoded_param.h"
 #include "decoded/raw_data_decoder.h"
+#include "decoded/raw_data_index.h"
+#include "decoded/raw_data_json_writer.h"
 #include "encoded/encoded_param.h"
 #include "encoded/raw_data_builder_json_parser.h"
 #include "encoded/raw_data_builder.h"
@@ -33,6 +40,102 @@ namespace {
 const std::string TEST_KEY = "KEY";
 constexpr size_t MAX_LEN = 1000;
 constexpr uint8_t CNT = 3;
+
+template<typename T>
+void AppendLegacyArray(std::stringstream& ss, const std::vector<T>& vals, bool isString)
+{
+    ss << "[";
+    for (size_t i = 0; i < vals.size(); ++i) {
+        ss << (i == 0 ? "" : ",") << (isString ? "\"" : "") << vals[i] << (isString ? "\"" : "");
+    }
+    ss << "]";
+}
+
+void AppendLegacyParam(std::stringstream& ss, std::shared_ptr<DecodedParam> param)
+{
+    ss << ",\"" << param->GetKey() << "\":";
+    uint64_t u64 = 0;
+    int64_t i64 = 0;
+    double d = 0.0;
+    std::string str;
+    std::vector<uint64_t> u64Vec;
+    std::vector<int64_t> i64Vec;
+    std::vector<double> dVec;
+    std::vector<std::string> strVec;
+    if (param->AsUint64(u64)) {
+        ss << u64;
+    } else if (param->AsInt64(i64)) {
+        ss << i64;
+    } else if (param->AsDouble(d)) {
+        ss << d;
+    } else if (param->AsString(str)) {
+        ss << "\"" << str << "\"";
+    } else if (param->AsUint64Vec(u64Vec)) {
+        AppendLegacyArray(ss, u64Vec, false);
+    } else if (param->AsInt64Vec(i64Vec)) {
+        AppendLegacyArray(ss, i64Vec, false);
+    } else if (param->AsDoubleVec(dVec)) {
+        AppendLegacyArray(ss, dVec, false);
+    } else if (param->AsStringVec(strVec)) {
+        AppendLegacyArray(ss, strVec, true);
+    }
+}
+
+// json conversion through std::stringstream which DecodedEvent used before RawDataJsonWriter
+std::string LegacyAsJsonStr(DecodedEvent& event)
+{
+    const auto& header = event.GetHeader();
+    std::stringstream ss;
+    ss << "{\"domain_\":\"" << std::string(header.domain, strnlen(header.domain, MAX_DOMAIN_LENGTH)) << "\"";
+    ss << ",\"name_\":\"" << std::string(header.name, strnlen(header.name, MAX_EVENT_NAME_LENGTH)) << "\"";
+    ss << ",\"type_\":" << (static_cast<int>(header.type) + 1) << ",\"time_\":" << header.timestamp;
+    ss << ",\"tz_\":\"" << ParseTimeZone(header.timeZone) << "\",\"pid_\":" << header.pid;
+    ss << ",\"tid_\":" << header.tid << ",\"uid_\":" << header.uid;
+    ss << ",\"log_\":" << static_cast<uint32_t>(header.log);
+    std::string id = std::to_string(header.id);
+    const size_t idLen = 20;
+    ss << ",\"id_\":\"" << std::string(idLen > id.size() ? idLen - id.size() : 0, '0') << id << "\"";
+    if (header.isTraceOpened == 1) {
+        const auto& traceInfo = event.GetTraceInfo();
+        ss << ",\"trace_flag_\":" << static_cast<int>(traceInfo.traceFlag);
+        ss << ",\"traceid_\":\"" << TransNumToHexStr(traceInfo.traceId) << "\"";
+        ss << ",\"spanid_\":\"" << TransNumToHexStr(traceInfo.spanId) << "\"";
+        ss << ",\"pspanid_\":\"" << TransNumToHexStr(traceInfo.pSpanId) << "\"";
+    }
+    for (const auto& param : event.GetAllCustomizedValues()) {
+        AppendLegacyParam(ss, param);
+    }
+    ss << "}";
+    return ss.str();
+}
+
+std::shared_ptr<RawData> BuildRawData(const std::string& jsonStr)
+{
+    auto builder = std::make_shared<RawDataBuilderJsonParser>(jsonStr)->Parse();
+    return builder == nullptr ? nullptr : builder->Build();
+}
+
+template<typename T>
+void ExpectSameParsedValue(RawDataBuilder& builder, const RawDataIndex& index, const std::string& key)
+{
+    T builderVal {};
+    T indexVal {};
+    bool builderRet = builder.ParseValueByKey(key, builderVal);
+    ASSERT_EQ(index.ParseValueByKey(key, indexVal), builderRet) << "key: " << key;
+    ASSERT_TRUE(builderVal == indexVal) << "key: " << key;
+}
+
+void ExpectSameParsedValues(RawDataBuilder& builder, const RawDataIndex& index, const std::string& key)
+{
+    ExpectSameParsedValue<uint64_t>(builder, index, key);
+    ExpectSameParsedValue<int64_t>(builder, index, key);
+    ExpectSameParsedValue<double>(builder, index, key);
+    ExpectSameParsedValue<std::string>(builder, index, key);
+    ExpectSameParsedValue<std::vector<uint64_t>>(builder, index, key);
+    ExpectSameParsedValue<std::vector<int64_t>>(builder, index, key);
+    ExpectSameParsedValue<std::vector<double>>(builder, index, key);
+    ExpectSameParsedValue<std::vector<std::string>>(builder, index, key);
+}
 }
 
 void EventRawEncodedTest::SetUpTestCase()
@@ -911,5 +1014,268 @@ HWTEST_F(EventRawEncodedTest, RawDataBuilderTest002, testing::ext::TestSize.Leve
     ASSERT_TRUE(builder->IsBaseInfo("domain_")); // test value
     ASSERT_TRUE(!builder->IsBaseInfo("TEST_KEY")); // test value
 }
+
+/**
+ * @tc.name: RawDataJsonWriterTest001
+ * @tc.desc: Test RawDataJsonWriter writes extra fields and keeps the params with the same key
+ * @tc.type: FUNC
+ * @tc.require: issueI7X274
+ */
+HWTEST_F(EventRawEncodedTest, RawDataJsonWriterTest001, testing::ext::TestSize.Level1)
+{
+    std::string rawSysEventStr = R"~({"domain_":"DEMO","name_":"EVENT_NAME_A","type_":1,"time_":1501837000000,)~";
+    rawSysEventStr.append(R"~("tz_":"+0800","pid_":1,"tid_":2,"uid_":3,"log_":1,"id_":"1234567",)~");
+    rawSysEventStr.append(R"~("trace_flag_":3,"traceid_":"a92ab1ea12c7144","spanid_":"0","pspanid_":"b1",)~");
+    rawSysEventStr.append(R"~("seq_":100,"MSG":"input blocked","PARAM_D":[1.5,-2.25]})~");
+    auto rawData = BuildRawData(rawSysEventStr);
+    ASSERT_TRUE(rawData != nullptr);
+    std::string jsonStr;
+    RawDataJsonWriter writer(jsonStr);
+    writer.AddExtraField("tag_", "PERFORMANCE");
+    writer.AddExtraField("seq_", 10); // 10: test value
+    ASSERT_TRUE(writer.Write(rawData->GetData()));
+    std::string expectedStr = R"~({"domain_":"DEMO","name_":"EVENT_NAME_A","type_":1,"time_":1501837000000,)~";
+    expectedStr.append(R"~("tz_":"+0800","pid_":1,"tid_":2,"uid_":3,"log_":1,"id_":"00000000000001234567",)~");
+    expectedStr.append(R"~("trace_flag_":3,"traceid_":"a92ab1ea12c7144","spanid_":"0","pspanid_":"b1",)~");
+    expectedStr.append(R"~("seq_":100,"MSG":"input blocked","PARAM_D":[1.5,-2.25],"tag_":"PERFORMANCE"})~");
+    ASSERT_EQ(jsonStr, expectedStr);
+
+    DecodedEvent event(rawData->GetData());
+    ASSERT_TRUE(event.IsValid());
+    ASSERT_EQ(event.AsJsonStr(), LegacyAsJsonStr(event));
+
+    std::string invalidStr;
+    RawDataJsonWriter invalidWriter(invalidStr);
+    ASSERT_FALSE(invalidWriter.Write(nullptr));
+    ASSERT_TRUE(invalidStr.empty());
+}
+
+/**
+ * @tc.name: RawDataJsonWriterTest002
+ * @tc.desc: Test the json strings of encoded events are the same as the expected ones byte by byte
+ * @tc.type: FUNC
+ * @tc.require: issueI7X274
+ */
+HWTEST_F(EventRawEncodedTest, RawDataJsonWriterTest002, testing::ext::TestSize.Level1)
+{
+    // <json string to encode, json string of the encoded event>, string values are written as escaped in the
+    // source, and a duplicated key keeps its first place with the last value
+    const std::vector<std::pair<std::string, std::string>> jsonStrs = {
+        {
+            R"~({"domain_":"DEMO","name_":"EVENT_A","type_":1,"time_":1501837000000,"tz_":"+0800","pid_":1,"tid_":2,)~"
+            R"~("uid_":3,"log_":0,"id_":"1","MSG":"hello","CNT":7})~",
+            R"~({"domain_":"DEMO","name_":"EVENT_A","type_":1,"time_":1501837000000,"tz_":"+0800","pid_":1,"tid_":2,)~"
+            R"~("uid_":3,"log_":0,"id_":"00000000000000000001","MSG":"hello","CNT":7})~"
+        },
+        {
+            R"~({"domain_":"DEMO","name_":"EVENT_B","type_":4,"time_":1501837000123,"tz_":"-0330","pid_":100,)~"
+            R"~("tid_":101,"uid_":20010001,"log_":1,"id_":"14645518577780955344","trace_flag_":3,)~"
+            R"~("traceid_":"a92ab1ea12c7144","spanid_":"0","pspanid_":"b1","MSG":"traced"})~",
+            R"~({"domain_":"DEMO","name_":"EVENT_B","type_":4,"time_":1501837000123,"tz_":"-0330","pid_":100,)~"
+            R"~("tid_":101,"uid_":20010001,"log_":1,"id_":"14645518577780955344","trace_flag_":3,)~"
+            R"~("traceid_":"a92ab1ea12c7144","spanid_":"0","pspanid_":"b1","MSG":"traced"})~"
+        },
+        {
+            R"~({"domain_":"DEMO","name_":"EVENT_C","type_":2,"time_":1501837000000,"tz_":"+0000","pid_":1,"tid_":1,)~"
+            R"~("uid_":0,"log_":0,"id_":"2","U":[1,2,3],"I":[-1,2,-3],"D":[0.5,-1.25,100.0],"S":["a","b c",""],)~"
+            R"~("E":[]})~",
+            R"~({"domain_":"DEMO","name_":"EVENT_C","type_":2,"time_":1501837000000,"tz_":"+0000","pid_":1,"tid_":1,)~"
+            R"~("uid_":0,"log_":0,"id_":"00000000000000000002","U":[1,2,3],"I":[-1,2,-3],"D":[0.5,-1.25,100],)~"
+            R"~("S":["a","b c",""],"E":[]})~"
+        },
+        {
+            R"~({"domain_":"DEMO","name_":"EVENT_D","type_":3,"time_":1501837000000,"tz_":"+0800","pid_":1,"tid_":1,)~"
+            R"~("uid_":0,"log_":0,"id_":"3","Q":"say \"hi\"","B":"back\\slash","N":"line1\nline2\ttab",)~"
+            R"~("C":"ctl\u0001\u001f","SL":"a/b","ARR":["x\"y","p\\q"]})~",
+            R"~({"domain_":"DEMO","name_":"EVENT_D","type_":3,"time_":1501837000000,"tz_":"+0800","pid_":1,"tid_":1,)~"
+            R"~("uid_":0,"log_":0,"id_":"00000000000000000003","Q":"say \"hi\"","B":"back\\slash",)~"
+            R"~("N":"line1\nline2\ttab","C":"ctl\u0001\u001f","SL":"a/b","ARR":["x\"y","p\\q"]})~"
+        },
+        {
+            R"~({"domain_":"DEMO","name_":"EVENT_E","type_":1,"time_":1501837000000,"tz_":"+0800","pid_":1,"tid_":1,)~"
+            R"~("uid_":0,"log_":0,"id_":"4","UMAX":18446744073709551615,"IMIN":-9223372036854775808,"ZERO":0,)~"
+            R"~("NEG":-42,"D1":0.1,"D2":-0.0,"D3":123456789.125,"D4":3.0,"D5":0.000001})~",
+            R"~({"domain_":"DEMO","name_":"EVENT_E","type_":1,"time_":1501837000000,"tz_":"+0800","pid_":1,"tid_":1,)~"
+            R"~("uid_":0,"log_":0,"id_":"00000000000000000004","UMAX":18446744073709551615,)~"
+            R"~("IMIN":-9223372036854775808,"ZERO":0,"NEG":-42,"D1":0.1,"D2":-0,"D3":1.23457e+08,"D4":3,"D5":1e-06})~"
+        },
+        {
+            R"~({"domain_":"DEMO","name_":"EVENT_F","type_":1,"time_":1501837000000,"tz_":"+0800","pid_":1,"tid_":1,)~"
+            R"~("uid_":0,"log_":0,"id_":"5","DUP":1,"DUP":"dup","OTHER":2,"DUP":[1,2]})~",
+            R"~({"domain_":"DEMO","name_":"EVENT_F","type_":1,"time_":1501837000000,"tz_":"+0800","pid_":1,"tid_":1,)~"
+            R"~("uid_":0,"log_":0,"id_":"00000000000000000005","DUP":[1,2],"OTHER":2})~"
+        },
+        {
+            R"~({"domain_":"DEMO","name_":"EVENT_G","type_":1,"time_":1501837000000,"tz_":"+0800","pid_":1,"tid_":1,)~"
+            R"~("uid_":0,"log_":0,"id_":"6","EMPTY":"","SPACE":" ","ZERO_ARR":[0]})~",
+            R"~({"domain_":"DEMO","name_":"EVENT_G","type_":1,"time_":1501837000000,"tz_":"+0800","pid_":1,"tid_":1,)~"
+            R"~("uid_":0,"log_":0,"id_":"00000000000000000006","EMPTY":"","SPACE":" ","ZERO_ARR":[0]})~"
+        },
+        {
+            R"~({"domain_":"DEMO","name_":"EVENT_H","type_":2,"time_":1501837000000,"tz_":"+0800","pid_":1,"tid_":1,)~"
+            R"~("uid_":0,"log_":0,"id_":"7"})~",
+            R"~({"domain_":"DEMO","name_":"EVENT_H","type_":2,"time_":1501837000000,"tz_":"+0800","pid_":1,"tid_":1,)~"
+            R"~("uid_":0,"log_":0,"id_":"00000000000000000007"})~"
+        },
+        {
+            R"~({"domain_":"DEMO","name_":"EVENT_I","type_":1,"time_":1501837000000,"tz_":"+0800","pid_":1,"tid_":1,)~"
+            R"~("uid_":0,"log_":0,"id_":"8","seq_":100,"tag_":"OLD","level_":"MINOR"})~",
+            R"~({"domain_":"DEMO","name_":"EVENT_I","type_":1,"time_":1501837000000,"tz_":"+0800","pid_":1,"tid_":1,)~"
+            R"~("uid_":0,"log_":0,"id_":"00000000000000000008","seq_":100,"tag_":"OLD","level_":"MINOR"})~"
+        },
+        {
+            R"~({"domain_":"DEMO","name_":"EVENT_J","type_":1,"time_":1501837000000,"tz_":"+0800","pid_":1,"tid_":1,)~"
+            R"~("uid_":0,"log_":0,"id_":"9","seq_":100,"MSG":"partial"})~",
+            R"~({"domain_":"DEMO","name_":"EVENT_J","type_":1,"time_":1501837000000,"tz_":"+0800","pid_":1,"tid_":1,)~"
+            R"~("uid_":0,"log_":0,"id_":"00000000000000000009","seq_":100,"MSG":"partial"})~"
+        },
+    };
+    for (const auto& jsonStr : jsonStrs) {
+        auto rawData = BuildRawData(jsonStr.first);
+        ASSERT_TRUE(rawData != nullptr) << jsonStr.first;
+        DecodedEvent event(rawData->GetData());
+        ASSERT_TRUE(event.IsValid()) << jsonStr.first;
+        ASSERT_EQ(event.AsJsonStr(), jsonStr.second);
+    }
+}
+
+/**
+ * @tc.name: RawDataJsonWriterTest003
+ * @tc.desc: Test the json strings written with extra fields are the same as the expected ones byte by byte
+ * @tc.type: FUNC
+ * @tc.require: issueI7X274
+ */
+HWTEST_F(EventRawEncodedTest, RawDataJsonWriterTest003, testing::ext::TestSize.Level1)
+{
+    // <json string to encode, json string written with extra fields>, the extra fields with the same key as a
+    // param of the event are not written
+    const std::vector<std::pair<std::string, std::string>> jsonStrs = {
+        {
+            R"~({"domain_":"DEMO","name_":"EVENT_A","type_":1,"time_":1501837000000,"tz_":"+0800","pid_":1,"tid_":2,)~"
+            R"~("uid_":3,"log_":0,"id_":"1","MSG":"hello","CNT":7})~",
+            R"~({"domain_":"DEMO","name_":"EVENT_A","type_":1,"time_":1501837000000,"tz_":"+0800","pid_":1,"tid_":2,)~"
+            R"~("uid_":3,"log_":0,"id_":"00000000000000000001","MSG":"hello","CNT":7,"tag_":"PERFORMANCE","seq_":10,)~"
+            R"~("level_":"CRITICAL"})~"
+        },
+        {
+            R"~({"domain_":"DEMO","name_":"EVENT_F","type_":1,"time_":1501837000000,"tz_":"+0800","pid_":1,"tid_":1,)~"
+            R"~("uid_":0,"log_":0,"id_":"5","DUP":1,"DUP":"dup","OTHER":2,"DUP":[1,2]})~",
+            R"~({"domain_":"DEMO","name_":"EVENT_F","type_":1,"time_":1501837000000,"tz_":"+0800","pid_":1,"tid_":1,)~"
+            R"~("uid_":0,"log_":0,"id_":"00000000000000000005","DUP":[1,2],"OTHER":2,"tag_":"PERFORMANCE","seq_":10,)~"
+            R"~("level_":"CRITICAL"})~"
+        },
+        {
+            R"~({"domain_":"DEMO","name_":"EVENT_I","type_":1,"time_":1501837000000,"tz_":"+0800","pid_":1,"tid_":1,)~"
+            R"~("uid_":0,"log_":0,"id_":"8","seq_":100,"tag_":"OLD","level_":"MINOR"})~",
+            R"~({"domain_":"DEMO","name_":"EVENT_I","type_":1,"time_":1501837000000,"tz_":"+0800","pid_":1,"tid_":1,)~"
+            R"~("uid_":0,"log_":0,"id_":"00000000000000000008","seq_":100,"tag_":"OLD","level_":"MINOR"})~"
+        },
+        {
+            R"~({"domain_":"DEMO","name_":"EVENT_J","type_":1,"time_":1501837000000,"tz_":"+0800","pid_":1,"tid_":1,)~"
+            R"~("uid_":0,"log_":0,"id_":"9","seq_":100,"MSG":"partial"})~",
+            R"~({"domain_":"DEMO","name_":"EVENT_J","type_":1,"time_":1501837000000,"tz_":"+0800","pid_":1,"tid_":1,)~"
+            R"~("uid_":0,"log_":0,"id_":"00000000000000000009","seq_":100,"MSG":"partial","tag_":"PERFORMANCE",)~"
+            R"~("level_":"CRITICAL"})~"
+        },
+    };
+    for (const auto& jsonStr : jsonStrs) {
+        auto rawData = BuildRawData(jsonStr.first);
+        ASSERT_TRUE(rawData != nullptr) << jsonStr.first;
+        std::string writtenStr;
+        RawDataJsonWriter writer(writtenStr);
+        writer.AddExtraField("tag_", "PERFORMANCE");
+        writer.AddExtraField("seq_", 10); // 10: test value
+        writer.AddExtraField("level_", "CRITICAL");
+        ASSERT_TRUE(writer.Write(rawData->GetData()));
+        ASSERT_EQ(writtenStr, jsonStr.second);
+    }
+}
+
+/**
+ * @tc.name: RawDataIndexTest001
+ * @tc.desc: Parse values by RawDataIndex and RawDataBuilder from the same raw data
+ * @tc.type: FUNC
+ * @tc.require: issueI7X274
+ */
+HWTEST_F(EventRawEncodedTest, RawDataIndexTest001, testing::ext::TestSize.Level1)
+{
+    std::string rawSysEventStr = R"~({"domain_":"HIVIEWDFX","name_":"CPU_USAGE","type_":2,"time_":1501837000000,)~"
+        R"~("tz_":"+0800","pid_":100,"tid_":101,"uid_":1201,"log_":0,"id_":"1234567","trace_flag_":3,)~"
+        R"~("traceid_":"a92ab1ea12c7144","spanid_":"0","pspanid_":"b1","LOAD":[0.5,1.25,2.75],)~"
+        R"~("PIDS":[1,2,3],"NEGS":[-1,2,-3],"NAMES":["init","hiview"],"TOTAL":123456789012,)~"
+        R"~("DELTA":-42,"RATIO":0.125,"MSG":"cpu usage","EMPTY":[],"DUP":1,"DUP":"dup"})~";
+    auto rawData = BuildRawData(rawSysEventStr);
+    ASSERT_TRUE(rawData != nullptr);
+    RawDataBuilder builder(rawData);
+    RawDataIndex index(rawData);
+    ASSERT_TRUE(index.IsValid());
+    ASSERT_EQ(index.GetRawData(), rawData);
+    ASSERT_EQ(index.GetParamCnt(), builder.GetParamCnt());
+    std::vector<std::string> keys = {
+        "domain_", "name_", "type_", "time_", "tz_", "pid_", "tid_", "uid_", "log_", "id_", "trace_flag_",
+        "traceid_", "spanid_", "pspanid_", "LOAD", "PIDS", "NEGS", "NAMES", "TOTAL", "DELTA", "RATIO", "MSG",
+        "EMPTY", "DUP", "NOT_EXIST",
+    };
+    for (const auto& key : keys) {
+        ExpectSameParsedValues(builder, index, key);
+    }
+    std::string dupVal;
+    ASSERT_TRUE(index.ParseValueByKey("DUP", dupVal));
+    ASSERT_EQ(dupVal, "dup");
+
+    RawDataIndex invalidIndex(nullptr);
+    ASSERT_FALSE(invalidIndex.IsValid());
+    uint64_t pid = 0;
+    ASSERT_FALSE(invalidIndex.ParseValueByKey("pid_", pid));
+}
+
+/**
+ * @tc.name: RawDataIndexBenchmarkTest001
+ * @tc.desc: Compare the cost of reading fields by RawDataIndex with the RawDataBuilder based way
+ * @tc.type: FUNC
+ * @tc.require: issueI7X274
+ */
+HWTEST_F(EventRawEncodedTest, RawDataIndexBenchmarkTest001, testing::ext::TestSize.Level3)
+{
+    std::string rawSysEventStr = R"~({"domain_":"AAFWK","name_":"APP_INPUT_BLOCK","type_":1,"time_":1501837000000,)~"
+        R"~("tz_":"+0800","pid_":1024,"tid_":1025,"uid_":20010001,"log_":0,"id_":"14645518577780955344",)~"
+        R"~("UID":20010001,"PID":1024,"PACKAGE_NAME":"com.example.demo","PROCESS_NAME":"com.example.demo",)~"
+        R"~("MSG":"User input does not respond!","FOREGROUND":1,"HITRACE_TIME":"2024-01-01 10:00:00"})~";
+    auto rawData = BuildRawData(rawSysEventStr);
+    ASSERT_TRUE(rawData != nullptr);
+    const uint64_t loopCnt = 10000;
+    uint64_t builderSum = 0;
+    auto begin = std::chrono::steady_clock::now();
+    for (uint64_t i = 0; i < loopCnt; ++i) {
+        RawDataBuilder builder(rawData);
+        uint64_t val = 0;
+        builder.ParseValueByKey("time_", val);
+        builderSum += val;
+        builder.ParseValueByKey("PID", val);
+        builderSum += val;
+        std::string name;
+        builder.ParseValueByKey("PACKAGE_NAME", name);
+        builderSum += name.size();
+    }
+    auto builderCost = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - begin);
+    uint64_t indexSum = 0;
+    begin = std::chrono::steady_clock::now();
+    for (uint64_t i = 0; i < loopCnt; ++i) {
+        RawDataIndex index(rawData);
+        uint64_t val = 0;
+        index.ParseValueByKey("time_", val);
+        indexSum += val;
+        index.ParseValueByKey("PID", val);
+        indexSum += val;
+        std::string name;
+        index.ParseValueByKey("PACKAGE_NAME", name);
+        indexSum += name.size();
+    }
+    auto indexCost = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - begin);
+    printf("BuilderCostPerEvent:%" PRIu64 "ns, IndexCostPerEvent:%" PRIu64 "ns.\n",
+        static_cast<uint64_t>(builderCost.count()) / loopCnt, static_cast<uint64_t>(indexCost.count()) / loopCnt);
+    ASSERT_EQ(builderSum, indexSum);
+}
+
 } // namespace HiviewDFX
 } // namespace OHOS
\ No newline at end of file
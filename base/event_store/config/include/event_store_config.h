@@ -33,6 +33,10 @@ public:
     uint32_t GetMaxFileNum(int eventType);
     uint32_t GetPageSize(int eventType);
     uint32_t GetMaxFileSize(int eventType);
+    bool IsGroupCommitEnabled();
+    uint32_t GetGroupCommitMaxSize();
+    uint32_t GetGroupCommitMaxLatency();
+    uint32_t GetParallelQueryWorkerNum();
 
 private:
     struct StoreConfig {
@@ -42,10 +46,21 @@ private:
         uint32_t maxFileNum;
         uint32_t maxSize;
     };
+    struct GroupCommitConfig {
+        bool enable = false;
+        uint32_t maxSize = 0; // in KB
+        uint32_t maxLatency = 0; // in ms
+    };
+    struct ParallelQueryConfig {
+        bool enable = false;
+        uint32_t maxWorkerNum = 0;
+    };
     void Init();
     bool Contain(int eventType);
 
     std::unordered_map<int, StoreConfig> configMap_;
+    GroupCommitConfig groupCommitConfig_;
+    ParallelQueryConfig parallelQueryConfig_;
 };
 } // EventStore
 } // HiviewDFX
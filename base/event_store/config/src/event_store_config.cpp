@@ -28,6 +28,11 @@ const char KEY_PAGE_SIZE[] = "PageSize";
 const char KEY_MAX_SIZE[] = "MaxSize";
 const char KEY_MAX_FILE_NUM[] = "MaxFileNum";
 const char KEY_MAX_FILE_SIZE[] = "MaxFileSize";
+const char KEY_GROUP_COMMIT[] = "GroupCommit";
+const char KEY_ENABLE[] = "Enable";
+const char KEY_MAX_LATENCY[] = "MaxLatency";
+const char KEY_PARALLEL_QUERY[] = "ParallelQuery";
+const char KEY_MAX_WORKER_NUM[] = "MaxWorkerNum";
 const std::map<std::string, int> EVENT_TYPE_MAP = {
     {"FAULT", 1}, {"STATISTIC", 2}, {"SECURITY", 3}, {"BEHAVIOR", 4}
 };
@@ -36,6 +41,11 @@ uint32_t ParseUint32(const Json::Value& root, const std::string& key)
 {
     return (root.isMember(key) && root[key].isUInt()) ? root[key].asUInt() : 0;
 }
+
+bool ParseBool(const Json::Value& root, const std::string& key)
+{
+    return (root.isMember(key) && root[key].isBool()) ? root[key].asBool() : false;
+}
 }
 EventStoreConfig::EventStoreConfig()
 {
@@ -56,6 +66,19 @@ void EventStoreConfig::Init()
         return;
     }
 
+    if (root.isMember(KEY_GROUP_COMMIT) && root[KEY_GROUP_COMMIT].type() == Json::objectValue) {
+        auto node = root[KEY_GROUP_COMMIT];
+        groupCommitConfig_.enable = ParseBool(node, KEY_ENABLE);
+        groupCommitConfig_.maxSize = ParseUint32(node, KEY_MAX_SIZE);
+        groupCommitConfig_.maxLatency = ParseUint32(node, KEY_MAX_LATENCY);
+    }
+
+    if (root.isMember(KEY_PARALLEL_QUERY) && root[KEY_PARALLEL_QUERY].type() == Json::objectValue) {
+        auto node = root[KEY_PARALLEL_QUERY];
+        parallelQueryConfig_.enable = ParseBool(node, KEY_ENABLE);
+        parallelQueryConfig_.maxWorkerNum = ParseUint32(node, KEY_MAX_WORKER_NUM);
+    }
+
     std::vector<std::string> members = root.getMemberNames();
     for (auto iter = members.begin(); iter != members.end(); ++iter) {
         if (EVENT_TYPE_MAP.find(*iter) == EVENT_TYPE_MAP.end()) {
@@ -103,6 +126,26 @@ uint32_t EventStoreConfig::GetMaxFileSize(int eventType)
 {
     return Contain(eventType) ? configMap_[eventType].maxFileSize : 0;
 }
+
+bool EventStoreConfig::IsGroupCommitEnabled()
+{
+    return groupCommitConfig_.enable && groupCommitConfig_.maxSize > 0 && groupCommitConfig_.maxLatency > 0;
+}
+
+uint32_t EventStoreConfig::GetGroupCommitMaxSize()
+{
+    return groupCommitConfig_.maxSize;
+}
+
+uint32_t EventStoreConfig::GetGroupCommitMaxLatency()
+{
+    return groupCommitConfig_.maxLatency;
+}
+
+uint32_t EventStoreConfig::GetParallelQueryWorkerNum()
+{
+    return parallelQueryConfig_.enable ? parallelQueryConfig_.maxWorkerNum : 0;
+}
 } // EventStore
 } // HiviewDFX
 } // OHOS
@@ -14,9 +14,13 @@
 */
 #include "doc_query.h"
 
+#include <algorithm>
 #include <set>
+#include <string_view>
 
-#include "decoded/decoded_event.h"
+#include "base_def.h"
+#include "base/raw_data_base_def.h"
+#include "decoded/raw_data_decoder.h"
 #include "hiview_logger.h"
 #include "sys_event_query.h"
 
@@ -24,6 +28,110 @@ namespace OHOS {
 namespace HiviewDFX {
 namespace EventStore {
 DEFINE_LOG_TAG("HiView-DocQuery");
+using EventRaw::RawDataDecoder;
+namespace {
+bool SkipStringValue(uint8_t* content, size_t maxLen, size_t& pos)
+{
+    uint64_t valueLen = 0;
+    if (!RawDataDecoder::UnsignedVarintDecoded(content, maxLen, pos, valueLen) || valueLen > (maxLen - pos)) {
+        return false;
+    }
+    pos += valueLen;
+    return true;
+}
+
+bool SkipSingleValue(uint8_t* content, size_t maxLen, size_t& pos, uint8_t valueType)
+{
+    switch (valueType) {
+        case EventRaw::ValueType::STRING:
+            return SkipStringValue(content, maxLen, pos);
+        case EventRaw::ValueType::FLOAT:
+        case EventRaw::ValueType::DOUBLE: {
+            double dValue = 0;
+            return RawDataDecoder::FloatingNumberDecoded(content, maxLen, pos, dValue);
+        }
+        case EventRaw::ValueType::BOOL:
+        case EventRaw::ValueType::INT8:
+        case EventRaw::ValueType::UINT8:
+        case EventRaw::ValueType::INT16:
+        case EventRaw::ValueType::UINT16:
+        case EventRaw::ValueType::INT32:
+        case EventRaw::ValueType::UINT32:
+        case EventRaw::ValueType::INT64:
+        case EventRaw::ValueType::UINT64: {
+            uint64_t uValue = 0;
+            return RawDataDecoder::UnsignedVarintDecoded(content, maxLen, pos, uValue);
+        }
+        default:
+            return false;
+    }
+}
+
+bool SkipValue(uint8_t* content, size_t maxLen, size_t& pos, const EventRaw::ParamValueType& valueType)
+{
+    if (valueType.isArray != 1) {
+        return SkipSingleValue(content, maxLen, pos, valueType.valueType);
+    }
+    uint64_t size = 0;
+    if (!RawDataDecoder::UnsignedVarintDecoded(content, maxLen, pos, size)) {
+        return false;
+    }
+    for (; size > 0; --size) {
+        if (!SkipSingleValue(content, maxLen, pos, valueType.valueType)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool DecodeValue(uint8_t* content, size_t maxLen, size_t& pos, uint8_t valueType, FieldValue& value)
+{
+    switch (valueType) {
+        case EventRaw::ValueType::STRING: {
+            std::string sValue;
+            if (!RawDataDecoder::StringValueDecoded(content, maxLen, pos, sValue)) {
+                return false;
+            }
+            value = sValue;
+            return true;
+        }
+        case EventRaw::ValueType::FLOAT:
+        case EventRaw::ValueType::DOUBLE: {
+            double dValue = 0;
+            if (!RawDataDecoder::FloatingNumberDecoded(content, maxLen, pos, dValue)) {
+                return false;
+            }
+            value = dValue;
+            return true;
+        }
+        case EventRaw::ValueType::UINT8:
+        case EventRaw::ValueType::UINT16:
+        case EventRaw::ValueType::UINT32:
+        case EventRaw::ValueType::UINT64: {
+            uint64_t uValue = 0;
+            if (!RawDataDecoder::UnsignedVarintDecoded(content, maxLen, pos, uValue)) {
+                return false;
+            }
+            value = uValue;
+            return true;
+        }
+        case EventRaw::ValueType::BOOL:
+        case EventRaw::ValueType::INT8:
+        case EventRaw::ValueType::INT16:
+        case EventRaw::ValueType::INT32:
+        case EventRaw::ValueType::INT64: {
+            int64_t iValue = 0;
+            if (!RawDataDecoder::SignedVarintDecoded(content, maxLen, pos, iValue)) {
+                return false;
+            }
+            value = iValue;
+            return true;
+        }
+        default:
+            return false;
+    }
+}
+}
 
 void DocQuery::And(const Cond& cond)
 {
@@ -35,12 +143,24 @@ void DocQuery::And(const Cond& cond)
         innerConds_.push_back(cond);
         return;
     }
+    AddExtraCond(cond);
+}
+
+void DocQuery::AddExtraCond(const Cond& cond)
+{
+    int keyIndex = FindExtraKey(reinterpret_cast<const uint8_t*>(cond.col_.data()), cond.col_.size());
+    if (keyIndex < 0) {
+        keyIndex = static_cast<int>(extraKeys_.size());
+        extraKeys_.push_back(cond.col_);
+        extraKeyIndexes_.emplace(std::hash<std::string_view>()(cond.col_), extraKeys_.size() - 1);
+    }
     extraConds_.push_back(cond);
+    extraCondKeyIndexes_.push_back(static_cast<size_t>(keyIndex));
 }
 
 bool DocQuery::IsInnerCond(const Cond& cond) const
 {
-    const std::set<std::string> innerFields = {
+    static const std::set<std::string> innerFields = {
         EventCol::SEQ, EventCol::TS, EventCol::TZ,
         EventCol::PID, EventCol::TID, EventCol::UID,
     };
@@ -103,34 +223,125 @@ bool DocQuery::IsContainInnerConds(uint8_t* content) const
     });
 }
 
+bool DocQuery::IsContainRange(const Cond& cond, int64_t minValue, int64_t maxValue) const
+{
+    if (minValue > maxValue) {
+        // no valid event in the range
+        return false;
+    }
+    FieldValue minFieldValue(minValue);
+    FieldValue maxFieldValue(maxValue);
+    switch (cond.op_) {
+        case EQ:
+            return minFieldValue <= cond.fieldValue_ && maxFieldValue >= cond.fieldValue_;
+        case GT:
+            return maxFieldValue > cond.fieldValue_;
+        case GE:
+            return maxFieldValue >= cond.fieldValue_;
+        case LT:
+            return minFieldValue < cond.fieldValue_;
+        case LE:
+            return minFieldValue <= cond.fieldValue_;
+        default:
+            return true;
+    }
+}
+
+bool DocQuery::IsContainPage(const DocPageIndex& pageIndex) const
+{
+    return std::all_of(innerConds_.begin(), innerConds_.end(), [this, &pageIndex] (auto& cond) {
+        if (cond.col_ == EventCol::SEQ) {
+            return IsContainRange(cond, pageIndex.minSeq, pageIndex.maxSeq);
+        }
+        if (cond.col_ == EventCol::TS) {
+            return IsContainRange(cond, pageIndex.minTs, pageIndex.maxTs);
+        }
+        return true;
+    });
+}
+
 bool DocQuery::IsContainExtraConds(uint8_t* content) const
 {
     if (extraConds_.empty()) {
         return true;
     }
-    EventRaw::DecodedEvent decodedEvent(content);
-    return std::all_of(extraConds_.begin(), extraConds_.end(), [this, &decodedEvent] (auto& cond) {
-        const auto& extraParams = decodedEvent.GetAllCustomizedValues();
-        for (auto& param : extraParams) {
-            if (cond.col_ != param->GetKey()) {
-                continue;
+    // the query is shared by the reader threads, so the buffers are reused per thread instead of per query
+    thread_local std::vector<FieldValue> values;
+    thread_local std::vector<ExtraValueState> states;
+    values.resize(extraKeys_.size());
+    states.assign(extraKeys_.size(), NOT_FOUND);
+    DecodeExtraValues(content, values, states);
+    for (size_t i = 0; i < extraConds_.size(); ++i) {
+        size_t keyIndex = extraCondKeyIndexes_[i];
+        if (states[keyIndex] != VALID || !IsContainCond(extraConds_[i], values[keyIndex])) {
+            return false;
+        }
+    }
+    return true;
+}
+
+int DocQuery::FindExtraKey(const uint8_t* key, size_t keyLen) const
+{
+    std::string_view keyView(reinterpret_cast<const char*>(key), keyLen);
+    auto range = extraKeyIndexes_.equal_range(std::hash<std::string_view>()(keyView));
+    for (auto iter = range.first; iter != range.second; ++iter) {
+        if (extraKeys_[iter->second] == keyView) {
+            return static_cast<int>(iter->second);
+        }
+    }
+    return -1;
+}
+
+void DocQuery::DecodeExtraValues(uint8_t* content, std::vector<FieldValue>& values,
+    std::vector<ExtraValueState>& states) const
+{
+    // walk the encoded params directly, only the values of the referred keys are decoded,
+    // and the walk stops once all of the referred keys are found
+    size_t maxLen = static_cast<size_t>(*(reinterpret_cast<uint32_t*>(content)));
+    size_t pos = sizeof(uint32_t);
+    if (pos + sizeof(EventRaw::HiSysEventHeader) > maxLen) {
+        return;
+    }
+    auto header = reinterpret_cast<EventRaw::HiSysEventHeader*>(content + pos);
+    pos += sizeof(EventRaw::HiSysEventHeader);
+    if (header->isTraceOpened == 1) { // 1: include trace info
+        pos += sizeof(EventRaw::TraceInfo);
+    }
+    if (pos + sizeof(int32_t) > maxLen) {
+        return;
+    }
+    int32_t paramCnt = *(reinterpret_cast<int32_t*>(content + pos));
+    pos += sizeof(int32_t);
+    size_t foundCnt = 0;
+    for (; paramCnt > 0 && foundCnt < extraKeys_.size(); --paramCnt) {
+        uint64_t keyLen = 0;
+        if (!RawDataDecoder::UnsignedVarintDecoded(content, maxLen, pos, keyLen) || keyLen > (maxLen - pos)) {
+            return;
+        }
+        int keyIndex = FindExtraKey(content + pos, keyLen);
+        pos += keyLen;
+        EventRaw::ParamValueType valueType;
+        if (!RawDataDecoder::ValueTypeDecoded(content, maxLen, pos, valueType)) {
+            return;
+        }
+
+        // only the first param of the key is used, and the array param never matches the condition
+        if (keyIndex < 0 || states[keyIndex] != NOT_FOUND || valueType.isArray == 1) {
+            if (keyIndex >= 0 && states[keyIndex] == NOT_FOUND) {
+                states[keyIndex] = INVALID;
+                foundCnt++;
             }
-            FieldValue paramValue;
-            if (int64_t intValue = 0; param->AsInt64(intValue)) {
-                paramValue = intValue;
-            } else if (uint64_t uintValue = 0; param->AsUint64(uintValue)) {
-                paramValue = uintValue;
-            } else if (double dValue = 0; param->AsDouble(dValue)) {
-                paramValue = dValue;
-            } else if (std::string sValue; param->AsString(sValue)) {
-                paramValue = sValue;
-            } else {
-                return false;
+            if (!SkipValue(content, maxLen, pos, valueType)) {
+                return;
             }
-            return IsContainCond(cond, paramValue);
+            continue;
         }
-        return false;
-    });
+        if (!DecodeValue(content, maxLen, pos, valueType.valueType, values[keyIndex])) {
+            return;
+        }
+        states[keyIndex] = VALID;
+        foundCnt++;
+    }
 }
 
 std::string DocQuery::ToString() const
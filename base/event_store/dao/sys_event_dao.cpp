@@ -72,6 +72,21 @@ void SysEventDao::Clear()
     SysEventDatabase::GetInstance().Clear();
 }
 
+int SysEventDao::Commit(bool isForce)
+{
+    return SysEventDatabase::GetInstance().Commit(isForce);
+}
+
+bool SysEventDao::GetCommitStat(GroupCommitStat& stat)
+{
+    return SysEventDatabase::GetInstance().GetCommitStat(stat);
+}
+
+uint64_t SysEventDao::GetRemovedFileCount()
+{
+    return SysEventDatabase::GetInstance().GetRemovedFileCount();
+}
+
 std::string SysEventDao::GetDatabaseDir()
 {
     return SysEventDatabase::GetInstance().GetDatabaseDir();
@@ -16,6 +16,7 @@
 #ifndef HIVIEW_BASE_EVENT_STORE_INCLUDE_BASE_DEF_H
 #define HIVIEW_BASE_EVENT_STORE_INCLUDE_BASE_DEF_H
 
+#include <cstdint>
 #include <string>
 
 namespace OHOS {
@@ -68,6 +69,45 @@ enum EVENT_DATA_FORMATE_VERSION {
     CURRENT = VERSION4,
 };
 
+/* Statistics of the group commit of event docs */
+struct GroupCommitStat {
+    /* Count of commits */
+    uint64_t commitCnt = 0;
+
+    /* Count of committed events */
+    uint64_t eventCnt = 0;
+
+    /* Count of committed bytes */
+    uint64_t byteCnt = 0;
+
+    /* Max count of events in one commit */
+    uint64_t maxBatchEventCnt = 0;
+
+    /* Total time cost of commits in microseconds */
+    uint64_t totalLatency = 0;
+
+    /* Max time cost of one commit in microseconds */
+    uint64_t maxLatency = 0;
+
+    /* Count of commits failed to write some docs, whose data are kept for the next commit */
+    uint64_t failCnt = 0;
+};
+
+/* Range of the events in one page of the event doc */
+struct DocPageIndex {
+    /* Min seq of the events in the page */
+    int64_t minSeq = INT64_MAX;
+
+    /* Max seq of the events in the page */
+    int64_t maxSeq = INT64_MIN;
+
+    /* Min timestamp of the events in the page */
+    int64_t minTs = INT64_MAX;
+
+    /* Max timestamp of the events in the page */
+    int64_t maxTs = INT64_MIN;
+};
+
 #pragma pack(1)
 /* File header of the binary storage file */
 struct DocHeader {
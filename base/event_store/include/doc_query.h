@@ -16,12 +16,15 @@
 #define HIVIEW_BASE_EVENT_STORE_INCLUDE_DOC_QUERY_H
 
 #include <string>
+#include <unordered_map>
+#include <vector>
 
 namespace OHOS {
 namespace HiviewDFX {
 namespace EventStore {
 class Cond;
 class FieldValue;
+struct DocPageIndex;
 
 class DocQuery {
 public:
@@ -29,6 +32,7 @@ public:
     void And(const Cond& cond);
     bool IsContainExtraConds(uint8_t* content) const;
     bool IsContainInnerConds(uint8_t* content) const;
+    bool IsContainPage(const DocPageIndex& pageIndex) const;
     std::string ToString() const;
 
 private:
@@ -46,11 +50,26 @@ private:
 #pragma pack()
 
     bool IsContainInnerCond(const InnerFieldStruct& innerField, const Cond& cond) const;
+    enum ExtraValueState : uint8_t { NOT_FOUND = 0, VALID, INVALID };
+
     bool IsContainCond(const Cond& cond, const FieldValue& value) const;
+    bool IsContainRange(const Cond& cond, int64_t minValue, int64_t maxValue) const;
     bool IsInnerCond(const Cond& cond) const;
+    void AddExtraCond(const Cond& cond);
+    int FindExtraKey(const uint8_t* key, size_t keyLen) const;
+    void DecodeExtraValues(uint8_t* content, std::vector<FieldValue>& values,
+        std::vector<ExtraValueState>& states) const;
 
     std::vector<Cond> innerConds_;
     std::vector<Cond> extraConds_;
+
+    // the extra conditions are compiled into the index of the keys they refer to,
+    // so the params of the event are decoded only for the referred keys
+    std::vector<std::string> extraKeys_;
+    std::vector<size_t> extraCondKeyIndexes_;
+
+    // hash of the key -> index of the key, the keys with the same hash are compared one by one
+    std::unordered_multimap<size_t, size_t> extraKeyIndexes_;
 }; // DocQuery
 } // EventStore
 } // HiviewDFX
@@ -20,6 +20,7 @@
 #include <string>
 #include <vector>
 
+#include "base_def.h"
 #include "sys_event.h"
 #include "sys_event_query.h"
 
@@ -41,6 +42,9 @@ public:
     static void Restore();
     static std::string GetDatabaseDir();
     static void Clear();
+    static int Commit(bool isForce = true);
+    static bool GetCommitStat(GroupCommitStat& stat);
+    static uint64_t GetRemovedFileCount();
 }; // SysEventDao
 } // EventStore
 } // namespace HiviewDFX
@@ -16,7 +16,9 @@
 #ifndef HIVIEW_BASE_EVENT_STORE_SYS_EVENT_DATABASE_H
 #define HIVIEW_BASE_EVENT_STORE_SYS_EVENT_DATABASE_H
 
+#include <atomic>
 #include <queue>
+#include <map>
 #include <memory>
 #include <shared_mutex>
 #include <string>
@@ -25,6 +27,7 @@
 #include "doc_query.h"
 #include "singleton.h"
 #include "sys_event_query.h"
+#include "sys_event_doc_catalog.h"
 #include "sys_event_doc_lru_cache.h"
 
 namespace OHOS {
@@ -41,10 +44,14 @@ public:
     std::string GetDatabaseDir();
     bool Backup(const std::string& zipFilePath);
     bool Restore(const std::string& zipFilePath, const std::string& restoreDir);
+    int Commit(bool isForce = true);
+    bool GetCommitStat(GroupCommitStat& stat);
+    uint64_t GetRemovedFileCount();
+    SysEventDocCatalog& GetDocCatalog();
 
 private:
-    using FileQueue = std::priority_queue<std::string, std::vector<std::string>,
-        bool(*)(const std::string&, const std::string&)>;
+    using FileQueue = std::priority_queue<DocFilePtr, std::vector<DocFilePtr>,
+        bool(*)(const DocFilePtr&, const DocFilePtr&)>;
     // <eventType, <maxSize, maxFileNum>>
     using EventQuotaMap = std::unordered_map<int, std::pair<uint64_t, uint32_t>>;
     // <eventType, <totalFileSize, fileQueue that is normal, fileQueue that is over limit>>
@@ -55,15 +62,37 @@ private:
     uint32_t GetMaxFileNum(int type);
     uint64_t GetMaxSize(int type);
     void GetQueryFiles(const SysEventQueryArg& queryArg, FileQueue& queryFiles);
-    void GetQueryDirsByDomain(const std::string& domain, std::vector<std::string>& queryDirs);
-    bool IsContainQueryArg(const std::string& file, const SysEventQueryArg& queryArg,
-        std::unordered_map<std::string, long long>& nameSeqMap);
+    bool IsContainQueryArg(const DocFileInfo& file, const SysEventQueryArg& queryArg);
     int QueryByFiles(SysEventQuery& query, EntryQueue& entries, FileQueue& queryFiles);
+    int QueryByFilesInParallel(SysEventQuery& query, const DocQuery& docQuery, EntryQueue& entries,
+        FileQueue& queryFiles);
+    std::shared_ptr<SysEventDoc> GetDoc(const SysEventDocLruCache::LruCacheKey& key);
+    void AddPending(const SysEventDocLruCache::LruCacheKey& key, std::shared_ptr<SysEventDoc> doc,
+        size_t pendingSize);
+    bool IsNeedCommit(int eventType);
+    bool IsCommitExpired();
+    int CommitLocked();
 
     EventQuotaMap quotaMap_;
     ClearFilesMap clearMap_;
     std::unique_ptr<SysEventDocLruCache> lruCache_;
+    size_t queryWorkerNum_ = 0;
+    SysEventDocCatalog catalog_;
     mutable std::shared_mutex mutex_;
+
+    // docs with data not flushed yet when group commit is enabled
+    bool isGroupCommit_ = false;
+    uint64_t commitMaxSize_ = 0;
+    uint64_t commitMaxLatency_ = 0;
+    std::map<SysEventDocLruCache::LruCacheKey, std::shared_ptr<SysEventDoc>> pendingDocs_;
+    uint64_t pendingSize_ = 0;
+    uint64_t pendingEventCnt_ = 0;
+    uint64_t firstPendingTime_ = 0;
+    std::atomic<bool> hasPending_ { false };
+    GroupCommitStat commitStat_;
+
+    // count of the files removed by clear, the events read before may be gone once it changes
+    std::atomic<uint64_t> removedFileCnt_ { 0 };
 }; // SysEventDatabase
 } // EventStore
 } // HiviewDFX
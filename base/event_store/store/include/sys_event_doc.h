@@ -34,10 +34,13 @@ public:
     ~SysEventDoc();
 
     int Insert(const std::shared_ptr<SysEvent>& sysEvent);
+    int Commit();
+    size_t GetPendingSize();
     int Query(const DocQuery& query, EntryQueue& entries, int& num);
 
 private:
     int InitWriter(const std::shared_ptr<SysEvent>& sysEvent);
+    int ReleaseWriter();
     int InitReader();
     std::string CreateFile();
     std::string GetDir();
@@ -56,6 +59,7 @@ private:
     int type_;
     std::string level_;
     std::string curFile_;
+    bool isGroupCommit_ = false;
 }; // SysEventDoc
 } // EventStore
 } // HiviewDFX
@@ -0,0 +1,70 @@
+/*
+ * Copyright (c) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef HIVIEW_BASE_EVENT_STORE_SYS_EVENT_DOC_CATALOG_H
+#define HIVIEW_BASE_EVENT_STORE_SYS_EVENT_DOC_CATALOG_H
+
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace OHOS {
+namespace HiviewDFX {
+namespace EventStore {
+struct DocFileInfo {
+    std::string path;
+    std::string domain;
+    std::string name;
+    std::string level;
+    int type = 0;
+    int64_t seq = 0;
+    uint64_t size = 0;
+};
+using DocFilePtr = std::shared_ptr<DocFileInfo>;
+
+class SysEventDocCatalog {
+public:
+    SysEventDocCatalog() = default;
+    ~SysEventDocCatalog() = default;
+
+    void Reset();
+    void AddFile(const std::string& path);
+    void RemoveFile(const std::string& path);
+    void RefreshSize();
+    void GetFiles(const std::string& domain, std::vector<DocFilePtr>& files);
+    std::string GetLatestFile(const std::string& domain, const std::string& name);
+
+    static bool ParseFilePath(const std::string& path, DocFileInfo& info);
+
+private:
+    // <name, <seq, file>>, files of one event are sorted by the seq in file name, so a file holds the seqs from
+    // its own up to the next one; the type is not a key since it is fixed by the event name
+    using NameFilesMap = std::unordered_map<std::string, std::map<int64_t, DocFilePtr>>;
+
+    void LoadIfNeed();
+    void AddFileLocked(const std::string& path, bool needSize);
+    void GetDomainFiles(const NameFilesMap& nameFiles, std::vector<DocFilePtr>& files);
+
+    bool isLoaded_ = false;
+    std::unordered_map<std::string, NameFilesMap> catalog_;
+    std::mutex mutex_;
+}; // SysEventDocCatalog
+} // EventStore
+} // HiviewDFX
+} // OHOS
+#endif // HIVIEW_BASE_EVENT_STORE_SYS_EVENT_DOC_CATALOG_H
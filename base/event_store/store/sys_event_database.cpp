@@ -14,19 +14,20 @@
  */
 #include "sys_event_database.h"
 
-#include <sstream>
+#include <algorithm>
 #include <unordered_map>
 
 #include "event_store_config.h"
+#include "ffrt.h"
 #include "file_util.h"
 #include "hisysevent.h"
 #include "hiview_global.h"
 #include "hiview_logger.h"
 #include "hiview_zip_util.h"
-#include "string_util.h"
 #include "sys_event_dao.h"
 #include "sys_event_sequence_mgr.h"
 #include "sys_event_repeat_guard.h"
+#include "time_util.h"
 
 namespace OHOS {
 namespace HiviewDFX {
@@ -35,58 +36,39 @@ DEFINE_LOG_TAG("HiView-SysEventDatabase");
 namespace {
 constexpr size_t DEFAULT_CAPACITY = 30;
 const char FILE_DELIMIT_STR[] = "/";
-const char FILE_NAME_DELIMIT_STR[] = "-";
 constexpr size_t INDEX_FILE_SIZE = 0;
 constexpr size_t INDEX_NORMAL_QUEUE = 1;
 constexpr size_t INDEX_LIMIT_QUEUE = 2;
 
-int64_t GetFileSeq(const std::string& file)
+bool CompareFileLessFunc(const DocFilePtr& fileA, const DocFilePtr& fileB)
 {
-    std::stringstream ss;
-    ss << file.substr(file.rfind(FILE_NAME_DELIMIT_STR) + 1);
-    long long seq = 0;
-    ss >> seq;
-    return seq;
+    return fileA->seq < fileB->seq;
 }
 
-std::string GetFileDomain(const std::string& file)
+bool CompareFileGreaterFunc(const DocFilePtr& fileA, const DocFilePtr& fileB)
 {
-    std::vector<std::string> dirNames;
-    StringUtil::SplitStr(file, FILE_DELIMIT_STR, dirNames);
-    constexpr size_t domainOffset = 2;
-    return dirNames.size() < domainOffset ? "" : dirNames[dirNames.size() - domainOffset];
-}
-
-bool CompareFileLessFunc(const std::string& fileA, const std::string& fileB)
-{
-    return GetFileSeq(fileA) < GetFileSeq(fileB);
-}
-
-bool CompareFileGreaterFunc(const std::string& fileA, const std::string& fileB)
-{
-    return GetFileSeq(fileA) > GetFileSeq(fileB);
-}
-
-std::string GetEventTypeFromFileName(const std::string& fileName)
-{
-    std::vector<std::string> splitStrs;
-    StringUtil::SplitStr(fileName, FILE_NAME_DELIMIT_STR, splitStrs);
-    if (splitStrs.size() < FILE_NAME_SPLIT_SIZE) {
-        HIVIEW_LOGW("invalid file name, file=%{public}s", fileName.c_str());
-        return "";
-    }
-    return splitStrs[EVENT_TYPE_INDEX];
+    return fileA->seq > fileB->seq;
 }
 }
 
 SysEventDatabase::SysEventDatabase()
 {
     lruCache_ = std::make_unique<SysEventDocLruCache>(DEFAULT_CAPACITY);
+    queryWorkerNum_ = EventStoreConfig::GetInstance().GetParallelQueryWorkerNum();
     SysEventRepeatGuard::RegisterListeningUeSwitch();
+    isGroupCommit_ = EventStoreConfig::GetInstance().IsGroupCommitEnabled();
+    if (isGroupCommit_) {
+        commitMaxSize_ = static_cast<uint64_t>(EventStoreConfig::GetInstance().GetGroupCommitMaxSize()) *
+            NUM_OF_BYTES_IN_KB;
+        commitMaxLatency_ = EventStoreConfig::GetInstance().GetGroupCommitMaxLatency();
+        HIVIEW_LOGI("group commit enabled, maxSize=%{public}" PRIu64 ", maxLatency=%{public}" PRIu64,
+            commitMaxSize_, commitMaxLatency_);
+    }
 }
 
 SysEventDatabase::~SysEventDatabase()
 {
+    Commit();
     SysEventRepeatGuard::UnregisterListeningUeSwitch();
 }
 
@@ -117,15 +99,143 @@ std::string SysEventDatabase::GetDatabaseDir()
 int SysEventDatabase::Insert(const std::shared_ptr<SysEvent>& event)
 {
     std::unique_lock<std::shared_mutex> lock(mutex_);
-    std::shared_ptr<SysEventDoc> sysEventDoc = nullptr;
     auto keyOfCache = std::pair<std::string, std::string>(event->domain_, event->eventName_);
-    if (lruCache_->Contain(keyOfCache)) {
-        sysEventDoc = lruCache_->Get(keyOfCache);
+    std::shared_ptr<SysEventDoc> sysEventDoc = GetDoc(keyOfCache);
+    if (!isGroupCommit_) {
+        return sysEventDoc->Insert(event);
+    }
+
+    size_t pendingSizeBefore = sysEventDoc->GetPendingSize();
+    int ret = sysEventDoc->Insert(event);
+    size_t pendingSizeAfter = sysEventDoc->GetPendingSize();
+    if (pendingSizeAfter > 0) {
+        // the doc may switch to a new file during insert, which commits the data of the old file
+        AddPending(keyOfCache, sysEventDoc,
+            pendingSizeAfter > pendingSizeBefore ? (pendingSizeAfter - pendingSizeBefore) : pendingSizeAfter);
+    }
+    if (IsNeedCommit(event->eventType_)) {
+        CommitLocked();
+    }
+    return ret;
+}
+
+std::shared_ptr<SysEventDoc> SysEventDatabase::GetDoc(const SysEventDocLruCache::LruCacheKey& key)
+{
+    if (lruCache_->Contain(key)) {
+        return lruCache_->Get(key);
+    }
+
+    // reuse the doc evicted from cache but still holding pending data, so the same file has only one writer
+    std::shared_ptr<SysEventDoc> sysEventDoc = nullptr;
+    if (auto iter = pendingDocs_.find(key); iter != pendingDocs_.end()) {
+        sysEventDoc = iter->second;
     } else {
-        sysEventDoc = std::make_shared<SysEventDoc>(event->domain_, event->eventName_);
-        lruCache_->Add(keyOfCache, sysEventDoc);
+        sysEventDoc = std::make_shared<SysEventDoc>(key.first, key.second);
+    }
+    lruCache_->Add(key, sysEventDoc);
+    return sysEventDoc;
+}
+
+void SysEventDatabase::AddPending(const SysEventDocLruCache::LruCacheKey& key, std::shared_ptr<SysEventDoc> doc,
+    size_t pendingSize)
+{
+    if (pendingDocs_.empty()) {
+        firstPendingTime_ = TimeUtil::GetSteadyClockTimeMs();
+    }
+    pendingDocs_[key] = doc;
+    pendingSize_ += pendingSize;
+    pendingEventCnt_++;
+    hasPending_ = true;
+}
+
+bool SysEventDatabase::IsNeedCommit(int eventType)
+{
+    if (pendingDocs_.empty()) {
+        return false;
+    }
+    if (eventType == HiSysEvent::EventType::FAULT || pendingSize_ >= commitMaxSize_) {
+        return true;
+    }
+    return IsCommitExpired();
+}
+
+bool SysEventDatabase::IsCommitExpired()
+{
+    return !pendingDocs_.empty() && TimeUtil::GetSteadyClockTimeMs() >= (firstPendingTime_ + commitMaxLatency_);
+}
+
+int SysEventDatabase::Commit(bool isForce)
+{
+    if (!hasPending_) {
+        return DOC_STORE_SUCCESS;
     }
-    return sysEventDoc->Insert(event);
+    std::unique_lock<std::shared_mutex> lock(mutex_);
+    if (!isForce && !IsCommitExpired()) {
+        return DOC_STORE_SUCCESS;
+    }
+    return CommitLocked();
+}
+
+int SysEventDatabase::CommitLocked()
+{
+    if (pendingDocs_.empty()) {
+        return DOC_STORE_SUCCESS;
+    }
+    int result = DOC_STORE_SUCCESS;
+    uint64_t failedSize = 0;
+    uint64_t beginTime = TimeUtil::GetNanoTime();
+    for (auto iter = pendingDocs_.begin(); iter != pendingDocs_.end();) {
+        if (int ret = iter->second->Commit(); ret != DOC_STORE_SUCCESS) {
+            HIVIEW_LOGE("failed to commit doc of %{public}s|%{public}s, ret=%{public}d",
+                iter->first.first.c_str(), iter->first.second.c_str(), ret);
+            // keep the doc with its unwritten data, the next commit retries it
+            failedSize += iter->second->GetPendingSize();
+            result = ret;
+            ++iter;
+            continue;
+        }
+        iter = pendingDocs_.erase(iter);
+    }
+    constexpr uint64_t nanoPerMicro = 1000;
+    uint64_t latency = (TimeUtil::GetNanoTime() - beginTime) / nanoPerMicro;
+    uint64_t committedSize = pendingSize_ > failedSize ? (pendingSize_ - failedSize) : 0;
+    commitStat_.commitCnt++;
+    commitStat_.eventCnt += pendingEventCnt_;
+    commitStat_.byteCnt += committedSize;
+    commitStat_.maxBatchEventCnt = std::max(commitStat_.maxBatchEventCnt, pendingEventCnt_);
+    commitStat_.totalLatency += latency;
+    commitStat_.maxLatency = std::max(commitStat_.maxLatency, latency);
+    HIVIEW_LOGD("commit %{public}zu docs, events=%{public}" PRIu64 ", size=%{public}" PRIu64
+        ", latency=%{public}" PRIu64 "us", pendingDocs_.size(), pendingEventCnt_, committedSize, latency);
+
+    pendingSize_ = failedSize;
+    pendingEventCnt_ = 0;
+    if (result != DOC_STORE_SUCCESS) {
+        commitStat_.failCnt++;
+        return result;
+    }
+    hasPending_ = false;
+    return DOC_STORE_SUCCESS;
+}
+
+bool SysEventDatabase::GetCommitStat(GroupCommitStat& stat)
+{
+    if (!isGroupCommit_) {
+        return false;
+    }
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    stat = commitStat_;
+    return true;
+}
+
+uint64_t SysEventDatabase::GetRemovedFileCount()
+{
+    return removedFileCnt_;
+}
+
+SysEventDocCatalog& SysEventDatabase::GetDocCatalog()
+{
+    return catalog_;
 }
 
 void SysEventDatabase::CheckRepeat(SysEvent& event)
@@ -136,14 +246,15 @@ void SysEventDatabase::CheckRepeat(SysEvent& event)
 bool SysEventDatabase::Backup(const std::string& zipFilePath)
 {
     HIVIEW_LOGI("start backup.");
+    Commit();
     std::shared_lock<std::shared_mutex> lock(mutex_);
-    std::vector<std::string> domainDirs;
-    std::string dbDir(GetDatabaseDir());
-    FileUtil::GetDirDirs(dbDir, domainDirs);
-    if (domainDirs.empty()) {
+    std::vector<DocFilePtr> eventFiles;
+    catalog_.GetFiles("", eventFiles);
+    if (eventFiles.empty()) {
         HIVIEW_LOGI("no event files exist.");
         return false;
     }
+    std::string dbDir(GetDatabaseDir());
     std::string seqFilePath(dbDir + SEQ_PERSISTS_FILE_NAME);
     if (!FileUtil::FileExists(seqFilePath)) {
         HIVIEW_LOGW("seq id file not exist.");
@@ -162,19 +273,13 @@ bool SysEventDatabase::Backup(const std::string& zipFilePath)
         return false;
     }
 
-    const std::string faultType(std::to_string(HiSysEvent::EventType::FAULT));
-    for (const auto& domainDir : domainDirs) {
-        std::vector<std::string> eventFiles;
-        FileUtil::GetDirFiles(domainDir, eventFiles, false);
-        for (const auto& eventFile : eventFiles) {
-            std::string fileName(FileUtil::ExtractFileName(eventFile));
-            if (GetEventTypeFromFileName(fileName) != faultType) {
-                continue;
-            }
-            if (int32_t ret = zipUnit.AddFileInZip(eventFile, ZipFileLevel::KEEP_ONE_PARENT_PATH); ret != 0) {
-                HIVIEW_LOGW("zip file failed: %{public}s, ret: %{public}d", fileName.c_str(), ret);
-                return false;
-            }
+    for (const auto& eventFile : eventFiles) {
+        if (eventFile->type != HiSysEvent::EventType::FAULT) {
+            continue;
+        }
+        if (int32_t ret = zipUnit.AddFileInZip(eventFile->path, ZipFileLevel::KEEP_ONE_PARENT_PATH); ret != 0) {
+            HIVIEW_LOGW("zip file failed: %{public}s, ret: %{public}d", eventFile->path.c_str(), ret);
+            return false;
         }
     }
     HIVIEW_LOGI("finish backup.");
@@ -196,6 +301,7 @@ bool SysEventDatabase::Restore(const std::string& zipFilePath, const std::string
         HIVIEW_LOGW("seq id file not exist in zip file.");
         return false;
     }
+    catalog_.Reset(); // the restored files will be loaded again
     HIVIEW_LOGI("finish restore.");
     return true;
 }
@@ -203,6 +309,7 @@ bool SysEventDatabase::Restore(const std::string& zipFilePath, const std::string
 void SysEventDatabase::Clear()
 {
     std::unique_lock<std::shared_mutex> lock(mutex_);
+    CommitLocked();
     UpdateClearMap();
     if (!clearMap_.empty()) {
         ClearCache(); // need to close the open files before clear
@@ -220,7 +327,7 @@ void SysEventDatabase::Clear()
         auto& normalQueue = std::get<INDEX_NORMAL_QUEUE>(it->second);
         auto& limitQueue = std::get<INDEX_LIMIT_QUEUE>(it->second);
         while (totalFileSize >= maxSize) {
-            std::string delFile;
+            DocFilePtr delFile;
             if (!limitQueue.empty()) {
                 delFile = limitQueue.top();
                 limitQueue.pop();
@@ -231,12 +338,14 @@ void SysEventDatabase::Clear()
                 break;
             }
 
-            auto fileSize = FileUtil::GetFileSize(delFile);
-            if (!FileUtil::RemoveFile(delFile)) {
-                HIVIEW_LOGI("failed to remove file=%{public}s", delFile.c_str());
+            auto fileSize = delFile->size;
+            if (!FileUtil::RemoveFile(delFile->path)) {
+                HIVIEW_LOGI("failed to remove file=%{public}s", delFile->path.c_str());
                 continue;
             }
-            HIVIEW_LOGI("success to remove file=%{public}s", delFile.c_str());
+            catalog_.RemoveFile(delFile->path);
+            removedFileCnt_++;
+            HIVIEW_LOGI("success to remove file=%{public}s", delFile->path.c_str());
             totalFileSize = totalFileSize >= fileSize ? (totalFileSize - fileSize) : 0;
         }
         HIVIEW_LOGI("end to clear type=%{public}d, curSize=%{public}" PRIu64 ", maxSize=%{public}" PRIu64,
@@ -246,6 +355,7 @@ void SysEventDatabase::Clear()
 
 int SysEventDatabase::Query(SysEventQuery& sysEventQuery, EntryQueue& entries)
 {
+    Commit(); // make the pending events visible to the query
     std::shared_lock<std::shared_mutex> lock(mutex_);
     FileQueue queryFiles(CompareFileLessFunc);
     const auto& queryArg = sysEventQuery.queryArg_;
@@ -264,28 +374,19 @@ void SysEventDatabase::UpdateClearMap()
     // clear the map
     clearMap_.clear();
 
-    // get all event files
-    FileQueue files(CompareFileLessFunc);
-    GetQueryFiles(SysEventQueryArg(), files);
+    // get all event files, only the sizes of the files being written need to be updated
+    catalog_.RefreshSize();
+    std::vector<DocFilePtr> files;
+    catalog_.GetFiles("", files);
+    std::sort(files.begin(), files.end(), CompareFileGreaterFunc);
 
     // build clear map
     std::unordered_map<std::string, uint32_t> nameLimitMap;
-    while (!files.empty()) {
-        std::string file = files.top();
-        files.pop();
-        std::string fileName = file.substr(file.rfind(FILE_DELIMIT_STR) + 1); // 1 for skipping '/'
-        std::vector<std::string> splitNames;
-        StringUtil::SplitStr(fileName, "-", splitNames);
-        if (splitNames.size() != FILE_NAME_SPLIT_SIZE) {
-            HIVIEW_LOGI("invalid clear file=%{public}s", file.c_str());
-            continue;
-        }
-
-        std::string name = splitNames[EVENT_NAME_INDEX];
-        std::string domainNameStr = GetFileDomain(file) + name;
+    for (const auto& file : files) {
+        std::string domainNameStr = file->domain + file->name;
         nameLimitMap[domainNameStr]++;
-        int type = std::strtol(splitNames[EVENT_TYPE_INDEX].c_str(), nullptr, 0);
-        uint64_t fileSize = FileUtil::GetFileSize(file);
+        int type = file->type;
+        uint64_t fileSize = file->size;
         if (clearMap_.find(type) == clearMap_.end()) {
             FileQueue fileQueue(CompareFileGreaterFunc);
             fileQueue.emplace(file);
@@ -321,69 +422,44 @@ uint64_t SysEventDatabase::GetMaxSize(int type)
 
 void SysEventDatabase::GetQueryFiles(const SysEventQueryArg& queryArg, FileQueue& queryFiles)
 {
-    std::vector<std::string> queryDirs;
-    GetQueryDirsByDomain(queryArg.domain, queryDirs);
-    if (queryDirs.empty()) {
+    std::vector<DocFilePtr> files;
+    catalog_.GetFiles(queryArg.domain, files);
+    if (files.empty()) {
         return;
     }
 
-    for (const auto& queryDir : queryDirs) {
-        std::vector<std::string> files;
-        FileUtil::GetDirFiles(queryDir, files);
-        sort(files.begin(), files.end(), CompareFileGreaterFunc);
-        std::unordered_map<std::string, long long> nameSeqMap;
-        for (const auto& file : files) {
-            if (IsContainQueryArg(file, queryArg, nameSeqMap)) {
-                queryFiles.emplace(file);
-                HIVIEW_LOGD("add query file=%{public}s", file.c_str());
+    // the files of the same event are sorted by seq, so the file whose next file begins
+    // with a seq not greater than fromSeq can be skipped without opening it
+    sort(files.begin(), files.end(), CompareFileGreaterFunc);
+    std::unordered_map<std::string, int64_t> nameSeqMap;
+    for (const auto& file : files) {
+        std::string domainNameStr = file->domain + file->name;
+        if (queryArg.fromSeq != INVALID_VALUE_INT) {
+            auto iter = nameSeqMap.find(domainNameStr);
+            if (iter != nameSeqMap.end() && iter->second <= queryArg.fromSeq) {
+                continue;
             }
+            nameSeqMap[domainNameStr] = file->seq;
         }
-    }
-}
-
-void SysEventDatabase::GetQueryDirsByDomain(const std::string& domain, std::vector<std::string>& queryDirs)
-{
-    if (domain.empty()) {
-        FileUtil::GetDirDirs(GetDatabaseDir(), queryDirs);
-    } else {
-        std::string domainDir = GetDatabaseDir() + domain;
-        if (FileUtil::IsDirectory(domainDir)) {
-            queryDirs.push_back(domainDir + FILE_DELIMIT_STR);
+        if (IsContainQueryArg(*file, queryArg)) {
+            queryFiles.emplace(file);
+            HIVIEW_LOGD("add query file=%{public}s", file->path.c_str());
         }
     }
 }
 
-bool SysEventDatabase::IsContainQueryArg(const std::string& file, const SysEventQueryArg& queryArg,
-    std::unordered_map<std::string, long long>& nameSeqMap)
+bool SysEventDatabase::IsContainQueryArg(const DocFileInfo& file, const SysEventQueryArg& queryArg)
 {
-    if (queryArg.names.empty() && queryArg.type == 0 && queryArg.toSeq == INVALID_VALUE_INT) {
-        return true;
-    }
-    std::string fileName = file.substr(file.rfind(FILE_DELIMIT_STR) + 1); // 1 for next char
-    std::vector<std::string> splitStrs;
-    StringUtil::SplitStr(fileName, FILE_NAME_DELIMIT_STR, splitStrs);
-    if (splitStrs.size() < FILE_NAME_SPLIT_SIZE) {
-        HIVIEW_LOGE("invalid file name, file=%{public}s", fileName.c_str());
-        return false;
-    }
-    std::string eventName = splitStrs[EVENT_NAME_INDEX];
-    std::string eventType = splitStrs[EVENT_TYPE_INDEX];
-    long long eventSeq = std::strtoll(splitStrs[EVENT_SEQ_INDEX].c_str(), nullptr, 0);
-    auto iter = nameSeqMap.find(eventName);
-    if (iter != nameSeqMap.end() && iter->second <= queryArg.fromSeq) {
-        return false;
-    }
-    nameSeqMap[eventName] = eventSeq;
     if (!queryArg.names.empty() && !std::any_of(queryArg.names.begin(), queryArg.names.end(),
-        [&eventName] (auto& item) {
-            return item == eventName;
+        [&file] (auto& item) {
+            return item == file.name;
         })) {
         return false;
     }
-    if (queryArg.type != 0 && eventType != StringUtil::ToString(queryArg.type)) {
+    if (queryArg.type != 0 && file.type != static_cast<int>(queryArg.type)) {
         return false;
     }
-    if (queryArg.toSeq != INVALID_VALUE_INT && eventSeq >= queryArg.toSeq) {
+    if (queryArg.toSeq != INVALID_VALUE_INT && file.seq >= queryArg.toSeq) {
         return false;
     }
     return true;
@@ -393,23 +469,102 @@ int SysEventDatabase::QueryByFiles(SysEventQuery& sysEventQuery, EntryQueue& ent
 {
     DocQuery docQuery;
     sysEventQuery.BuildDocQuery(docQuery);
+    if (queryWorkerNum_ > 1 && queryFiles.size() > 1) {
+        return QueryByFilesInParallel(sysEventQuery, docQuery, entries, queryFiles);
+    }
     int totalNum = 0;
     while (!queryFiles.empty()) {
-        std::string file = queryFiles.top();
+        DocFilePtr file = queryFiles.top();
         queryFiles.pop();
-        auto sysEventDoc = std::make_shared<SysEventDoc>(file);
+        auto sysEventDoc = std::make_shared<SysEventDoc>(file->path);
         if (auto res = sysEventDoc->Query(docQuery, entries, totalNum); res != DOC_STORE_SUCCESS) {
-            HIVIEW_LOGE("failed to query event from doc, file=%{public}s, res=%{public}d", file.c_str(), res);
+            HIVIEW_LOGE("failed to query event from doc, file=%{public}s, res=%{public}d", file->path.c_str(), res);
             continue;
         }
         if (totalNum >= sysEventQuery.limit_) {
-            sysEventQuery.queryArg_.toSeq = GetFileSeq(file);
+            sysEventQuery.queryArg_.toSeq = file->seq;
             break;
         }
     }
     HIVIEW_LOGD("query end, limit=%{public}d, totalNum=%{public}d", sysEventQuery.limit_, totalNum);
     return DOC_STORE_SUCCESS;
 }
+
+int SysEventDatabase::QueryByFilesInParallel(SysEventQuery& sysEventQuery, const DocQuery& docQuery,
+    EntryQueue& entries, FileQueue& queryFiles)
+{
+    struct FileResult {
+        EntryQueue entries;
+        int num = 0;
+        int ret = DOC_STORE_SUCCESS;
+        bool isDone = false;
+        explicit FileResult(CompareFunc func) : entries(func) {}
+    };
+    std::vector<DocFilePtr> files;
+    std::vector<FileResult> results;
+    while (!queryFiles.empty()) {
+        files.emplace_back(queryFiles.top());
+        queryFiles.pop();
+        results.emplace_back(sysEventQuery.CreateCompareFunc());
+    }
+
+    // the files are claimed in the order of the serial query, and the results are counted in the same order,
+    // the files after the one that makes the results reach the limit are cancelled
+    std::atomic<size_t> nextIndex { 0 };
+    std::atomic<size_t> endIndex { files.size() };
+    size_t countedIndex = 0;
+    int totalNum = 0;
+    ffrt::mutex resultMutex;
+    auto queryTask = [&] () {
+        for (size_t index = nextIndex++; index < endIndex; index = nextIndex++) {
+            auto sysEventDoc = std::make_shared<SysEventDoc>(files[index]->path);
+            int num = 0;
+            int ret = sysEventDoc->Query(docQuery, results[index].entries, num);
+
+            std::lock_guard<ffrt::mutex> lock(resultMutex);
+            results[index].num = num;
+            results[index].ret = ret;
+            results[index].isDone = true;
+            while (countedIndex < endIndex && results[countedIndex].isDone) {
+                totalNum += results[countedIndex].num;
+                countedIndex++;
+                if (totalNum >= sysEventQuery.limit_) {
+                    endIndex = countedIndex;
+                }
+            }
+        }
+    };
+
+    // the calling thread also works as one of the workers
+    size_t workerNum = std::min(queryWorkerNum_, files.size());
+    std::vector<ffrt::dependence> workers;
+    for (size_t i = 1; i < workerNum; ++i) {
+        workers.emplace_back(ffrt::submit_h(queryTask, {}, {},
+            ffrt::task_attr().name("dft_event_query").qos(ffrt::qos_default)));
+    }
+    queryTask();
+    ffrt::wait(workers);
+
+    // merge the results of the files not cancelled
+    for (size_t index = 0; index < endIndex; ++index) {
+        if (results[index].ret != DOC_STORE_SUCCESS) {
+            HIVIEW_LOGE("failed to query event from doc, file=%{public}s, res=%{public}d",
+                files[index]->path.c_str(), results[index].ret);
+            continue;
+        }
+        auto& fileEntries = results[index].entries;
+        while (!fileEntries.empty()) {
+            entries.emplace(fileEntries.top());
+            fileEntries.pop();
+        }
+    }
+    if (totalNum >= sysEventQuery.limit_) {
+        sysEventQuery.queryArg_.toSeq = files[endIndex - 1]->seq;
+    }
+    HIVIEW_LOGD("parallel query end, limit=%{public}d, totalNum=%{public}d, files=%{public}zu/%{public}zu",
+        sysEventQuery.limit_, totalNum, static_cast<size_t>(endIndex), files.size());
+    return DOC_STORE_SUCCESS;
+}
 } // EventStore
 } // HiviewDFX
 } // OHOS
@@ -36,7 +36,9 @@ const char FILE_EXT[] = ".db";
 
 SysEventDoc::SysEventDoc(const std::string& domain, const std::string& name)
     : writer_(nullptr), reader_(nullptr), domain_(domain), name_(name), type_(0)
-{}
+{
+    isGroupCommit_ = EventStoreConfig::GetInstance().IsGroupCommitEnabled();
+}
 
 SysEventDoc::SysEventDoc(const std::string& file) : writer_(nullptr), reader_(nullptr), type_(0), curFile_(file)
 {}
@@ -61,17 +63,30 @@ int SysEventDoc::Insert(const std::shared_ptr<SysEvent>& sysEvent)
     // write event to the file
     if (ret = writer_->Write(sysEvent); ret == DOC_STORE_NEW_FILE) {
         // need to store to a new file
+        if (ret = ReleaseWriter(); ret != DOC_STORE_SUCCESS) {
+            return ret;
+        }
         if (ret = CreateCurFile(GetDir(), sysEvent); ret != DOC_STORE_SUCCESS) {
             HIVIEW_LOGE("failed to update curFile=%{public}s", curFile_.c_str());
             return ret;
         }
-        writer_ = std::make_shared<SysEventDocWriter>(curFile_);
+        writer_ = std::make_shared<SysEventDocWriter>(curFile_, isGroupCommit_);
         HIVIEW_LOGD("update writer in new File=%{public}s", curFile_.c_str());
         return writer_->Write(sysEvent);
     }
     return ret;
 }
 
+int SysEventDoc::Commit()
+{
+    return writer_ == nullptr ? DOC_STORE_SUCCESS : writer_->Commit();
+}
+
+size_t SysEventDoc::GetPendingSize()
+{
+    return writer_ == nullptr ? 0 : writer_->GetPendingSize();
+}
+
 int SysEventDoc::Query(const DocQuery& query, EntryQueue& entries, int& num)
 {
     auto ret = DOC_STORE_SUCCESS;
@@ -86,18 +101,36 @@ int SysEventDoc::Query(const DocQuery& query, EntryQueue& entries, int& num)
 int SysEventDoc::InitWriter(const std::shared_ptr<SysEvent>& sysEvent)
 {
     if (writer_ == nullptr || IsNeedUpdateCurFile()) {
+        if (auto ret = ReleaseWriter(); ret != DOC_STORE_SUCCESS) {
+            return ret;
+        }
         type_ = sysEvent->eventType_;
         level_ = sysEvent->GetLevel();
         if (auto ret = UpdateCurFile(sysEvent); ret != 0) {
             HIVIEW_LOGE("failed to update current file");
             return ret;
         }
-        writer_ = std::make_shared<SysEventDocWriter>(curFile_);
+        writer_ = std::make_shared<SysEventDocWriter>(curFile_, isGroupCommit_);
         HIVIEW_LOGD("init writer in curFile=%{public}s", curFile_.c_str());
     }
     return DOC_STORE_SUCCESS;
 }
 
+int SysEventDoc::ReleaseWriter()
+{
+    if (writer_ == nullptr) {
+        return DOC_STORE_SUCCESS;
+    }
+
+    // write the pending data before a new file is added, so the catalog records the final size of the old file
+    if (auto ret = writer_->Commit(); ret != DOC_STORE_SUCCESS) {
+        HIVIEW_LOGE("failed to commit file=%{public}s before switching file", curFile_.c_str());
+        return ret;
+    }
+    writer_ = nullptr;
+    return DOC_STORE_SUCCESS;
+}
+
 int SysEventDoc::InitReader()
 {
     if (curFile_.empty() || !FileUtil::FileExists(curFile_)) {
@@ -115,7 +148,8 @@ bool SysEventDoc::IsFileFull(const std::string& file)
 
 bool SysEventDoc::IsNeedUpdateCurFile()
 {
-    return curFile_.empty() || IsFileFull(curFile_);
+    // the data pending for group commit also counts
+    return curFile_.empty() || (FileUtil::GetFileSize(curFile_) + GetPendingSize()) >= GetMaxFileSize();
 }
 
 int SysEventDoc::UpdateCurFile(const std::shared_ptr<SysEvent>& sysEvent)
@@ -144,18 +178,8 @@ std::string SysEventDoc::GetDir()
 
 std::string SysEventDoc::GetCurFile(const std::string& dir)
 {
-    std::vector<std::string> files;
-    FileUtil::GetDirFiles(dir, files);
-    std::string curFile;
-    for (auto& file : files) {
-        if (file.find(FILE_SEPARATOR + name_ + FILE_NAME_SEPARATOR) == std::string::npos) {
-            continue;
-        }
-        if ((file.size() == curFile.size() && file > curFile) || file.size() > curFile.size()) {
-            curFile = file;
-        }
-    }
-    return curFile;
+    // the catalog keeps the files of the dir, no need to scan the dir for each new doc
+    return SysEventDatabase::GetInstance().GetDocCatalog().GetLatestFile(domain_, name_);
 }
 
 uint32_t SysEventDoc::GetMaxFileSize()
@@ -173,6 +197,7 @@ int SysEventDoc::CreateCurFile(const std::string& dir, const std::shared_ptr<Sys
         HIVIEW_LOGE("failed to create file=%{public}s, errno=%{public}d", filePath.c_str(), errno);
         return DOC_STORE_ERROR_IO;
     }
+    SysEventDatabase::GetInstance().GetDocCatalog().AddFile(filePath);
     curFile_ = filePath;
     return DOC_STORE_SUCCESS;
 }
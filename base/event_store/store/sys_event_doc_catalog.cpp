@@ -0,0 +1,199 @@
+/*
+ * Copyright (c) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "sys_event_doc_catalog.h"
+
+#include <algorithm>
+#include <cstdlib>
+
+#include "base_def.h"
+#include "file_util.h"
+#include "hiview_logger.h"
+#include "string_util.h"
+#include "sys_event_database.h"
+
+namespace OHOS {
+namespace HiviewDFX {
+namespace EventStore {
+DEFINE_LOG_TAG("HiView-SysEventDocCatalog");
+namespace {
+const char FILE_SEPARATOR = '/';
+const char FILE_NAME_SEPARATOR[] = "-";
+}
+
+bool SysEventDocCatalog::ParseFilePath(const std::string& path, DocFileInfo& info)
+{
+    size_t namePos = path.rfind(FILE_SEPARATOR);
+    if (namePos == std::string::npos || namePos == 0) {
+        return false;
+    }
+    size_t domainPos = path.rfind(FILE_SEPARATOR, namePos - 1);
+    domainPos = (domainPos == std::string::npos) ? 0 : (domainPos + 1); // 1 for skipping '/'
+    std::vector<std::string> splitStrs;
+    StringUtil::SplitStr(path.substr(namePos + 1), FILE_NAME_SEPARATOR, splitStrs); // 1 for skipping '/'
+    if (splitStrs.size() != FILE_NAME_SPLIT_SIZE) {
+        return false;
+    }
+    info.path = path;
+    info.domain = path.substr(domainPos, namePos - domainPos);
+    info.name = splitStrs[EVENT_NAME_INDEX];
+    info.type = std::strtol(splitStrs[EVENT_TYPE_INDEX].c_str(), nullptr, 0);
+    info.level = splitStrs[EVENT_LEVEL_INDEX];
+    info.seq = std::strtoll(splitStrs[EVENT_SEQ_INDEX].c_str(), nullptr, 0);
+    return true;
+}
+
+void SysEventDocCatalog::Reset()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    catalog_.clear();
+    isLoaded_ = false;
+}
+
+void SysEventDocCatalog::LoadIfNeed()
+{
+    if (isLoaded_) {
+        return;
+    }
+    std::string dbDir = SysEventDatabase::GetInstance().GetDatabaseDir();
+    if (dbDir.empty()) {
+        return;
+    }
+    std::vector<std::string> domainDirs;
+    FileUtil::GetDirDirs(dbDir, domainDirs);
+    size_t fileCnt = 0;
+    for (const auto& domainDir : domainDirs) {
+        std::vector<std::string> files;
+        FileUtil::GetDirFiles(domainDir, files, false);
+        for (const auto& file : files) {
+            AddFileLocked(file, true);
+        }
+        fileCnt += files.size();
+    }
+    isLoaded_ = true;
+    HIVIEW_LOGI("load catalog, domains=%{public}zu, files=%{public}zu", domainDirs.size(), fileCnt);
+}
+
+void SysEventDocCatalog::AddFileLocked(const std::string& path, bool needSize)
+{
+    auto info = std::make_shared<DocFileInfo>();
+    if (!ParseFilePath(path, *info)) {
+        HIVIEW_LOGW("invalid doc file=%{public}s", path.c_str());
+        return;
+    }
+    if (needSize) {
+        info->size = FileUtil::GetFileSize(path);
+    }
+    auto& seqFiles = catalog_[info->domain][info->name];
+    if (!needSize && !seqFiles.empty() && seqFiles.rbegin()->first < info->seq) {
+        // the file rotated out is not written any more, take its final size once
+        auto& outgoingFile = seqFiles.rbegin()->second;
+        outgoingFile->size = FileUtil::GetFileSize(outgoingFile->path);
+    }
+    seqFiles[info->seq] = info;
+}
+
+void SysEventDocCatalog::AddFile(const std::string& path)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!isLoaded_) {
+        // the new file will be found by the scan of loading
+        return;
+    }
+    AddFileLocked(path, false);
+}
+
+void SysEventDocCatalog::RemoveFile(const std::string& path)
+{
+    DocFileInfo info;
+    if (!ParseFilePath(path, info)) {
+        return;
+    }
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto domainIter = catalog_.find(info.domain);
+    if (domainIter == catalog_.end()) {
+        return;
+    }
+    auto nameIter = domainIter->second.find(info.name);
+    if (nameIter == domainIter->second.end()) {
+        return;
+    }
+    nameIter->second.erase(info.seq);
+    if (nameIter->second.empty()) {
+        domainIter->second.erase(nameIter);
+    }
+    if (domainIter->second.empty()) {
+        catalog_.erase(domainIter);
+    }
+}
+
+void SysEventDocCatalog::RefreshSize()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    LoadIfNeed();
+
+    // only the latest file of each event is still being written, the others never change
+    for (auto& domainFiles : catalog_) {
+        for (auto& nameFiles : domainFiles.second) {
+            if (nameFiles.second.empty()) {
+                continue;
+            }
+            auto& latestFile = nameFiles.second.rbegin()->second;
+            latestFile->size = FileUtil::GetFileSize(latestFile->path);
+        }
+    }
+}
+
+void SysEventDocCatalog::GetDomainFiles(const NameFilesMap& nameFiles, std::vector<DocFilePtr>& files)
+{
+    for (const auto& nameFile : nameFiles) {
+        for (const auto& seqFile : nameFile.second) {
+            files.emplace_back(seqFile.second);
+        }
+    }
+}
+
+void SysEventDocCatalog::GetFiles(const std::string& domain, std::vector<DocFilePtr>& files)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    LoadIfNeed();
+    if (domain.empty()) {
+        for (const auto& domainFiles : catalog_) {
+            GetDomainFiles(domainFiles.second, files);
+        }
+        return;
+    }
+    if (auto iter = catalog_.find(domain); iter != catalog_.end()) {
+        GetDomainFiles(iter->second, files);
+    }
+}
+
+std::string SysEventDocCatalog::GetLatestFile(const std::string& domain, const std::string& name)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    LoadIfNeed();
+    auto domainIter = catalog_.find(domain);
+    if (domainIter == catalog_.end()) {
+        return "";
+    }
+    auto nameIter = domainIter->second.find(name);
+    if (nameIter == domainIter->second.end() || nameIter->second.empty()) {
+        return "";
+    }
+    return nameIter->second.rbegin()->second->path;
+}
+} // EventStore
+} // HiviewDFX
+} // OHOS
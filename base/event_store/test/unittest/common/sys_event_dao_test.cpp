@@ -720,5 +720,38 @@ HWTEST_F(SysEventDaoTest, DocQueryTest_01, testing::ext::TestSize.Level0)
     auto sysEvent = std::make_shared<SysEvent>("SysEventSource", nullptr, jsonStr);
     ASSERT_TRUE(docQuery.IsContainExtraConds(sysEvent->rawData_->GetData()));
 }
+
+/**
+ * @tc.name: DocQueryTest_02
+ * @tc.desc: test the extra conditions of DocQuery with missing keys and array values.
+ * @tc.type: FUNC
+ * @tc.require: issueI7NUTO
+ */
+HWTEST_F(SysEventDaoTest, DocQueryTest_02, testing::ext::TestSize.Level0)
+{
+    using namespace EventStore;
+
+    std::string jsonStr = R"~({"domain_":"demo", "name_":"DocQueryTest_02", "type_":1, "tz_":8, "time_":1620271291188,
+        "pid_":6527, "tid_":6527, "ARR_VALUE":[1, 2], "STR_VALUE":"test_event", "INT_VALUE":3})~";
+    auto sysEvent = std::make_shared<SysEvent>("SysEventSource", nullptr, jsonStr);
+    uint8_t* content = sysEvent->rawData_->GetData();
+
+    DocQuery matchedQuery;
+    matchedQuery.And(Cond("STR_VALUE", EQ, "test_event"));
+    matchedQuery.And(Cond("INT_VALUE", GT, 1));
+    ASSERT_TRUE(matchedQuery.IsContainExtraConds(content));
+
+    DocQuery missingKeyQuery;
+    missingKeyQuery.And(Cond("STR_VALUE", EQ, "test_event"));
+    missingKeyQuery.And(Cond("NOT_EXIST_VALUE", EQ, 0));
+    ASSERT_FALSE(missingKeyQuery.IsContainExtraConds(content));
+
+    DocQuery arrayQuery;
+    arrayQuery.And(Cond("ARR_VALUE", EQ, 1));
+    ASSERT_FALSE(arrayQuery.IsContainExtraConds(content));
+
+    // the decode buffers reused by the queries above do not affect the next match
+    ASSERT_TRUE(matchedQuery.IsContainExtraConds(content));
+}
 } // namespace HiviewDFX
 } // namespace OHOS
\ No newline at end of file
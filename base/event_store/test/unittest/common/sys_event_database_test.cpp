@@ -14,6 +14,7 @@
  */
 #include "sys_event_database_test.h"
 
+#include <algorithm>
 #include <chrono>
 #include <ctime>
 #include <iostream>
@@ -23,13 +24,36 @@
 
 #include <gmock/gmock.h>
 #include "event.h"
+#include "file_util.h"
 #include "hiview_global.h"
 #include "sys_event.h"
 #include "sys_event_dao.h"
 #include "sys_event_database.h"
+#include "sys_event_doc.h"
 
 namespace OHOS {
 namespace HiviewDFX {
+namespace {
+const char PARALLEL_TEST_DOMAIN[] = "PARALLEL_TEST";
+
+std::vector<int64_t> QueryEventSeqs(size_t workerNum, int limit, int64_t& toSeq)
+{
+    auto& database = EventStore::SysEventDatabase::GetInstance();
+    database.queryWorkerNum_ = workerNum;
+    EventStore::SysEventQuery query(PARALLEL_TEST_DOMAIN, {});
+    query.limit_ = limit;
+    EventStore::EntryQueue entries(query.CreateCompareFunc());
+    EXPECT_EQ(database.Query(query, entries), 0);
+    toSeq = query.queryArg_.toSeq;
+    std::vector<int64_t> seqs;
+    while (!entries.empty()) {
+        seqs.emplace_back(entries.top().id);
+        entries.pop();
+    }
+    return seqs;
+}
+}
+
 void SysEventDatabaseTest::SetUpTestCase()
 {
 }
@@ -65,5 +89,143 @@ HWTEST_F(SysEventDatabaseTest, EventDatabaseTest_01, testing::ext::TestSize.Leve
     ASSERT_EQ(EventStore::SysEventDatabase::GetInstance().Insert(sysEvent), 0);
     EventStore::SysEventDatabase::GetInstance().Clear();
 }
+
+/**
+ * @tc.name: EventDatabaseTest_02
+ * @tc.desc: test the doc file catalog of SysEventDatabase.
+ * @tc.type: FUNC
+ */
+HWTEST_F(SysEventDatabaseTest, EventDatabaseTest_02, testing::ext::TestSize.Level0)
+{
+    EventStore::DocFileInfo info;
+    ASSERT_TRUE(EventStore::SysEventDocCatalog::ParseFilePath("/data/test/DOMAIN/NAME-4-CRITICAL-100.db", info));
+    ASSERT_EQ(info.domain, "DOMAIN");
+    ASSERT_EQ(info.name, "NAME");
+    ASSERT_EQ(info.type, 4); // 4 means behavior type
+    ASSERT_EQ(info.level, "CRITICAL");
+    ASSERT_EQ(info.seq, 100); // 100 is the seq of file name
+    ASSERT_FALSE(EventStore::SysEventDocCatalog::ParseFilePath("/data/test/DOMAIN/invalid.db", info));
+
+    SysEventCreator sysEventCreator("CATALOG_TEST", "CATALOG_EVENT", SysEventCreator::BEHAVIOR);
+    std::shared_ptr<SysEvent> sysEvent = std::make_shared<SysEvent>("test", nullptr, sysEventCreator);
+    sysEvent->SetLevel("CRITICAL");
+    sysEvent->SetEventSeq(1); // 1 is the test seq
+    ASSERT_EQ(EventStore::SysEventDatabase::GetInstance().Insert(sysEvent), 0);
+    auto& catalog = EventStore::SysEventDatabase::GetInstance().GetDocCatalog();
+    std::string latestFile = catalog.GetLatestFile("CATALOG_TEST", "CATALOG_EVENT");
+    ASSERT_FALSE(latestFile.empty());
+    std::vector<EventStore::DocFilePtr> files;
+    catalog.GetFiles("CATALOG_TEST", files);
+    ASSERT_FALSE(files.empty());
+
+    EventStore::SysEventDatabase::GetInstance().Commit();
+    // the rotated file keeps its final size
+    std::string nextFile = latestFile.substr(0, latestFile.rfind('-') + 1) + "100000.db"; // 100000 is the next seq
+    catalog.AddFile(nextFile);
+    ASSERT_EQ(catalog.GetLatestFile("CATALOG_TEST", "CATALOG_EVENT"), nextFile);
+    files.clear();
+    catalog.GetFiles("CATALOG_TEST", files);
+    auto rotatedFile = std::find_if(files.begin(), files.end(), [&latestFile] (const auto& file) {
+        return file->path == latestFile;
+    });
+    ASSERT_NE(rotatedFile, files.end());
+    ASSERT_GT((*rotatedFile)->size, 0);
+    ASSERT_EQ((*rotatedFile)->size, FileUtil::GetFileSize(latestFile));
+    catalog.RemoveFile(nextFile);
+
+    catalog.RemoveFile(latestFile);
+    ASSERT_TRUE(catalog.GetLatestFile("CATALOG_TEST", "CATALOG_EVENT").empty());
+    catalog.Reset();
+    ASSERT_EQ(catalog.GetLatestFile("CATALOG_TEST", "CATALOG_EVENT"), latestFile);
+}
+
+/**
+ * @tc.name: EventDatabaseTest_03
+ * @tc.desc: test the parallel query of SysEventDatabase against the serial one.
+ * @tc.type: FUNC
+ */
+HWTEST_F(SysEventDatabaseTest, EventDatabaseTest_03, testing::ext::TestSize.Level0)
+{
+    constexpr int fileNum = 4; // 4 events, one doc file for each
+    constexpr int eventNumPerFile = 5; // 5 events in each doc file
+    constexpr int64_t firstSeq = 2000; // 2000 is the first test seq
+    for (int i = 0; i < fileNum; ++i) {
+        for (int j = 0; j < eventNumPerFile; ++j) {
+            SysEventCreator sysEventCreator(PARALLEL_TEST_DOMAIN, "PARALLEL_EVENT_" + std::to_string(i),
+                SysEventCreator::BEHAVIOR);
+            auto sysEvent = std::make_shared<SysEvent>("test", nullptr, sysEventCreator);
+            sysEvent->SetLevel("CRITICAL");
+            sysEvent->SetEventSeq(firstSeq + i * eventNumPerFile + j);
+            ASSERT_EQ(EventStore::SysEventDatabase::GetInstance().Insert(sysEvent), 0);
+        }
+    }
+    auto& database = EventStore::SysEventDatabase::GetInstance();
+    size_t configuredWorkerNum = database.queryWorkerNum_;
+    constexpr size_t workerNum = 4; // 4 workers, one for each file
+
+    // no limit is reached, the events of all files are returned in the same order
+    constexpr int noLimit = 10000; // 10000 is more than the events of the test domain
+    int64_t serialToSeq = 0;
+    int64_t parallelToSeq = 0;
+    auto allSeqs = QueryEventSeqs(0, noLimit, serialToSeq);
+    ASSERT_GE(allSeqs.size(), fileNum * eventNumPerFile);
+    auto parallelSeqs = QueryEventSeqs(workerNum, noLimit, parallelToSeq);
+    ASSERT_EQ(parallelSeqs, allSeqs);
+    ASSERT_EQ(parallelToSeq, serialToSeq);
+
+    // the limit is reached before the oldest files, which are cancelled
+    auto serialSeqs = QueryEventSeqs(0, eventNumPerFile + 1, serialToSeq);
+    ASSERT_LT(serialSeqs.size(), allSeqs.size());
+    for (int i = 0; i < 10; ++i) { // 10 rounds to vary the scheduling of the workers
+        parallelSeqs = QueryEventSeqs(workerNum, eventNumPerFile + 1, parallelToSeq);
+        ASSERT_EQ(parallelSeqs, serialSeqs);
+        ASSERT_EQ(parallelToSeq, serialToSeq);
+    }
+    database.queryWorkerNum_ = configuredWorkerNum;
+}
+
+/**
+ * @tc.name: EventDatabaseTest_04
+ * @tc.desc: test the catalog size of the doc file rotated with group commit.
+ * @tc.type: FUNC
+ */
+HWTEST_F(SysEventDatabaseTest, EventDatabaseTest_04, testing::ext::TestSize.Level0)
+{
+    EventStore::SysEventDoc doc("ROTATE_TEST", "ROTATE_EVENT");
+    doc.isGroupCommit_ = true;
+    SysEventCreator smallCreator("ROTATE_TEST", "ROTATE_EVENT", SysEventCreator::FAULT);
+    smallCreator.SetKeyValue("KEY", "VALUE");
+    auto smallEvent = std::make_shared<SysEvent>("test", nullptr, smallCreator);
+    smallEvent->SetLevel("CRITICAL");
+    smallEvent->SetEventSeq(3000); // 3000 is the seq of the first file
+    ASSERT_EQ(doc.Insert(smallEvent), 0);
+    ASSERT_GT(doc.GetPendingSize(), 0);
+    std::string oldFile = doc.curFile_;
+
+    // the event larger than the page of fault event goes to a new file
+    constexpr size_t largeValueSize = 8 * 1024; // 8KB is larger than the 4KB page
+    SysEventCreator largeCreator("ROTATE_TEST", "ROTATE_EVENT", SysEventCreator::FAULT);
+    largeCreator.SetKeyValue("KEY", std::string(largeValueSize, 'a'));
+    auto largeEvent = std::make_shared<SysEvent>("test", nullptr, largeCreator);
+    largeEvent->SetLevel("CRITICAL");
+    largeEvent->SetEventSeq(3001); // 3001 is the seq of the second file
+    ASSERT_EQ(doc.Insert(largeEvent), 0);
+    ASSERT_NE(doc.curFile_, oldFile);
+    ASSERT_EQ(doc.Commit(), 0);
+
+    auto& catalog = EventStore::SysEventDatabase::GetInstance().GetDocCatalog();
+    std::vector<EventStore::DocFilePtr> files;
+    catalog.GetFiles("ROTATE_TEST", files);
+    auto rotatedFile = std::find_if(files.begin(), files.end(), [&oldFile] (const auto& file) {
+        return file->path == oldFile;
+    });
+    ASSERT_NE(rotatedFile, files.end());
+    ASSERT_GT((*rotatedFile)->size, 0);
+    ASSERT_EQ((*rotatedFile)->size, FileUtil::GetFileSize(oldFile));
+    catalog.RemoveFile(doc.curFile_);
+    catalog.RemoveFile(oldFile);
+    (void)FileUtil::RemoveFile(doc.curFile_);
+    (void)FileUtil::RemoveFile(oldFile);
+}
 } // namespace HiviewDFX
 } // namespace OHOS
\ No newline at end of file
@@ -23,8 +23,11 @@
 #include "content_reader_version_1.h"
 #include "content_reader_version_2.h"
 #include "content_reader_version_3.h"
+#include "doc_page_index_cache.h"
 #include "hiview_logger.h"
+#include "file_util.h"
 #include "sys_event_doc_reader.h"
+#include "sys_event_doc_writer.h"
 
 namespace OHOS {
 namespace HiviewDFX {
@@ -37,6 +40,8 @@ constexpr int32_t TEST_EVENT_TYPE = 4;
 const std::string TEST_DB_VERSION1_FILE = "/data/test/TEST_DOMAIN/TEST_VERSION1-1-CRITICAL-1.db";
 const std::string TEST_DB_VERSION2_FILE = "/data/test/TEST_DOMAIN/TEST_VERSION2-1-CRITICAL-1.db";
 const std::string TEST_DB_VERSION3_FILE = "/data/test/TEST_DOMAIN/TEST_VERSION3-1-CRITICAL-1.db";
+const std::string TEST_DB_GROUP_COMMIT_FILE = "/data/test/TEST_DOMAIN/TEST_GROUP_COMMIT-2-CRITICAL-1.db";
+const std::string TEST_DB_PAGE_INDEX_FILE = "/data/test/TEST_DOMAIN/TEST_PAGE_INDEX-2-CRITICAL-0.db";
 class ContentReaderVersionTest : public ContentReader {
 public:
     int ReadDocDetails(std::ifstream& docStream, EventStore::DocHeader& header,
@@ -284,5 +289,119 @@ HWTEST_F(SysEventStoreUtilityTest, SysEventStoreUtilityTest004, testing::ext::Te
         TestEventsOfDocReader(dbPath);
     }
 }
+
+/**
+ * @tc.name: SysEventStoreUtilityTest005
+ * @tc.desc: SysEventDocWriter group commit test
+ * @tc.type: FUNC
+ * @tc.require: issueI9DJP3
+ */
+HWTEST_F(SysEventStoreUtilityTest, SysEventStoreUtilityTest005, testing::ext::TestSize.Level3)
+{
+    (void)FileUtil::RemoveFile(TEST_DB_GROUP_COMMIT_FILE);
+    ASSERT_EQ(FileUtil::CreateFile(TEST_DB_GROUP_COMMIT_FILE, FileUtil::FILE_PERM_660), 0);
+    SysEventCreator sysEventCreator("TEST_DOMAIN", "TEST_GROUP_COMMIT", SysEventCreator::STATISTIC);
+    sysEventCreator.SetKeyValue("KEY", "VALUE");
+    auto sysEvent = std::make_shared<SysEvent>("test", nullptr, sysEventCreator);
+    sysEvent->SetLevel("CRITICAL");
+    sysEvent->SetEventSeq(1);
+    {
+        SysEventDocWriter writer(TEST_DB_GROUP_COMMIT_FILE, true);
+        ASSERT_EQ(writer.Write(sysEvent), DOC_STORE_SUCCESS);
+        ASSERT_EQ(writer.Write(sysEvent), DOC_STORE_SUCCESS);
+        ASSERT_GT(writer.GetPendingSize(), 0);
+        ASSERT_EQ(FileUtil::GetFileSize(TEST_DB_GROUP_COMMIT_FILE), 0);
+        ASSERT_EQ(writer.Commit(), DOC_STORE_SUCCESS);
+        ASSERT_EQ(writer.GetPendingSize(), 0);
+        ASSERT_GT(FileUtil::GetFileSize(TEST_DB_GROUP_COMMIT_FILE), 0);
+
+        // the pending data is committed when the writer is destroyed
+        ASSERT_EQ(writer.Write(sysEvent), DOC_STORE_SUCCESS);
+    }
+    SysEventDocReader reader(TEST_DB_GROUP_COMMIT_FILE);
+    DocQuery query;
+    EntryQueue entries(CompareSeqFuncGreater);
+    int num = 0;
+    ASSERT_EQ(reader.Read(query, entries, num), DOC_STORE_SUCCESS);
+    ASSERT_EQ(num, 3); // 3: count of written events
+    (void)FileUtil::RemoveFile(TEST_DB_GROUP_COMMIT_FILE);
+}
+
+/**
+ * @tc.name: SysEventStoreUtilityTest006
+ * @tc.desc: SysEventDocReader page index test
+ * @tc.type: FUNC
+ * @tc.require: issueI9DJP3
+ */
+HWTEST_F(SysEventStoreUtilityTest, SysEventStoreUtilityTest006, testing::ext::TestSize.Level3)
+{
+    (void)FileUtil::RemoveFile(TEST_DB_PAGE_INDEX_FILE);
+    ASSERT_EQ(FileUtil::CreateFile(TEST_DB_PAGE_INDEX_FILE, FileUtil::FILE_PERM_660), 0);
+    DocPageIndexCache::GetInstance().Clear();
+    constexpr int64_t eventNum = 40;
+    constexpr size_t valueSize = 2048; // 40 events of 2KB fill several pages
+    {
+        SysEventDocWriter writer(TEST_DB_PAGE_INDEX_FILE);
+        for (int64_t seq = 0; seq < eventNum; ++seq) {
+            SysEventCreator sysEventCreator("TEST_DOMAIN", "TEST_PAGE_INDEX", SysEventCreator::STATISTIC);
+            sysEventCreator.SetKeyValue("KEY", std::string(valueSize, 'a'));
+            auto sysEvent = std::make_shared<SysEvent>("test", nullptr, sysEventCreator);
+            sysEvent->SetLevel("CRITICAL");
+            sysEvent->SetEventSeq(seq);
+            ASSERT_EQ(writer.Write(sysEvent), DOC_STORE_SUCCESS);
+        }
+    }
+
+    // the first query builds the page index, and the second one skips the pages by the index
+    constexpr int64_t fromSeq = 35;
+    for (int i = 0; i < 2; ++i) { // 2: query twice
+        SysEventDocReader reader(TEST_DB_PAGE_INDEX_FILE);
+        DocQuery query;
+        query.And(Cond(EventCol::SEQ, Op::GE, fromSeq));
+        EntryQueue entries(CompareSeqFuncGreater);
+        int num = 0;
+        ASSERT_EQ(reader.Read(query, entries, num), DOC_STORE_SUCCESS);
+        ASSERT_EQ(num, eventNum - fromSeq);
+        ASSERT_EQ(entries.top().id, fromSeq);
+    }
+
+    SysEventDocReader reader(TEST_DB_PAGE_INDEX_FILE);
+    DocQuery query;
+    EntryQueue entries(CompareSeqFuncGreater);
+    int num = 0;
+    ASSERT_EQ(reader.Read(query, entries, num), DOC_STORE_SUCCESS);
+    ASSERT_EQ(num, eventNum);
+    (void)FileUtil::RemoveFile(TEST_DB_PAGE_INDEX_FILE);
+}
+
+/**
+ * @tc.name: SysEventStoreUtilityTest007
+ * @tc.desc: SysEventDocWriter write failure test
+ * @tc.type: FUNC
+ * @tc.require: issueI9DJP3
+ */
+HWTEST_F(SysEventStoreUtilityTest, SysEventStoreUtilityTest007, testing::ext::TestSize.Level3)
+{
+    SysEventCreator sysEventCreator("TEST_DOMAIN", "TEST_WRITE_FAILURE", SysEventCreator::STATISTIC);
+    sysEventCreator.SetKeyValue("KEY", "VALUE");
+    auto sysEvent = std::make_shared<SysEvent>("test", nullptr, sysEventCreator);
+    sysEvent->SetLevel("CRITICAL");
+    sysEvent->SetEventSeq(1);
+
+    // every write to the device fails with no space left
+    const std::string fullFile = "/dev/full";
+    SysEventDocWriter groupWriter(fullFile, true);
+    ASSERT_EQ(groupWriter.Write(sysEvent), DOC_STORE_SUCCESS);
+    size_t pendingSize = groupWriter.GetPendingSize();
+    ASSERT_GT(pendingSize, 0);
+    ASSERT_EQ(groupWriter.Commit(), DOC_STORE_ERROR_IO);
+    ASSERT_EQ(groupWriter.GetPendingSize(), pendingSize);
+    ASSERT_EQ(groupWriter.Commit(), DOC_STORE_ERROR_IO);
+    ASSERT_EQ(groupWriter.GetPendingSize(), pendingSize);
+
+    SysEventDocWriter writer(fullFile);
+    ASSERT_EQ(writer.Write(sysEvent), DOC_STORE_ERROR_IO);
+    ASSERT_EQ(writer.GetPendingSize(), 0);
+}
 } // namespace HiviewDFX
 } // namespace OHOS
\ No newline at end of file
@@ -0,0 +1,74 @@
+/*
+ * Copyright (c) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "doc_page_index_cache.h"
+
+namespace OHOS {
+namespace HiviewDFX {
+namespace EventStore {
+namespace {
+constexpr size_t MAX_CACHE_DOC_NUM = 512;
+}
+
+bool DocPageIndexCache::Get(const std::string& path, uint64_t fileIno, uint32_t pageSize,
+    std::vector<DocPageIndex>& pageIndexes)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto iter = indexMap_.find(path);
+    if (iter == indexMap_.end()) {
+        return false;
+    }
+    if (iter->second.fileIno != fileIno || iter->second.pageSize != pageSize) {
+        // the doc is replaced by another file with the same name
+        lruList_.erase(iter->second.lruIter);
+        indexMap_.erase(iter);
+        return false;
+    }
+    lruList_.splice(lruList_.begin(), lruList_, iter->second.lruIter);
+    pageIndexes = iter->second.pageIndexes;
+    return true;
+}
+
+void DocPageIndexCache::Update(const std::string& path, uint64_t fileIno, uint32_t pageSize,
+    const std::vector<DocPageIndex>& pageIndexes)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (auto iter = indexMap_.find(path); iter != indexMap_.end()) {
+        lruList_.splice(lruList_.begin(), lruList_, iter->second.lruIter);
+        iter->second.fileIno = fileIno;
+        iter->second.pageSize = pageSize;
+        iter->second.pageIndexes = pageIndexes;
+        return;
+    }
+    if (indexMap_.size() >= MAX_CACHE_DOC_NUM) {
+        indexMap_.erase(lruList_.back());
+        lruList_.pop_back();
+    }
+    lruList_.push_front(path);
+    IndexEntry& entry = indexMap_[path];
+    entry.fileIno = fileIno;
+    entry.pageSize = pageSize;
+    entry.pageIndexes = pageIndexes;
+    entry.lruIter = lruList_.begin();
+}
+
+void DocPageIndexCache::Clear()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    lruList_.clear();
+    indexMap_.clear();
+}
+} // EventStore
+} // HiviewDFX
+} // OHOS
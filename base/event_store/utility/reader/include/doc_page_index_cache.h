@@ -0,0 +1,58 @@
+/*
+ * Copyright (c) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef HIVIEW_BASE_EVENT_STORE_UTILITY_DOC_PAGE_INDEX_CACHE_H
+#define HIVIEW_BASE_EVENT_STORE_UTILITY_DOC_PAGE_INDEX_CACHE_H
+
+#include <list>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "base_def.h"
+#include "singleton.h"
+
+namespace OHOS {
+namespace HiviewDFX {
+namespace EventStore {
+/*
+ * Cache of the seq and timestamp ranges of the pages of event docs. The pages except the last
+ * one of a doc are never changed once the doc is appended to the next page, so the index built
+ * by one query can be used to skip the pages out of range by the following queries.
+ */
+class DocPageIndexCache : public OHOS::DelayedRefSingleton<DocPageIndexCache> {
+public:
+    bool Get(const std::string& path, uint64_t fileIno, uint32_t pageSize, std::vector<DocPageIndex>& pageIndexes);
+    void Update(const std::string& path, uint64_t fileIno, uint32_t pageSize,
+        const std::vector<DocPageIndex>& pageIndexes);
+    void Clear();
+
+private:
+    struct IndexEntry {
+        uint64_t fileIno = 0;
+        uint32_t pageSize = 0;
+        std::vector<DocPageIndex> pageIndexes;
+        std::list<std::string>::iterator lruIter;
+    };
+
+    std::list<std::string> lruList_;
+    std::unordered_map<std::string, IndexEntry> indexMap_;
+    std::mutex mutex_;
+}; // DocPageIndexCache
+} // EventStore
+} // HiviewDFX
+} // OHOS
+#endif // HIVIEW_BASE_EVENT_STORE_UTILITY_DOC_PAGE_INDEX_CACHE_H
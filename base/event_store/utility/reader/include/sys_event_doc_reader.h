@@ -19,6 +19,7 @@
 #include <fstream>
 #include <functional>
 #include <string>
+#include <vector>
 
 #include "content_reader_factory.h"
 #include "event_doc_reader.h"
@@ -26,7 +27,9 @@
 namespace OHOS {
 namespace HiviewDFX {
 namespace EventStore {
+// the content is owned by the reader and only valid during the callback
 using ReadCallback = std::function<bool(uint8_t* content, uint32_t& contentSize)>;
+using PageFilter = std::function<bool(const DocPageIndex& pageIndex)>;
 class SysEventDocReader : public EventDocReader {
 public:
     SysEventDocReader(const std::string& path);
@@ -40,9 +43,15 @@ public:
 private:
     void Init(const std::string& path);
     void InitEventInfo(const std::string& path);
-    int Read(ReadCallback callback);
+    int Read(ReadCallback callback, PageFilter filter = nullptr);
     int ReadContent(uint8_t** content, uint32_t& contentSize, uint32_t pageIndex);
-    int ReadPages(ReadCallback callback);
+    int ReadPages(ReadCallback callback, PageFilter filter);
+    void MapFile();
+    void UnmapFile();
+    uint64_t GetReadPos();
+    bool IsPageIndexEnabled();
+    void GetPageIndexes(std::vector<DocPageIndex>& pageIndexes);
+    void UpdatePageIndex(DocPageIndex& pageIndex, uint8_t* content);
     bool HasReadFileEnd();
     bool HasReadPageEnd(uint32_t pageIndex);
     bool IsValidHeader(const DocHeader& header);
@@ -55,6 +64,13 @@ private:
 private:
     std::ifstream in_;
     int fileSize_ = 0;
+    uint64_t fileIno_ = 0;
+
+    // the doc is read from the memory mapping if it is mapped, otherwise from the file stream
+    uint8_t* mapAddr_ = nullptr;
+    uint64_t mapSize_ = 0;
+    uint64_t mapPos_ = 0;
+    std::vector<uint8_t> contentBuf_;
     uint32_t pageSize_ = 0;
     uint8_t dataFmtVersion_ = 0;
     uint64_t docHeaderSize_ = 0;
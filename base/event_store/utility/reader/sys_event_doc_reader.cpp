@@ -14,8 +14,15 @@
  */
 #include "sys_event_doc_reader.h"
 
+#include <algorithm>
+#include <cerrno>
 #include <cinttypes>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
 
+#include "doc_page_index_cache.h"
 #include "hiview_logger.h"
 #include "securec.h"
 #include "string_util.h"
@@ -48,6 +55,7 @@ SysEventDocReader::SysEventDocReader(const std::string& path): EventDocReader(pa
 
 SysEventDocReader::~SysEventDocReader()
 {
+    UnmapFile();
     if (in_.is_open()) {
         in_.close();
     }
@@ -68,6 +76,11 @@ void SysEventDocReader::Init(const std::string& path)
         in_.seekg(curPos, std::ios::beg);
 
         dataFmtVersion_ = ContentReader::ReadFmtVersion(in_);
+
+        struct stat fileStat;
+        if (stat(path.c_str(), &fileStat) == 0) {
+            fileIno_ = static_cast<uint64_t>(fileStat.st_ino);
+        }
     }
 }
 
@@ -115,10 +128,13 @@ int SysEventDocReader::Read(const DocQuery& query, EntryQueue& entries, int& num
         TryToAddEntry(content, contentSize, query, entries, num);
         return true;
     };
-    return Read(saveFunc);
+    auto pageFilter = [&query](const DocPageIndex& pageIndex) {
+        return query.IsContainPage(pageIndex);
+    };
+    return Read(saveFunc, pageFilter);
 }
 
-int SysEventDocReader::Read(ReadCallback callback)
+int SysEventDocReader::Read(ReadCallback callback, PageFilter filter)
 {
     // read the header
     DocHeader header;
@@ -139,6 +155,7 @@ int SysEventDocReader::Read(ReadCallback callback)
     pageSize_ = header.pageSize * NUM_OF_BYTES_IN_KB;
 
     // read the events
+    MapFile();
     if (pageSize_ == 0) {
         uint8_t* content = nullptr;
         uint32_t contentSize = 0;
@@ -147,10 +164,56 @@ int SysEventDocReader::Read(ReadCallback callback)
             return ret;
         }
         callback(content, contentSize);
-        delete[] content;
         return DOC_STORE_SUCCESS;
     }
-    return ReadPages(callback);
+    return ReadPages(callback, filter);
+}
+
+void SysEventDocReader::MapFile()
+{
+    if (mapAddr_ != nullptr || !in_.is_open() || fileSize_ <= 0) {
+        return;
+    }
+    auto readPos = in_.tellg();
+    if (static_cast<int>(readPos) < 0) {
+        return;
+    }
+    int fd = open(docPath_.c_str(), O_RDONLY);
+    if (fd < 0) {
+        HIVIEW_LOGD("failed to open file=%{public}s, errno=%{public}d", docPath_.c_str(), errno);
+        return;
+    }
+
+    // the docs are only appended or removed, never truncated, so the mapped range is always valid
+    void* addr = mmap(nullptr, fileSize_, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (addr == MAP_FAILED) {
+        HIVIEW_LOGD("failed to map file=%{public}s, errno=%{public}d", docPath_.c_str(), errno);
+        return;
+    }
+    (void)madvise(addr, fileSize_, MADV_SEQUENTIAL);
+    mapAddr_ = static_cast<uint8_t*>(addr);
+    mapSize_ = static_cast<uint64_t>(fileSize_);
+    mapPos_ = static_cast<uint64_t>(readPos);
+}
+
+void SysEventDocReader::UnmapFile()
+{
+    if (mapAddr_ == nullptr) {
+        return;
+    }
+    munmap(mapAddr_, mapSize_);
+    mapAddr_ = nullptr;
+    mapSize_ = 0;
+    mapPos_ = 0;
+}
+
+uint64_t SysEventDocReader::GetReadPos()
+{
+    if (mapAddr_ != nullptr) {
+        return mapPos_;
+    }
+    return static_cast<uint64_t>(in_.tellg());
 }
 
 int SysEventDocReader::ReadHeader(DocHeader& header)
@@ -170,10 +233,29 @@ int SysEventDocReader::ReadHeader(DocHeader& header, HeadExtraInfo& headExtra)
     return DOC_STORE_SUCCESS;
 }
 
-int SysEventDocReader::ReadPages(ReadCallback callback)
+int SysEventDocReader::ReadPages(ReadCallback callback, PageFilter filter)
 {
+    std::vector<DocPageIndex> pageIndexes;
+    bool isIndexEnabled = IsPageIndexEnabled();
+    if (isIndexEnabled) {
+        GetPageIndexes(pageIndexes);
+    }
+    size_t indexedPageNum = pageIndexes.size();
+
     uint32_t pageIndex = 0;
+    bool isPageBegin = true;
+    DocPageIndex curPageIndex;
     while (!HasReadFileEnd()) {
+        // skip the page out of the range of the query
+        if (isPageBegin && filter != nullptr && pageIndex < pageIndexes.size() && !filter(pageIndexes[pageIndex])) {
+            pageIndex++;
+            if (SeekgPage(pageIndex) != DOC_STORE_SUCCESS) {
+                break;
+            }
+            continue;
+        }
+        isPageBegin = false;
+
         uint8_t* content = nullptr;
         uint32_t contentSize = 0;
         if (ReadContent(&content, contentSize, pageIndex) != DOC_STORE_SUCCESS) {
@@ -184,16 +266,62 @@ int SysEventDocReader::ReadPages(ReadCallback callback)
                 break;
             }
             HIVIEW_LOGD("read the next page index=%{public}" PRIu32 ", file=%{public}s", pageIndex, docPath_.c_str());
+
+            // the previous page is full since the next page exists, it will not be changed any more
+            if (isIndexEnabled && pageIndexes.size() + 1 == pageIndex) {
+                pageIndexes.emplace_back(curPageIndex);
+            }
+            curPageIndex = DocPageIndex();
+            isPageBegin = true;
             continue;
         }
+        if (isIndexEnabled) {
+            UpdatePageIndex(curPageIndex, content);
+        }
         callback(content, contentSize);
-        delete[] content;
+    }
+    if (pageIndexes.size() > indexedPageNum) {
+        DocPageIndexCache::GetInstance().Update(docPath_, fileIno_, pageSize_, pageIndexes);
     }
     return DOC_STORE_SUCCESS;
 }
 
+bool SysEventDocReader::IsPageIndexEnabled()
+{
+    // the seq and timestamp of the events are at the same offset in all known data format versions,
+    // the docs in unknown versions are always fully read
+    return fileIno_ != 0 && pageSize_ != 0 && dataFmtVersion_ >= EVENT_DATA_FORMATE_VERSION::VERSION1 &&
+        dataFmtVersion_ <= EVENT_DATA_FORMATE_VERSION::CURRENT;
+}
+
+void SysEventDocReader::GetPageIndexes(std::vector<DocPageIndex>& pageIndexes)
+{
+    if (!DocPageIndexCache::GetInstance().Get(docPath_, fileIno_, pageSize_, pageIndexes)) {
+        return;
+    }
+
+    // the indexed pages must be followed by another page, otherwise the doc is changed outside
+    if (docHeaderSize_ + static_cast<uint64_t>(pageSize_) * pageIndexes.size() >= static_cast<uint64_t>(fileSize_)) {
+        HIVIEW_LOGW("invalid page index num=%{public}zu, file=%{public}s", pageIndexes.size(), docPath_.c_str());
+        pageIndexes.clear();
+    }
+}
+
+void SysEventDocReader::UpdatePageIndex(DocPageIndex& pageIndex, uint8_t* content)
+{
+    int64_t seq = *(reinterpret_cast<int64_t*>(content + HIVIEW_BLOCK_SIZE));
+    int64_t timestamp = *(reinterpret_cast<int64_t*>(content + HIVIEW_BLOCK_SIZE + SEQ_SIZE));
+    pageIndex.minSeq = std::min(pageIndex.minSeq, seq);
+    pageIndex.maxSeq = std::max(pageIndex.maxSeq, seq);
+    pageIndex.minTs = std::min(pageIndex.minTs, timestamp);
+    pageIndex.maxTs = std::max(pageIndex.maxTs, timestamp);
+}
+
 bool SysEventDocReader::HasReadFileEnd()
 {
+    if (mapAddr_ != nullptr) {
+        return mapPos_ >= mapSize_;
+    }
     if (!in_.is_open()) {
         return true;
     }
@@ -205,7 +333,7 @@ bool SysEventDocReader::HasReadPageEnd(uint32_t pageIndex)
     if (HasReadFileEnd()) {
         return true;
     }
-    uint32_t curPos = static_cast<uint32_t>(in_.tellg());
+    uint32_t curPos = static_cast<uint32_t>(GetReadPos());
     if (curPos <= docHeaderSize_) {
         return false;
     }
@@ -225,7 +353,14 @@ int SysEventDocReader::ReadContent(uint8_t** content, uint32_t& contentSize, uin
         HIVIEW_LOGD("end to read the page, file=%{public}s", docPath_.c_str());
         return DOC_STORE_READ_EMPTY;
     }
-    ReadValueAndReset(in_, contentSize);
+    if (mapAddr_ != nullptr) {
+        if (mapPos_ + sizeof(contentSize) > mapSize_ ||
+            memcpy_s(&contentSize, sizeof(contentSize), mapAddr_ + mapPos_, sizeof(contentSize)) != EOK) {
+            return DOC_STORE_READ_EMPTY;
+        }
+    } else {
+        ReadValueAndReset(in_, contentSize);
+    }
     constexpr uint32_t minContentSize = HIVIEW_BLOCK_SIZE + sizeof(ContentHeader) + CRC_SIZE;
     if (contentSize < minContentSize) {
         HIVIEW_LOGD("invalid content size=%{public}u, file=%{public}s", contentSize, docPath_.c_str());
@@ -235,11 +370,22 @@ int SysEventDocReader::ReadContent(uint8_t** content, uint32_t& contentSize, uin
         HIVIEW_LOGE("invalid content size=%{public}u", contentSize);
         return DOC_STORE_ERROR_MEMORY;
     }
-    *content = new(std::nothrow) uint8_t[contentSize];
-    if (*content == nullptr) {
-        HIVIEW_LOGE("failed to new memory for content, size=%{public}u", contentSize);
-        return DOC_STORE_ERROR_MEMORY;
+    if (mapAddr_ != nullptr) {
+        // hand out the content in the mapping directly, no copy is needed
+        if (mapPos_ + contentSize > mapSize_) {
+            HIVIEW_LOGD("incomplete content size=%{public}u, file=%{public}s", contentSize, docPath_.c_str());
+            return DOC_STORE_READ_EMPTY;
+        }
+        *content = mapAddr_ + mapPos_;
+        mapPos_ += contentSize;
+        return DOC_STORE_SUCCESS;
     }
+
+    // the buffer is reused by the following contents, so the content is only valid before the next read
+    if (contentBuf_.size() < contentSize) {
+        contentBuf_.resize(contentSize);
+    }
+    *content = contentBuf_.data();
     in_.read(reinterpret_cast<char*>(*content), contentSize);
     return DOC_STORE_SUCCESS;
 }
@@ -280,10 +426,18 @@ int SysEventDocReader::SeekgPage(uint32_t pageIndex)
     }
     auto seekSize = docHeaderSize_ + pageSize_ * pageIndex;
     if (static_cast<int>(seekSize) < ReadFileSize()) {
-        in_.seekg(seekSize, std::ios::beg);
+        if (mapAddr_ != nullptr) {
+            mapPos_ = seekSize;
+        } else {
+            in_.seekg(seekSize, std::ios::beg);
+        }
         return DOC_STORE_SUCCESS;
     }
-    in_.setstate(std::ios::eofbit);
+    if (mapAddr_ != nullptr) {
+        mapPos_ = mapSize_;
+    } else {
+        in_.setstate(std::ios::eofbit);
+    }
     return DOC_STORE_ERROR_IO;
 }
 
@@ -30,6 +30,8 @@ public:
     EventDocWriter(const std::string& path): docPath_(path) {}
     virtual ~EventDocWriter() {}
     virtual int Write(const std::shared_ptr<SysEvent>& sysEvent) = 0;
+    virtual int Commit() = 0;
+    virtual size_t GetPendingSize() = 0;
 
 protected:
     std::string docPath_;
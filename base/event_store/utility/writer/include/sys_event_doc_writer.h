@@ -19,6 +19,9 @@
 #include <fstream>
 #include <memory>
 #include <string>
+#include <vector>
+
+#include <sys/types.h>
 
 #include "event_doc_writer.h"
 
@@ -27,20 +30,38 @@ namespace HiviewDFX {
 namespace EventStore {
 class SysEventDocWriter : public EventDocWriter {
 public:
-    SysEventDocWriter(const std::string& path);
+    SysEventDocWriter(const std::string& path, bool isGroupCommit = false);
     ~SysEventDocWriter();
-    int Write(const std::shared_ptr<SysEvent>& sysEvent);
+    int Write(const std::shared_ptr<SysEvent>& sysEvent) override;
+    int Commit() override;
+    size_t GetPendingSize() override;
 
 private:
     int WriteHeader(const std::shared_ptr<SysEvent>& sysEvent, uint32_t contentSize);
     int WriteContent(const std::shared_ptr<SysEvent>& sysEvent, uint32_t contentSize);
-    uint32_t GetCurrPageRemainSize(int fileSize, uint32_t pageSize);
+    uint32_t GetCurrPageRemainSize(uint64_t fileSize, uint32_t pageSize);
     int FillCurrPageWithZero(uint32_t remainSize);
     int GetContentSize(const std::shared_ptr<SysEvent>& sysEvent, uint32_t& contentSize);
+    bool IsDocInfoValid();
+    int LoadDocInfo();
+    void AppendData(const char* data, size_t size);
+    void ReopenAfterFailure();
 
 private:
     std::ofstream out_;
     uint32_t headerSize_ = 0;
+
+    // doc info cached for the lifetime of the open file, reloaded only if the file is changed outside
+    bool isDocInfoLoaded_ = false;
+    bool isDocCompatible_ = false;
+    uint32_t pageSize_ = 0;
+    uint64_t fileSize_ = 0;
+    ino_t fileIno_ = 0;
+
+    // data written but not in the file yet, kept until a commit writes them; without group commit the data are
+    // written to the stream directly and flushed by every write
+    bool isGroupCommit_ = false;
+    std::vector<char> pendingBuf_;
 }; // EventDocWriter
 } // EventStore
 } // HiviewDFX
@@ -14,6 +14,9 @@
  */
 #include "sys_event_doc_writer.h"
 
+#include <cerrno>
+#include <sys/stat.h>
+
 #include "event_store_config.h"
 #include "hiview_logger.h"
 #include "parameter_ex.h"
@@ -26,8 +29,10 @@ namespace EventStore {
 DEFINE_LOG_TAG("HiView-SysEventDocWriter");
 namespace {
 constexpr uint32_t RAW_DATA_OFFSET = HIVIEW_BLOCK_SIZE + MAX_DOMAIN_LEN + MAX_EVENT_NAME_LEN;
+constexpr uint32_t ZERO_FILL_BLOCK_SIZE = 4096;
 }
-SysEventDocWriter::SysEventDocWriter(const std::string& path): EventDocWriter(path)
+SysEventDocWriter::SysEventDocWriter(const std::string& path, bool isGroupCommit)
+    : EventDocWriter(path), isGroupCommit_(isGroupCommit)
 {
     out_.open(path, std::ios::binary | std::ios::app);
 }
@@ -35,6 +40,10 @@ SysEventDocWriter::SysEventDocWriter(const std::string& path): EventDocWriter(pa
 SysEventDocWriter::~SysEventDocWriter()
 {
     if (out_.is_open()) {
+        if (Commit() != DOC_STORE_SUCCESS) {
+            HIVIEW_LOGE("drop %{public}zu bytes not written to file=%{public}s", pendingBuf_.size(),
+                docPath_.c_str());
+        }
         out_.close();
     }
 }
@@ -53,46 +62,35 @@ int SysEventDocWriter::Write(const std::shared_ptr<SysEvent>& sysEvent)
     if (int ret = GetContentSize(sysEvent, contentSize); ret != DOC_STORE_SUCCESS) {
         return ret;
     }
-    SysEventDocReader reader(docPath_);
-    int fileSize = reader.ReadFileSize();
-    if (fileSize < 0) {
-        HIVIEW_LOGE("failed to get the size of file=%{public}s", docPath_.c_str());
-        return DOC_STORE_ERROR_IO;
+    if (!IsDocInfoValid()) {
+        // write the pending data to the old file before reloading, the reload would lose them otherwise
+        if (int ret = Commit(); ret != DOC_STORE_SUCCESS) {
+            return ret;
+        }
+        if (int ret = LoadDocInfo(); ret != DOC_STORE_SUCCESS) {
+            return ret;
+        }
     }
 
     // if file is empty, write header to the file first
-    if (fileSize == 0) {
+    if (fileSize_ == 0) {
         if (auto ret = WriteHeader(sysEvent, contentSize); ret != DOC_STORE_SUCCESS) {
             return ret;
         }
         return WriteContent(sysEvent, contentSize);
     }
-
-    DocHeader header;
-    HeadExtraInfo headExtra;
-    reader.ReadHeader(header, headExtra);
-    headerSize_ = header.blockSize + sizeof(header.magicNum); // for GetCurrPageRemainSize
-    if (header.version != EventStore::EVENT_DATA_FORMATE_VERSION::CURRENT ||
-        headExtra.sysVersion != Parameter::GetSysVersionStr() ||
-        headExtra.patchVersion != Parameter::GetPatchVersionStr()) {
+    if (!isDocCompatible_) {
         return DOC_STORE_NEW_FILE;
     }
 
-    // if file is not empty, read the file header for writing
-    uint32_t pageSize = 0;
-    if (int ret = reader.ReadPageSize(pageSize); ret != DOC_STORE_SUCCESS) {
-        HIVIEW_LOGE("failed to get pageSize from the file=%{public}s", docPath_.c_str());
-        return ret;
-    }
-
     // if the current file is full, need to create a new file
-    if (pageSize == 0 || pageSize < contentSize) {
-        HIVIEW_LOGD("the current page is full, page=%{public}u, content=%{public}u", pageSize, contentSize);
+    if (pageSize_ == 0 || pageSize_ < contentSize) {
+        HIVIEW_LOGD("the current page is full, page=%{public}u, content=%{public}u", pageSize_, contentSize);
         return DOC_STORE_NEW_FILE;
     }
 
     // if the current page is full, need to add zero
-    if (auto remainSize = GetCurrPageRemainSize(fileSize, pageSize); remainSize < contentSize) {
+    if (auto remainSize = GetCurrPageRemainSize(fileSize_, pageSize_); remainSize < contentSize) {
         if (int ret = FillCurrPageWithZero(remainSize); ret != DOC_STORE_SUCCESS) {
             return ret;
         }
@@ -100,9 +98,68 @@ int SysEventDocWriter::Write(const std::shared_ptr<SysEvent>& sysEvent)
     return WriteContent(sysEvent, contentSize);
 }
 
-uint32_t SysEventDocWriter::GetCurrPageRemainSize(int fileSize, uint32_t pageSize)
+bool SysEventDocWriter::IsDocInfoValid()
+{
+    if (!isDocInfoLoaded_) {
+        return false;
+    }
+
+    // the file may be removed, replaced or appended by others, e.g. clear or restore
+    struct stat fileStat;
+    if (stat(docPath_.c_str(), &fileStat) != 0) {
+        return false;
+    }
+    return fileStat.st_ino == fileIno_ && static_cast<uint64_t>(fileStat.st_size) == fileSize_ - pendingBuf_.size();
+}
+
+int SysEventDocWriter::LoadDocInfo()
+{
+    isDocInfoLoaded_ = false;
+    struct stat fileStat;
+    if (stat(docPath_.c_str(), &fileStat) != 0) {
+        HIVIEW_LOGE("failed to stat file=%{public}s, errno=%{public}d", docPath_.c_str(), errno);
+        return DOC_STORE_ERROR_IO;
+    }
+    if (fileIno_ != 0) {
+        HIVIEW_LOGI("file=%{public}s is changed outside, reload it", docPath_.c_str());
+    }
+    if (fileIno_ != 0 && fileStat.st_ino != fileIno_) {
+        out_.close();
+        out_.open(docPath_, std::ios::binary | std::ios::app);
+        if (!out_.is_open()) {
+            HIVIEW_LOGE("failed to reopen file=%{public}s", docPath_.c_str());
+            return DOC_STORE_ERROR_IO;
+        }
+    }
+    fileIno_ = fileStat.st_ino;
+
+    SysEventDocReader reader(docPath_);
+    int fileSize = reader.ReadFileSize();
+    if (fileSize < 0) {
+        HIVIEW_LOGE("failed to get the size of file=%{public}s", docPath_.c_str());
+        return DOC_STORE_ERROR_IO;
+    }
+    fileSize_ = static_cast<uint64_t>(fileSize);
+    if (fileSize_ == 0) {
+        isDocInfoLoaded_ = true;
+        return DOC_STORE_SUCCESS;
+    }
+
+    DocHeader header;
+    HeadExtraInfo headExtra;
+    reader.ReadHeader(header, headExtra);
+    headerSize_ = header.blockSize + sizeof(header.magicNum); // for GetCurrPageRemainSize
+    pageSize_ = header.pageSize * NUM_OF_BYTES_IN_KB;
+    isDocCompatible_ = header.version == EventStore::EVENT_DATA_FORMATE_VERSION::CURRENT &&
+        headExtra.sysVersion == Parameter::GetSysVersionStr() &&
+        headExtra.patchVersion == Parameter::GetPatchVersionStr();
+    isDocInfoLoaded_ = true;
+    return DOC_STORE_SUCCESS;
+}
+
+uint32_t SysEventDocWriter::GetCurrPageRemainSize(uint64_t fileSize, uint32_t pageSize)
 {
-    return (pageSize - ((static_cast<uint32_t>(fileSize) - headerSize_) % pageSize));
+    return (pageSize - ((fileSize - headerSize_) % pageSize));
 }
 
 int SysEventDocWriter::FillCurrPageWithZero(uint32_t remainSize)
@@ -114,13 +171,14 @@ int SysEventDocWriter::FillCurrPageWithZero(uint32_t remainSize)
         HIVIEW_LOGE("invalid new size=%{public}u", remainSize);
         return DOC_STORE_ERROR_MEMORY;
     }
-    uint8_t* fillData = new(std::nothrow) uint8_t[remainSize]{ 0x0 };
-    if (fillData == nullptr) {
-        HIVIEW_LOGE("failed to new memory for fillData, size=%{public}u", remainSize);
-        return DOC_STORE_ERROR_MEMORY;
+    static const char fillData[ZERO_FILL_BLOCK_SIZE] = { 0x0 };
+    uint32_t leftSize = remainSize;
+    while (leftSize > 0) {
+        uint32_t writeSize = leftSize > ZERO_FILL_BLOCK_SIZE ? ZERO_FILL_BLOCK_SIZE : leftSize;
+        AppendData(fillData, writeSize);
+        leftSize -= writeSize;
     }
-    out_.write(reinterpret_cast<char*>(fillData), remainSize);
-    delete[] fillData;
+    fileSize_ += remainSize;
     return DOC_STORE_SUCCESS;
 }
 
@@ -165,46 +223,116 @@ int SysEventDocWriter::WriteHeader(const std::shared_ptr<SysEvent>& sysEvent, ui
         + sizeof(sysVersionSize) + sysVersionSize
         + sizeof(patchVersionSize) + patchVersionSize;
     headerSize_ = header.blockSize + sizeof(header.magicNum);
-    out_.write(reinterpret_cast<char*>(&header), sizeof(DocHeader));
-    out_.write(reinterpret_cast<char*>(&sysVersionSize), sizeof(uint32_t)); // append size of system version string
-    out_.write(sysVersion.c_str(), sysVersionSize); // append system version
-    out_.write(reinterpret_cast<char*>(&patchVersionSize), sizeof(uint32_t)); // append size of patch version string
-    out_.write(patchVersion.c_str(), patchVersionSize); // append patch version
+    pageSize_ = pageSize * NUM_OF_BYTES_IN_KB;
+    isDocCompatible_ = true;
+    AppendData(reinterpret_cast<char*>(&header), sizeof(DocHeader));
+    AppendData(reinterpret_cast<char*>(&sysVersionSize), sizeof(uint32_t)); // append size of system version string
+    AppendData(sysVersion.c_str(), sysVersionSize); // append system version
+    AppendData(reinterpret_cast<char*>(&patchVersionSize), sizeof(uint32_t)); // append size of patch version string
+    AppendData(patchVersion.c_str(), patchVersionSize); // append patch version
+    fileSize_ += headerSize_;
     return DOC_STORE_SUCCESS;
 }
 
 int SysEventDocWriter::WriteContent(const std::shared_ptr<SysEvent>& sysEvent, uint32_t contentSize)
 {
-    // move to the end
-    out_.seekp(0, std::ios::end);
+    uint8_t* rawData = sysEvent->AsRawData();
+    if (rawData == nullptr) {
+        HIVIEW_LOGE("The raw data of event is null");
+        return DOC_STORE_ERROR_NULL;
+    }
 
+    // the file is opened in append mode, so all writes go to the end without seeking
     // content.blockSize
-    out_.write(reinterpret_cast<const char*>(&contentSize), sizeof(contentSize));
+    AppendData(reinterpret_cast<const char*>(&contentSize), sizeof(contentSize));
 
     // content.seq
     const auto eventSeq = sysEvent->GetEventSeq();
-    out_.write(reinterpret_cast<const char*>(&eventSeq), sizeof(eventSeq));
+    AppendData(reinterpret_cast<const char*>(&eventSeq), sizeof(eventSeq));
 
     // content.rawData
-    uint8_t* rawData = sysEvent->AsRawData();
-    if (rawData == nullptr) {
-        HIVIEW_LOGE("The raw data of event is null");
-        return DOC_STORE_ERROR_NULL;
-    }
     uint32_t dataSize = *(reinterpret_cast<uint32_t*>(rawData)) - RAW_DATA_OFFSET;
-    out_.write(reinterpret_cast<const char*>(rawData + RAW_DATA_OFFSET), dataSize);
+    AppendData(reinterpret_cast<const char*>(rawData + RAW_DATA_OFFSET), dataSize);
 
     // content.crc
     const uint32_t crcDefault = 0;
-    out_.write(reinterpret_cast<const char*>(&crcDefault), CRC_SIZE);
+    AppendData(reinterpret_cast<const char*>(&crcDefault), CRC_SIZE);
 
-    // flush the file
-    out_.flush();
+    fileSize_ += contentSize;
+
+    // flush the file immediately unless the write is deferred to a group commit
+    if (!isGroupCommit_) {
+        if (int ret = Commit(); ret != DOC_STORE_SUCCESS) {
+            return ret;
+        }
+    }
 
     HIVIEW_LOGD("write content size=%{public}u, seq=%{public}" PRId64 ", file=%{public}s", contentSize,
         sysEvent->GetEventSeq(), docPath_.c_str());
     return DOC_STORE_SUCCESS;
 }
+
+void SysEventDocWriter::AppendData(const char* data, size_t size)
+{
+    if (!isGroupCommit_) {
+        out_.write(data, size);
+        return;
+    }
+    pendingBuf_.insert(pendingBuf_.end(), data, data + size);
+}
+
+int SysEventDocWriter::Commit()
+{
+    if (!isGroupCommit_) {
+        out_.flush();
+        if (!out_.good()) {
+            HIVIEW_LOGE("failed to write content to file=%{public}s", docPath_.c_str());
+            ReopenAfterFailure();
+            isDocInfoLoaded_ = false; // reload the doc info since the file size is unknown
+            return DOC_STORE_ERROR_IO;
+        }
+        return DOC_STORE_SUCCESS;
+    }
+    if (pendingBuf_.empty()) {
+        return DOC_STORE_SUCCESS;
+    }
+    out_.write(pendingBuf_.data(), pendingBuf_.size());
+    out_.flush();
+    if (out_.good()) {
+        pendingBuf_.clear();
+        return DOC_STORE_SUCCESS;
+    }
+
+    // keep the data not in the file yet, so they are written by the next commit
+    uint64_t committedSize = fileSize_ - pendingBuf_.size();
+    ReopenAfterFailure();
+    struct stat fileStat;
+    if (stat(docPath_.c_str(), &fileStat) == 0 && static_cast<uint64_t>(fileStat.st_size) >= committedSize &&
+        static_cast<uint64_t>(fileStat.st_size) - committedSize <= pendingBuf_.size()) {
+        auto writtenSize = static_cast<std::ptrdiff_t>(static_cast<uint64_t>(fileStat.st_size) - committedSize);
+        pendingBuf_.erase(pendingBuf_.begin(), pendingBuf_.begin() + writtenSize);
+    }
+    HIVIEW_LOGE("failed to write content to file=%{public}s, pending=%{public}zu", docPath_.c_str(),
+        pendingBuf_.size());
+    return DOC_STORE_ERROR_IO;
+}
+
+void SysEventDocWriter::ReopenAfterFailure()
+{
+    // the data left in the buffer of the stream must not be written again behind the retried ones
+    out_.clear();
+    out_.close();
+    out_.clear();
+    out_.open(docPath_, std::ios::binary | std::ios::app);
+    if (!out_.is_open()) {
+        HIVIEW_LOGE("failed to reopen file=%{public}s", docPath_.c_str());
+    }
+}
+
+size_t SysEventDocWriter::GetPendingSize()
+{
+    return pendingBuf_.size();
+}
 } // EventStore
 } // HiviewDFX
 } // OHOS
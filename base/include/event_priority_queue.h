@@ -14,34 +14,198 @@
  */
 #ifndef HIVIEW_BASE_EVENT_PRIORITY_QUEUE_H
 #define HIVIEW_BASE_EVENT_PRIORITY_QUEUE_H
-#include <queue>
+#include <functional>
+#include <unordered_map>
+#include <utility>
+#include <vector>
 namespace OHOS {
 namespace HiviewDFX {
 using Task = std::function<void()>;
+/*
+ * Priority queue of the events ordered by T::operator<, and the events with the same priority are
+ * ordered by the pushing order. The events stay in their slots and only the slot indexes are moved
+ * in the heap, and the seq of each event is indexed to its slot, so removing an event by seq is O(log n).
+ */
 template<typename T>
-class EventPriorityQueue : public std::priority_queue<T, std::vector<T>> {
+class EventPriorityQueue {
 public:
+    bool empty() const
+    {
+        return heap_.empty();
+    }
+
+    size_t size() const
+    {
+        return heap_.size();
+    }
+
+    const T& top() const
+    {
+        return slots_[heap_.front()].event;
+    }
+
+    void push(const T& event)
+    {
+        T copiedEvent = event;
+        push(std::move(copiedEvent));
+    }
+
+    void push(T&& event)
+    {
+        size_t slot = AllocSlot();
+        slots_[slot].event = std::move(event);
+        slots_[slot].order = pushCount_++;
+        slots_[slot].heapIndex = heap_.size();
+        seqIndex_.emplace(slots_[slot].event.seq, slot);
+        heap_.push_back(slot);
+        SiftUp(heap_.size() - 1);
+    }
+
+    void pop()
+    {
+        if (!heap_.empty()) {
+            RemoveAt(0);
+        }
+    }
+
     bool remove(uint64_t seq)
     {
-        auto it = std::find_if(this->c.begin(), this->c.end(), [seq](T event) {
-            return event.seq == seq;
-        });
-        if (it != this->c.end()) {
-            this->c.erase(it);
-            std::make_heap(this->c.begin(), this->c.end(), this->comp);
-            return true;
-        } else {
+        auto it = seqIndex_.find(seq);
+        if (it == seqIndex_.end()) {
             return false;
-        };
+        }
+        RemoveAt(slots_[it->second].heapIndex);
+        return true;
     };
 
     void ShrinkIfNeedLocked()
     {
-        if ((this->c.capacity() / this->c.size()) > 10) {   // 10 times, begin to shrink
-            this->c.shrink_to_fit();
+        if (heap_.empty()) {
+            return;
+        }
+        if ((slots_.size() / heap_.size()) > 10) {   // 10 times, begin to shrink
+            Compact();
         }
     }
+
+private:
+    struct Slot {
+        T event;
+        uint64_t order = 0;
+        size_t heapIndex = 0;
+    };
+
+    bool IsHigher(size_t slotA, size_t slotB) const
+    {
+        const Slot& a = slots_[slotA];
+        const Slot& b = slots_[slotB];
+        if (b.event < a.event) {
+            return true;
+        }
+        if (a.event < b.event) {
+            return false;
+        }
+        return a.order < b.order;
+    }
+
+    void SwapAt(size_t indexA, size_t indexB)
+    {
+        std::swap(heap_[indexA], heap_[indexB]);
+        slots_[heap_[indexA]].heapIndex = indexA;
+        slots_[heap_[indexB]].heapIndex = indexB;
+    }
+
+    bool SiftUp(size_t index)
+    {
+        bool isMoved = false;
+        while (index > 0) {
+            size_t parent = (index - 1) / 2; // 2: binary heap
+            if (!IsHigher(heap_[index], heap_[parent])) {
+                break;
+            }
+            SwapAt(index, parent);
+            index = parent;
+            isMoved = true;
+        }
+        return isMoved;
+    }
+
+    void SiftDown(size_t index)
+    {
+        size_t size = heap_.size();
+        while (true) {
+            size_t left = index * 2 + 1; // 2: binary heap
+            if (left >= size) {
+                break;
+            }
+            size_t highest = left;
+            if (size_t right = left + 1; right < size && IsHigher(heap_[right], heap_[left])) {
+                highest = right;
+            }
+            if (!IsHigher(heap_[highest], heap_[index])) {
+                break;
+            }
+            SwapAt(index, highest);
+            index = highest;
+        }
+    }
+
+    void RemoveAt(size_t index)
+    {
+        size_t slot = heap_[index];
+        auto range = seqIndex_.equal_range(slots_[slot].event.seq);
+        for (auto it = range.first; it != range.second; ++it) {
+            if (it->second == slot) {
+                seqIndex_.erase(it);
+                break;
+            }
+        }
+        size_t lastIndex = heap_.size() - 1;
+        if (index != lastIndex) {
+            SwapAt(index, lastIndex);
+        }
+        heap_.pop_back();
+        if (index < heap_.size() && !SiftUp(index)) {
+            SiftDown(index);
+        }
+        slots_[slot].event = T(); // release the resources held by the event
+        freeSlots_.push_back(slot);
+    }
+
+    size_t AllocSlot()
+    {
+        if (!freeSlots_.empty()) {
+            size_t slot = freeSlots_.back();
+            freeSlots_.pop_back();
+            return slot;
+        }
+        slots_.emplace_back();
+        return slots_.size() - 1;
+    }
+
+    void Compact()
+    {
+        std::vector<Slot> slots;
+        slots.reserve(heap_.size());
+        seqIndex_.clear();
+        for (size_t i = 0; i < heap_.size(); ++i) {
+            slots.emplace_back(std::move(slots_[heap_[i]]));
+            slots.back().heapIndex = i;
+            heap_[i] = i;
+            seqIndex_.emplace(slots.back().event.seq, i);
+        }
+        slots_.swap(slots);
+        freeSlots_.clear();
+        freeSlots_.shrink_to_fit();
+        heap_.shrink_to_fit();
+    }
+
+    std::vector<Slot> slots_;
+    std::vector<size_t> freeSlots_;
+    std::vector<size_t> heap_;
+    std::unordered_multimap<uint64_t, size_t> seqIndex_;
+    uint64_t pushCount_ = 0;
 };
 }  // namespace HiviewDFX
 }  // namespace OHOS
-#endif  // HIVIEW_BASE_EVENT_LOOP_H
\ No newline at end of file
+#endif  // HIVIEW_BASE_EVENT_LOOP_H
@@ -26,6 +26,7 @@
 
 #include "encoded/encoded_param.h"
 #include "decoded/decoded_event.h"
+#include "decoded/raw_data_index.h"
 #include "pipeline.h"
 #include "encoded/raw_data_builder.h"
 #include "base/raw_data.h"
@@ -128,17 +129,31 @@ public:
     uint8_t log_;
 
 public:
-    static std::atomic<uint32_t> totalCount_;
-    static std::atomic<int64_t> totalSize_;
+    static uint32_t GetTotalCount();
+    static int64_t GetTotalSize();
 
 private:
     void InitialMembers();
     bool InitBuilder();
+    std::shared_ptr<EventRaw::RawDataIndex> GetRawDataIndex();
     bool TryToUpdateRawData();
     std::shared_ptr<EventRaw::RawData> TansJsonStrToRawData(const std::string& jsonStr);
     std::string EscapeJsonStringValue(const std::string& src);
     std::string UnescapeJsonStringValue(const std::string& src);
 
+    template<typename T>
+    bool ParseValueByKey(const std::string& key, T& dest)
+    {
+        // builder holds the values set but not built yet, so it wins once created
+        if (builder_ != nullptr) {
+            return builder_->ParseValueByKey(key, dest);
+        }
+        if (auto index = GetRawDataIndex(); index != nullptr) {
+            return index->ParseValueByKey(key, dest);
+        }
+        return InitBuilder() && builder_->ParseValueByKey(key, dest);
+    }
+
 private:
     bool isUpdated_ = false;
     int64_t seq_ = 0;
@@ -151,8 +166,11 @@ private:
     std::string tag_;
     std::string level_;
     std::shared_ptr<EventRaw::RawDataBuilder> builder_;
+    std::shared_ptr<EventRaw::RawDataIndex> index_;
     std::string sysVersion_;
     std::string patchVersion_;
+    bool isCounted_ = false;
+    int64_t countedSize_ = 0;
 };
 
 class SysEventCreator {
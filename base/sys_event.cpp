@@ -14,16 +14,20 @@
  */
 #include "sys_event.h"
 
+#include <algorithm>
+#include <atomic>
 #include <chrono>
 #include <functional>
 #include <limits>
 #include <memory>
+#include <mutex>
 #include <regex>
 #include <sstream>
 #include <string>
 #include <sys/time.h>
 #include <vector>
 
+#include "decoded/raw_data_json_writer.h"
 #include "encoded/raw_data_builder_json_parser.h"
 #include "string_util.h"
 #include "time_util.h"
@@ -50,35 +54,107 @@ constexpr int64_t DEFAULT_INT_VALUE = 0;
 constexpr uint64_t DEFAULT_UINT_VALUE = 0;
 constexpr double DEFAULT_DOUBLE_VALUE = 0.0;
 constexpr size_t BLOCK_SIZE_OFFSET = sizeof(int32_t);
+constexpr size_t CACHE_LINE_SIZE = 64;
 
-template<typename T>
-void AppendJsonValue(std::string& eventJson, const std::string& key, T val)
-{
-    if (eventJson.empty()) {
-        return;
+// count and size of the events alive, each thread only writes its own counter
+struct alignas(CACHE_LINE_SIZE) EventCounter {
+    std::atomic<int64_t> count {0};
+    std::atomic<int64_t> size {0};
+
+    void Add(int64_t cnt, int64_t sz)
+    {
+        count.store(count.load(std::memory_order_relaxed) + cnt, std::memory_order_relaxed);
+        size.store(size.load(std::memory_order_relaxed) + sz, std::memory_order_relaxed);
     }
-    std::string findKey = "\"" + key + "\":";
-    if (eventJson.find(findKey) != std::string::npos) {
-        return;
+};
+
+// sums the counters of all threads on read, the counters of exited threads are folded into retired ones
+class EventCounterRegistry {
+public:
+    static EventCounterRegistry& GetInstance()
+    {
+        // never destroyed, events may still be released while statics are torn down
+        static EventCounterRegistry* instance = new EventCounterRegistry();
+        return *instance;
+    }
+
+    void Register(EventCounter* counter)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        counters_.emplace_back(counter);
+    }
+
+    void Unregister(EventCounter* counter)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        retiredCount_ += counter->count.load(std::memory_order_relaxed);
+        retiredSize_ += counter->size.load(std::memory_order_relaxed);
+        counters_.erase(std::remove(counters_.begin(), counters_.end(), counter), counters_.end());
+    }
+
+    int64_t GetTotalCount()
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        int64_t total = retiredCount_;
+        for (const auto counter : counters_) {
+            total += counter->count.load(std::memory_order_relaxed);
+        }
+        // events may be released by another thread than the one created them, only the sum is exact
+        return std::max<int64_t>(total, 0);
+    }
+
+    int64_t GetTotalSize()
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        int64_t total = retiredSize_;
+        for (const auto counter : counters_) {
+            total += counter->size.load(std::memory_order_relaxed);
+        }
+        return std::max<int64_t>(total, 0);
+    }
+
+private:
+    EventCounterRegistry() = default;
+    ~EventCounterRegistry() = default;
+
+private:
+    std::mutex mutex_;
+    std::vector<EventCounter*> counters_;
+    int64_t retiredCount_ = 0;
+    int64_t retiredSize_ = 0;
+};
+
+class ThreadEventCounter {
+public:
+    ThreadEventCounter()
+    {
+        EventCounterRegistry::GetInstance().Register(&counter_);
     }
-    std::string appendStr;
-    appendStr.append(",\"").append(key).append("\":");
-    if constexpr (std::is_same_v<std::decay_t<T>, std::string>) {
-        appendStr.append("\"").append(val).append("\"");
-    } else {
-        appendStr.append(std::to_string(val));
+
+    ~ThreadEventCounter()
+    {
+        EventCounterRegistry::GetInstance().Unregister(&counter_);
+    }
+
+    EventCounter& Get()
+    {
+        return counter_;
     }
-    eventJson.insert(eventJson.size() - 1, appendStr); // 1 for '}'
+
+private:
+    EventCounter counter_;
+};
+
+void UpdateEventCounter(int64_t cnt, int64_t size)
+{
+    thread_local ThreadEventCounter counter;
+    counter.Get().Add(cnt, size);
 }
 
-template<typename T>
-bool ParseArrayValue(std::shared_ptr<EventRaw::RawDataBuilder> builder, const std::string& key,
-    std::function<bool(T&)> itemHandler)
+template<typename T, typename Parser>
+bool ParseArrayValue(Parser& parser, std::function<bool(T&)> itemHandler)
 {
-    if (builder == nullptr) {
-        return false;
-    }
-    if (std::vector<T> arr; builder->ParseValueByKey(key, arr)) {
+    if (std::vector<T> arr; parser(arr)) {
         if (arr.empty()) {
             return true;
         }
@@ -97,8 +173,16 @@ using EventRaw::UnsignedVarintEncodedArrayParam;
 using EventRaw::SignedVarintEncodedArrayParam;
 using EventRaw::FloatingNumberEncodedArrayParam;
 using EventRaw::StringEncodedArrayParam;
-std::atomic<uint32_t> SysEvent::totalCount_(0);
-std::atomic<int64_t> SysEvent::totalSize_(0);
+
+uint32_t SysEvent::GetTotalCount()
+{
+    return static_cast<uint32_t>(EventCounterRegistry::GetInstance().GetTotalCount());
+}
+
+int64_t SysEvent::GetTotalSize()
+{
+    return EventCounterRegistry::GetInstance().GetTotalSize();
+}
 
 SysEvent::SysEvent(const std::string& sender, PipelineEventProducer* handler,
     std::shared_ptr<EventRaw::RawData> rawData, int64_t seq,
@@ -113,8 +197,10 @@ SysEvent::SysEvent(const std::string& sender, PipelineEventProducer* handler,
     sysVersion_ = sysVersion;
     patchVersion_ = patchVersion;
     rawData_ = rawData;
-    totalCount_.fetch_add(1);
-    totalSize_.fetch_add(*(reinterpret_cast<int32_t*>(rawData_->GetData())));
+    // remember the size counted, raw data may be rebuilt with another size before the event is released
+    countedSize_ = *(reinterpret_cast<int32_t*>(rawData_->GetData()));
+    UpdateEventCounter(1, countedSize_);
+    isCounted_ = true;
     InitialMembers();
 }
 
@@ -139,14 +225,8 @@ SysEvent::SysEvent(const std::string& sender, PipelineEventProducer* handler, co
 
 SysEvent::~SysEvent()
 {
-    if (totalCount_ > 0) {
-        totalCount_.fetch_sub(1);
-    }
-    if (rawData_ != nullptr && rawData_->GetData() != nullptr) {
-        totalSize_.fetch_sub(*(reinterpret_cast<int32_t*>(rawData_->GetData())));
-    }
-    if (totalSize_ < 0) {
-        totalSize_.store(0);
+    if (isCounted_) {
+        UpdateEventCounter(-1, -countedSize_);
     }
 }
 
@@ -174,9 +254,22 @@ bool SysEvent::InitBuilder()
         return true;
     }
     builder_ = std::make_shared<EventRaw::RawDataBuilder>(rawData_);
+    index_ = nullptr;
     return builder_ != nullptr;
 }
 
+std::shared_ptr<EventRaw::RawDataIndex> SysEvent::GetRawDataIndex()
+{
+    if (rawData_ == nullptr) {
+        return nullptr;
+    }
+    // raw data may be rebuilt, so the index is only reused for the same one
+    if (index_ == nullptr || index_->GetRawData() != rawData_) {
+        index_ = std::make_shared<EventRaw::RawDataIndex>(rawData_);
+    }
+    return index_->IsValid() ? index_ : nullptr;
+}
+
 std::shared_ptr<EventRaw::RawData> SysEvent::TansJsonStrToRawData(const std::string& jsonStr)
 {
     auto parser = std::make_unique<EventRaw::RawDataBuilderJsonParser>(jsonStr);
@@ -290,27 +383,21 @@ uint8_t SysEvent::GetPrivacy() const
 
 std::string SysEvent::GetEventValue(const std::string& key)
 {
-    if (!InitBuilder()) {
-        return "";
-    }
     std::string dest;
-    builder_->ParseValueByKey(key, dest);
+    ParseValueByKey(key, dest);
     return dest;
 }
 
 int64_t SysEvent::GetEventIntValue(const std::string& key)
 {
-    if (!InitBuilder()) {
-        return DEFAULT_INT_VALUE;
-    }
-    if (int64_t intDest = DEFAULT_INT_VALUE; builder_->ParseValueByKey(key, intDest)) {
+    if (int64_t intDest = DEFAULT_INT_VALUE; ParseValueByKey(key, intDest)) {
         return intDest;
     }
-    if (uint64_t uIntDest = DEFAULT_UINT_VALUE; builder_->ParseValueByKey(key, uIntDest) &&
+    if (uint64_t uIntDest = DEFAULT_UINT_VALUE; ParseValueByKey(key, uIntDest) &&
         (uIntDest <= static_cast<uint64_t>(std::numeric_limits<int64_t>::max()))) {
         return static_cast<int64_t>(uIntDest);
     }
-    if (double dDest = DEFAULT_DOUBLE_VALUE; builder_->ParseValueByKey(key, dDest) &&
+    if (double dDest = DEFAULT_DOUBLE_VALUE; ParseValueByKey(key, dDest) &&
         (dDest >= static_cast<double>(std::numeric_limits<int64_t>::min())) &&
         (dDest <= static_cast<double>(std::numeric_limits<int64_t>::max()))) {
         return static_cast<int64_t>(dDest);
@@ -320,17 +407,14 @@ int64_t SysEvent::GetEventIntValue(const std::string& key)
 
 uint64_t SysEvent::GetEventUintValue(const std::string& key)
 {
-    if (!InitBuilder()) {
-        return DEFAULT_UINT_VALUE;
-    }
-    if (uint64_t uIntDest = DEFAULT_UINT_VALUE; builder_->ParseValueByKey(key, uIntDest)) {
+    if (uint64_t uIntDest = DEFAULT_UINT_VALUE; ParseValueByKey(key, uIntDest)) {
         return uIntDest;
     }
-    if (int64_t intDest = DEFAULT_INT_VALUE; builder_->ParseValueByKey(key, intDest) &&
+    if (int64_t intDest = DEFAULT_INT_VALUE; ParseValueByKey(key, intDest) &&
         (intDest >= DEFAULT_INT_VALUE)) {
         return static_cast<uint64_t>(intDest);
     }
-    if (double dDest = DEFAULT_DOUBLE_VALUE; builder_->ParseValueByKey(key, dDest) &&
+    if (double dDest = DEFAULT_DOUBLE_VALUE; ParseValueByKey(key, dDest) &&
         (dDest >= static_cast<double>(std::numeric_limits<uint64_t>::min())) &&
         (dDest <= static_cast<double>(std::numeric_limits<uint64_t>::max()))) {
         return static_cast<uint64_t>(dDest);
@@ -340,16 +424,13 @@ uint64_t SysEvent::GetEventUintValue(const std::string& key)
 
 double SysEvent::GetEventDoubleValue(const std::string& key)
 {
-    if (!InitBuilder()) {
-        return DEFAULT_DOUBLE_VALUE;
-    }
-    if (double dDest = DEFAULT_DOUBLE_VALUE; builder_->ParseValueByKey(key, dDest)) {
+    if (double dDest = DEFAULT_DOUBLE_VALUE; ParseValueByKey(key, dDest)) {
         return dDest;
     }
-    if (int64_t intDest = DEFAULT_INT_VALUE; builder_->ParseValueByKey(key, intDest)) {
+    if (int64_t intDest = DEFAULT_INT_VALUE; ParseValueByKey(key, intDest)) {
         return static_cast<double>(intDest);
     }
-    if (uint64_t uIntDest = DEFAULT_UINT_VALUE; builder_->ParseValueByKey(key, uIntDest)) {
+    if (uint64_t uIntDest = DEFAULT_UINT_VALUE; ParseValueByKey(key, uIntDest)) {
         return static_cast<double>(uIntDest);
     }
     return DEFAULT_DOUBLE_VALUE;
@@ -358,9 +439,9 @@ double SysEvent::GetEventDoubleValue(const std::string& key)
 bool SysEvent::GetEventIntArrayValue(const std::string& key, std::vector<int64_t>& dest)
 {
     dest.clear();
-    if (!InitBuilder()) {
-        return false;
-    }
+    auto arrayParser = [this, &key] (auto& arr) {
+        return ParseValueByKey(key, arr);
+    };
     auto intArrayItemHandler = [&dest] (int64_t& item) {
         dest.emplace_back(item);
         return true;
@@ -383,10 +464,10 @@ bool SysEvent::GetEventIntArrayValue(const std::string& key, std::vector<int64_t
     auto strArrayItemHandler = [&dest] (std::string& item) {
         return false;
     };
-    if (ParseArrayValue<int64_t>(builder_, key, intArrayItemHandler) ||
-        ParseArrayValue<uint64_t>(builder_, key, uIntArrayItemHandler) ||
-        ParseArrayValue<double>(builder_, key, dArrayItemHandler) ||
-        ParseArrayValue<std::string>(builder_, key, strArrayItemHandler)) {
+    if (ParseArrayValue<int64_t>(arrayParser, intArrayItemHandler) ||
+        ParseArrayValue<uint64_t>(arrayParser, uIntArrayItemHandler) ||
+        ParseArrayValue<double>(arrayParser, dArrayItemHandler) ||
+        ParseArrayValue<std::string>(arrayParser, strArrayItemHandler)) {
         return true;
     }
     dest.clear();
@@ -396,9 +477,9 @@ bool SysEvent::GetEventIntArrayValue(const std::string& key, std::vector<int64_t
 bool SysEvent::GetEventUintArrayValue(const std::string& key, std::vector<uint64_t>& dest)
 {
     dest.clear();
-    if (!InitBuilder()) {
-        return false;
-    }
+    auto arrayParser = [this, &key] (auto& arr) {
+        return ParseValueByKey(key, arr);
+    };
     auto uIntArrayItemHandler = [&dest] (uint64_t& item) {
         dest.emplace_back(item);
         return true;
@@ -421,10 +502,10 @@ bool SysEvent::GetEventUintArrayValue(const std::string& key, std::vector<uint64
     auto strArrayItemHandler = [&dest] (std::string& item) {
         return false;
     };
-    if (ParseArrayValue<uint64_t>(builder_, key, uIntArrayItemHandler) ||
-        ParseArrayValue<int64_t>(builder_, key, intArrayItemHandler) ||
-        ParseArrayValue<double>(builder_, key, dArrayItemHandler) ||
-        ParseArrayValue<std::string>(builder_, key, strArrayItemHandler)) {
+    if (ParseArrayValue<uint64_t>(arrayParser, uIntArrayItemHandler) ||
+        ParseArrayValue<int64_t>(arrayParser, intArrayItemHandler) ||
+        ParseArrayValue<double>(arrayParser, dArrayItemHandler) ||
+        ParseArrayValue<std::string>(arrayParser, strArrayItemHandler)) {
         return true;
     }
     dest.clear();
@@ -434,9 +515,9 @@ bool SysEvent::GetEventUintArrayValue(const std::string& key, std::vector<uint64
 bool SysEvent::GetEventDoubleArrayValue(const std::string& key, std::vector<double>& dest)
 {
     dest.clear();
-    if (!InitBuilder()) {
-        return false;
-    }
+    auto arrayParser = [this, &key] (auto& arr) {
+        return ParseValueByKey(key, arr);
+    };
     auto dArrayItemHandler = [&dest] (double& item) {
         dest.emplace_back(item);
         return true;
@@ -452,10 +533,10 @@ bool SysEvent::GetEventDoubleArrayValue(const std::string& key, std::vector<doub
     auto strArrayItemHandler = [&dest] (std::string& item) {
         return false;
     };
-    if (ParseArrayValue<double>(builder_, key, dArrayItemHandler) ||
-        ParseArrayValue<int64_t>(builder_, key, intArrayItemHandler) ||
-        ParseArrayValue<uint64_t>(builder_, key, uIntArrayItemHandler) ||
-        ParseArrayValue<std::string>(builder_, key, strArrayItemHandler)) {
+    if (ParseArrayValue<double>(arrayParser, dArrayItemHandler) ||
+        ParseArrayValue<int64_t>(arrayParser, intArrayItemHandler) ||
+        ParseArrayValue<uint64_t>(arrayParser, uIntArrayItemHandler) ||
+        ParseArrayValue<std::string>(arrayParser, strArrayItemHandler)) {
         return true;
     }
     dest.clear();
@@ -465,9 +546,9 @@ bool SysEvent::GetEventDoubleArrayValue(const std::string& key, std::vector<doub
 bool SysEvent::GetEventStringArrayValue(const std::string& key, std::vector<std::string>& dest)
 {
     dest.clear();
-    if (!InitBuilder()) {
-        return false;
-    }
+    auto arrayParser = [this, &key] (auto& arr) {
+        return ParseValueByKey(key, arr);
+    };
     auto strArrayItemHandler = [&dest] (std::string& item) {
         dest.emplace_back(item);
         return true;
@@ -481,10 +562,10 @@ bool SysEvent::GetEventStringArrayValue(const std::string& key, std::vector<std:
     auto uIntArrayItemHandler = [&dest] (uint64_t& item) {
         return false;
     };
-    if (ParseArrayValue<std::string>(builder_, key, strArrayItemHandler) ||
-        ParseArrayValue<uint64_t>(builder_, key, uIntArrayItemHandler) ||
-        ParseArrayValue<int64_t>(builder_, key, intArrayItemHandler) ||
-        ParseArrayValue<double>(builder_, key, dArrayItemHandler)) {
+    if (ParseArrayValue<std::string>(arrayParser, strArrayItemHandler) ||
+        ParseArrayValue<uint64_t>(arrayParser, uIntArrayItemHandler) ||
+        ParseArrayValue<int64_t>(arrayParser, intArrayItemHandler) ||
+        ParseArrayValue<double>(arrayParser, dArrayItemHandler)) {
         return true;
     }
     dest.clear();
@@ -522,19 +603,17 @@ std::string SysEvent::AsJsonStr()
     }
 
     std::string jsonStr;
-    {
-        EventRaw::DecodedEvent event(rawData_->GetData());
-        jsonStr = event.AsJsonStr();
-    }
+    EventRaw::RawDataJsonWriter writer(jsonStr);
     if (!tag_.empty()) {
-        AppendJsonValue(jsonStr, EventStore::EventCol::TAG, tag_);
+        writer.AddExtraField(EventStore::EventCol::TAG, tag_);
     }
     if (!level_.empty()) {
-        AppendJsonValue(jsonStr, EventStore::EventCol::LEVEL, level_);
+        writer.AddExtraField(EventStore::EventCol::LEVEL, level_);
     }
     if (eventSeq_ >= 0) {
-        AppendJsonValue(jsonStr, EventStore::EventCol::SEQ, eventSeq_);
+        writer.AddExtraField(EventStore::EventCol::SEQ, eventSeq_);
     }
+    (void)writer.Write(rawData_->GetData());
     return jsonStr;
 }
 
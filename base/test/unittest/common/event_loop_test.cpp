@@ -14,11 +14,14 @@
  */
 #include "event_loop_test.h"
 
+#include <algorithm>
+#include <chrono>
 #include <cinttypes>
 #include <ctime>
 #include <fstream>
 #include <iostream>
 #include <limits>
+#include <random>
 #include <thread>
 
 #include <gtest/gtest.h>
@@ -508,5 +511,69 @@ HWTEST_F(EventLoopTest, EventLoopEventAuditTest001, TestSize.Level3)
     EXPECT_NE(currentLooper_->GetName(), loopName); // name: loopName@xxx
     EXPECT_EQ(currentLooper_->GetRawName(), loopName);
 }
+
+/**
+ * @tc.name: EventPriorityQueueBenchmarkTest001
+ * @tc.desc: enqueue, cancel and fire 10k pending timers and check the cost and order
+ * @tc.type: FUNC
+ * @tc.require: AR000DPTSU
+ */
+HWTEST_F(EventLoopTest, EventPriorityQueueBenchmarkTest001, TestSize.Level3)
+{
+    /**
+     * @tc.steps: step1. enqueue 10k timers with random target time
+     * @tc.steps: step2. cancel the timers by seq in random order
+     * @tc.steps: step3. enqueue 10k timers again and fire them in order of the target time
+     */
+    const uint64_t timerNum = 10000;
+    const uint64_t maxInterval = 3600000000000; // 3600000000000: 1 hour in nanoseconds
+    std::mt19937_64 randomEngine(timerNum);
+    std::vector<uint64_t> targetTimes;
+    for (uint64_t i = 0; i < timerNum; i++) {
+        targetTimes.push_back(randomEngine() % maxInterval);
+    }
+    auto enqueueTimers = [&targetTimes](EventPriorityQueue<LoopEvent>& queue) {
+        for (uint64_t i = 0; i < targetTimes.size(); i++) {
+            LoopEvent event = LoopEvent::CreateLoopEvent(i + 1); // seq begins from 1
+            event.targetTime = targetTimes[i];
+            event.task = [] {};
+            queue.push(std::move(event));
+        }
+    };
+    auto getCostPerTimer = [timerNum](std::chrono::steady_clock::time_point begin) {
+        auto cost = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - begin);
+        return static_cast<uint64_t>(cost.count()) / timerNum;
+    };
+
+    EventPriorityQueue<LoopEvent> queue;
+    auto begin = std::chrono::steady_clock::now();
+    enqueueTimers(queue);
+    printf("EnqueueCostPerTimer:%" PRIu64 "ns.\n", getCostPerTimer(begin));
+    ASSERT_EQ(queue.size(), timerNum);
+
+    std::vector<uint64_t> seqs;
+    for (uint64_t i = 1; i <= timerNum; i++) {
+        seqs.push_back(i);
+    }
+    std::shuffle(seqs.begin(), seqs.end(), randomEngine);
+    begin = std::chrono::steady_clock::now();
+    for (auto seq : seqs) {
+        ASSERT_TRUE(queue.remove(seq));
+    }
+    printf("CancelCostPerTimer:%" PRIu64 "ns.\n", getCostPerTimer(begin));
+    ASSERT_TRUE(queue.empty());
+    ASSERT_FALSE(queue.remove(1)); // 1: seq of the removed timer
+
+    enqueueTimers(queue);
+    queue.ShrinkIfNeedLocked();
+    uint64_t lastTargetTime = 0;
+    begin = std::chrono::steady_clock::now();
+    while (!queue.empty()) {
+        ASSERT_GE(queue.top().targetTime, lastTargetTime);
+        lastTargetTime = queue.top().targetTime;
+        queue.pop();
+    }
+    printf("FireCostPerTimer:%" PRIu64 "ns.\n", getCostPerTimer(begin));
+}
 }
 }
@@ -19,6 +19,7 @@
 #include <limits>
 #include <memory>
 #include <regex>
+#include <thread>
 #include <vector>
 
 #include "sys_event.h"
@@ -645,5 +646,30 @@ HWTEST_F(SysEventTest, TestSetIdAndSetLog001, testing::ext::TestSize.Level3)
     std::string matchedLogContent = std::string("\"log_\":") + std::to_string(log);
     ASSERT_NE(eventStr.find(matchedLogContent), std::string::npos);
 }
+
+/**
+ * @tc.name: TestTotalCountAndSize001
+ * @tc.desc: Test count and size of events alive summed from all threads
+ * @tc.type: FUNC
+ * @tc.require: issueIAH9IC
+ */
+HWTEST_F(SysEventTest, TestTotalCountAndSize001, testing::ext::TestSize.Level3)
+{
+    uint32_t originCount = SysEvent::GetTotalCount();
+    int64_t originSize = SysEvent::GetTotalSize();
+    auto sysEvent = std::make_shared<SysEvent>("SysEventSource", nullptr, GetOriginTestString());
+    ASSERT_TRUE(sysEvent != nullptr);
+    int64_t eventSize = *(reinterpret_cast<int32_t*>(sysEvent->rawData_->GetData()));
+    ASSERT_EQ(SysEvent::GetTotalCount(), originCount + 1);
+    ASSERT_EQ(SysEvent::GetTotalSize(), originSize + eventSize);
+
+    // released by another thread which then exits
+    std::thread releaseThread([&sysEvent] {
+        sysEvent.reset();
+    });
+    releaseThread.join();
+    ASSERT_EQ(SysEvent::GetTotalCount(), originCount);
+    ASSERT_EQ(SysEvent::GetTotalSize(), originSize);
+}
 } // HiviewDFX
 } // OHOS
\ No newline at end of file
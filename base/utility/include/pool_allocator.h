@@ -0,0 +1,133 @@
+/*
+ * Copyright (c) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef UTILITY_POOL_ALLOCATOR_H
+#define UTILITY_POOL_ALLOCATOR_H
+
+#include <cstddef>
+#include <mutex>
+#include <new>
+#include <vector>
+
+namespace OHOS {
+namespace HiviewDFX {
+/*
+ * Freelist of fixed size memory blocks, blocks freed are kept for the next allocation
+ * instead of being given back to the heap, at most MaxIdleCnt of them.
+ */
+template<size_t BlockSize, size_t MaxIdleCnt = 256>
+class FixedBlockPool {
+public:
+    static FixedBlockPool& GetInstance()
+    {
+        // never destroyed, blocks may still be freed while statics are torn down
+        static FixedBlockPool* instance = new FixedBlockPool();
+        return *instance;
+    }
+
+    void* Allocate()
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (!idleBlocks_.empty()) {
+                void* block = idleBlocks_.back();
+                idleBlocks_.pop_back();
+                return block;
+            }
+        }
+        return ::operator new(ALIGNED_SIZE);
+    }
+
+    void Deallocate(void* block)
+    {
+        if (block == nullptr) {
+            return;
+        }
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (idleBlocks_.size() < MaxIdleCnt) {
+                idleBlocks_.emplace_back(block);
+                return;
+            }
+        }
+        ::operator delete(block);
+    }
+
+    size_t GetIdleCount()
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return idleBlocks_.size();
+    }
+
+private:
+    FixedBlockPool()
+    {
+        idleBlocks_.reserve(MaxIdleCnt);
+    }
+    ~FixedBlockPool() = default;
+
+private:
+    static constexpr size_t ALIGNED_SIZE =
+        (BlockSize + alignof(std::max_align_t) - 1) / alignof(std::max_align_t) * alignof(std::max_align_t);
+    std::mutex mutex_;
+    std::vector<void*> idleBlocks_;
+};
+
+/*
+ * Allocator serving single objects from a FixedBlockPool, for allocate_shared of objects created and
+ * released at a high rate. Arrays fall back to the heap.
+ */
+template<typename T>
+class PoolAllocator {
+public:
+    using value_type = T;
+
+    PoolAllocator() noexcept = default;
+
+    template<typename U>
+    PoolAllocator(const PoolAllocator<U>&) noexcept {}
+
+    T* allocate(size_t n)
+    {
+        static_assert(alignof(T) <= alignof(std::max_align_t), "over aligned type is not supported");
+        if (n == 1) {
+            return static_cast<T*>(FixedBlockPool<sizeof(T)>::GetInstance().Allocate());
+        }
+        return static_cast<T*>(::operator new(n * sizeof(T)));
+    }
+
+    void deallocate(T* ptr, size_t n)
+    {
+        if (n == 1) {
+            FixedBlockPool<sizeof(T)>::GetInstance().Deallocate(ptr);
+            return;
+        }
+        ::operator delete(ptr);
+    }
+
+    template<typename U>
+    bool operator==(const PoolAllocator<U>&) const noexcept
+    {
+        return true;
+    }
+
+    template<typename U>
+    bool operator!=(const PoolAllocator<U>&) const noexcept
+    {
+        return false;
+    }
+};
+} // namespace HiviewDFX
+} // namespace OHOS
+#endif // UTILITY_POOL_ALLOCATOR_H
@@ -14,6 +14,7 @@
  */
 #include "string_util.h"
 
+#include <array>
 #include <climits>
 #include <iomanip>
 #include <iostream>
@@ -41,6 +42,21 @@ std::string ReplaceMatchedStrWithAsterisk(const std::string& source, const std::
     }
     return source;
 }
+
+// the char following '\\' for each byte which needs escaping in json, 0 for the others
+constexpr std::array<char, UCHAR_MAX + 1> BuildJsonEscapeTable()
+{
+    std::array<char, UCHAR_MAX + 1> table {};
+    table['\\'] = '\\';
+    table['\"'] = '"';
+    table['\b'] = 'b';
+    table['\f'] = 'f';
+    table['\n'] = 'n';
+    table['\r'] = 'r';
+    table['\t'] = 't';
+    return table;
+}
+constexpr std::array<char, UCHAR_MAX + 1> JSON_ESCAPE_TABLE = BuildJsonEscapeTable();
 }
 using namespace std;
 const char INDICATE_VALUE_CHAR = ':';
@@ -346,41 +362,20 @@ std::string FindMatchSubString(const std::string& target, const std::string& beg
 std::string EscapeJsonStringValue(const std::string &value)
 {
     std::string escapeValue;
-    for (auto it = value.begin(); it != value.end(); it++) {
-        switch (*it) {
-            case '\\':
-                escapeValue.push_back('\\');
-                escapeValue.push_back('\\');
-                break;
-            case '\"':
-                escapeValue.push_back('\\');
-                escapeValue.push_back('"');
-                break;
-            case '\b':
-                escapeValue.push_back('\\');
-                escapeValue.push_back('b');
-                break;
-            case '\f':
-                escapeValue.push_back('\\');
-                escapeValue.push_back('f');
-                break;
-            case '\n':
-                escapeValue.push_back('\\');
-                escapeValue.push_back('n');
-                break;
-            case '\r':
-                escapeValue.push_back('\\');
-                escapeValue.push_back('r');
-                break;
-            case '\t':
-                escapeValue.push_back('\\');
-                escapeValue.push_back('t');
-                break;
-            default:
-                escapeValue.push_back(*it);
-                break;
+    escapeValue.reserve(value.size());
+    // copy the runs of plain chars in one go and only break them at the chars to escape
+    size_t runBegin = 0;
+    for (size_t i = 0; i < value.size(); ++i) {
+        char escapeChar = JSON_ESCAPE_TABLE[static_cast<unsigned char>(value[i])];
+        if (escapeChar == 0) {
+            continue;
         }
+        escapeValue.append(value, runBegin, i - runBegin);
+        escapeValue.push_back('\\');
+        escapeValue.push_back(escapeChar);
+        runBegin = i + 1;
     }
+    escapeValue.append(value, runBegin, std::string::npos);
     return escapeValue;
 }
 
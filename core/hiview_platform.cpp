@@ -21,6 +21,7 @@
 #endif
 #include <cinttypes>
 #include <csignal>
+#include <cstdio>
 #include <fstream>
 #include <functional>
 
@@ -476,7 +477,9 @@ void HiviewPlatform::CreatePipeline(const PluginConfig::PipelineInfo& pipelineIn
     }
     DispatchRuleParser ruleParser(configPath);
     if (auto rule = ruleParser.GetRule(); rule != nullptr) {
+        std::lock_guard<std::mutex> lock(routeMutex_);
         pipelineRules_[pipelineInfo.name] = rule;
+        RebuildPipelineRoute();
     } else {
         HIVIEW_LOGE("failed to parse config file=%{public}s", configPath.c_str());
     }
@@ -654,6 +657,7 @@ void HiviewPlatform::RegisterUnorderedEventListener(std::weak_ptr<EventListener>
         return;
     }
     auto name = ptr->GetListenerName();
+    std::lock_guard<std::mutex> lock(routeMutex_);
     auto itListenerInfo = listeners_.find(name);
     if (itListenerInfo == listeners_.end()) {
         auto tmp = std::make_shared<ListenerInfo>();
@@ -663,6 +667,7 @@ void HiviewPlatform::RegisterUnorderedEventListener(std::weak_ptr<EventListener>
         auto tmp = listeners_[name];
         tmp->listener_ = listener;
     }
+    RebuildListenerRoute();
 }
 
 bool HiviewPlatform::PostSyncEventToTarget(std::shared_ptr<Plugin> caller, const std::string& calleeName,
@@ -763,6 +768,7 @@ void HiviewPlatform::UnloadPlugin(const std::string& name)
     }
     pluginMap_.erase(name);
     target->OnUnload();
+    RemoveRouteInfo(target);
 
     // By default, reloading is not supported after unloading!
     PluginFactory::UnregisterPlugin(target->GetName());
@@ -987,6 +993,7 @@ void HiviewPlatform::AddDispatchInfo(std::weak_ptr<Plugin> plugin, const std::un
         return;
     }
     auto name = ptr->GetName();
+    std::lock_guard<std::mutex> lock(routeMutex_);
     auto itDispatchInfo = dispatchers_.find(name);
     std::shared_ptr<DispatchInfo> data = nullptr;
     if (itDispatchInfo == dispatchers_.end()) {
@@ -1009,11 +1016,13 @@ void HiviewPlatform::AddDispatchInfo(std::weak_ptr<Plugin> plugin, const std::un
     if (!domainRulesMap.empty()) {
         data->domainsInfo_.insert(domainRulesMap.begin(), domainRulesMap.end());
     }
+    RebuildDispatcherRoute();
 }
 
 void HiviewPlatform::AddListenerInfo(uint32_t type, const std::string& name, const std::set<std::string>& eventNames,
     const std::map<std::string, DomainRule>& domainRulesMap)
 {
+    std::lock_guard<std::mutex> lock(routeMutex_);
     auto itListenerInfo = listeners_.find(name);
     std::shared_ptr<ListenerInfo> data = nullptr;
     if (itListenerInfo == listeners_.end()) {
@@ -1039,10 +1048,12 @@ void HiviewPlatform::AddListenerInfo(uint32_t type, const std::string& name, con
             data->domainsInfo_[type] = domainRulesMap;
         }
     }
+    RebuildListenerRoute();
 }
 
 void HiviewPlatform::AddListenerInfo(uint32_t type, const std::string& name)
 {
+    std::lock_guard<std::mutex> lock(routeMutex_);
     auto itListenerInfo = listeners_.find(name);
     std::shared_ptr<ListenerInfo> data = nullptr;
     if (itListenerInfo == listeners_.end()) {
@@ -1053,32 +1064,155 @@ void HiviewPlatform::AddListenerInfo(uint32_t type, const std::string& name)
         data = itListenerInfo->second;
     }
     data->messageTypes_.push_back(type);
+    RebuildListenerRoute();
 }
 
 std::vector<std::weak_ptr<EventListener>> HiviewPlatform::GetListenerInfo(uint32_t type,
     const std::string& eventName, const std::string& domain)
 {
-    std::vector<std::weak_ptr<EventListener>> ret;
-    for (auto& pairListener : listeners_) {
-        auto listenerInfo = pairListener.second;
-        if (listenerInfo->Match(type, eventName, domain)) {
-            ret.push_back(listenerInfo->listener_);
-        }
+    auto route = std::atomic_load(&listenerRoute_);
+    if (route == nullptr) {
+        return {};
     }
-    return ret;
+    return route->Find(type, domain, eventName);
 }
 
 std::vector<std::weak_ptr<Plugin>> HiviewPlatform::GetDisPatcherInfo(uint32_t type,
     const std::string& eventName, const std::string& tag, const std::string& domain)
 {
-    std::vector<std::weak_ptr<Plugin>> ret;
-    for (auto& pairDispatcher : dispatchers_) {
-        auto dispatcherInfo = pairDispatcher.second;
-        if (dispatcherInfo->Match(type, eventName, tag, domain)) {
-            ret.push_back(dispatcherInfo->plugin_);
+    auto route = std::atomic_load(&dispatcherRoute_);
+    if (route == nullptr) {
+        return {};
+    }
+    // dispatch types are registered as uint8_t
+    return route->Find(static_cast<uint8_t>(type), domain, eventName, tag);
+}
+
+std::shared_ptr<Pipeline> HiviewPlatform::GetPipelineByEvent(const std::string& domain, const std::string& eventName)
+{
+    auto route = std::atomic_load(&pipelineRoute_);
+    if (route == nullptr) {
+        return nullptr;
+    }
+    return route->FindFirst(0, domain, eventName).lock();
+}
+
+void HiviewPlatform::RebuildListenerRoute()
+{
+    uint64_t beginTime = TimeUtil::GenerateTimestamp();
+    auto route = std::make_shared<EventRouteIndex<EventListener>>();
+    for (const auto& listenerPair : listeners_) {
+        auto info = listenerPair.second;
+        size_t id = route->AddTarget(info->listener_);
+        for (auto type : info->messageTypes_) {
+            route->AddTypeRule(id, type);
+        }
+        for (const auto& [type, eventNames] : info->eventsInfo_) {
+            for (const auto& eventName : eventNames) {
+                route->AddNameRule(id, eventName, type);
+            }
+        }
+        for (const auto& [type, domainRules] : info->domainsInfo_) {
+            for (const auto& [domain, rule] : domainRules) {
+                route->AddDomainRule(id, domain, rule, type);
+            }
+        }
+    }
+    std::atomic_store(&listenerRoute_, std::shared_ptr<const EventRouteIndex<EventListener>>(route));
+    listenerRouteStat_.buildCount++;
+    listenerRouteStat_.buildCost = TimeUtil::GenerateTimestamp() - beginTime;
+}
+
+void HiviewPlatform::RebuildDispatcherRoute()
+{
+    uint64_t beginTime = TimeUtil::GenerateTimestamp();
+    auto route = std::make_shared<EventRouteIndex<Plugin>>();
+    for (const auto& dispatcherPair : dispatchers_) {
+        auto info = dispatcherPair.second;
+        size_t id = route->AddTarget(info->plugin_);
+        for (auto type : info->typesInfo_) {
+            route->AddTypeRule(id, type);
+        }
+        for (const auto& tag : info->tagsInfo_) {
+            route->AddTagRule(id, tag);
+        }
+        for (const auto& eventName : info->eventsInfo_) {
+            route->AddNameRule(id, eventName);
+        }
+        for (const auto& [domain, rule] : info->domainsInfo_) {
+            route->AddDomainRule(id, domain, rule);
         }
     }
-    return ret;
+    std::atomic_store(&dispatcherRoute_, std::shared_ptr<const EventRouteIndex<Plugin>>(route));
+    dispatcherRouteStat_.buildCount++;
+    dispatcherRouteStat_.buildCost = TimeUtil::GenerateTimestamp() - beginTime;
+}
+
+void HiviewPlatform::RebuildPipelineRoute()
+{
+    uint64_t beginTime = TimeUtil::GenerateTimestamp();
+    auto route = std::make_shared<EventRouteIndex<Pipeline>>();
+
+    // pipeline rules are added in the order of names, the same order in which they used to be matched
+    for (const auto& [pipelineName, rule] : pipelineRules_) {
+        auto pipelineIter = pipelines_.find(pipelineName);
+        if (rule == nullptr || pipelineIter == pipelines_.end()) {
+            continue;
+        }
+        size_t id = route->AddTarget(pipelineIter->second);
+        for (const auto& eventName : rule->eventList) {
+            route->AddNameRule(id, eventName);
+        }
+        for (const auto& [domain, domainRule] : rule->domainRuleMap) {
+            route->AddDomainRule(id, domain, domainRule);
+        }
+    }
+    std::atomic_store(&pipelineRoute_, std::shared_ptr<const EventRouteIndex<Pipeline>>(route));
+    pipelineRouteStat_.buildCount++;
+    pipelineRouteStat_.buildCost = TimeUtil::GenerateTimestamp() - beginTime;
+}
+
+void HiviewPlatform::RemoveRouteInfo(std::shared_ptr<Plugin> plugin)
+{
+    std::lock_guard<std::mutex> lock(routeMutex_);
+    if (dispatchers_.erase(plugin->GetName()) > 0) {
+        RebuildDispatcherRoute();
+    }
+    auto listener = std::dynamic_pointer_cast<EventListener>(plugin);
+    if (listener == nullptr) {
+        return;
+    }
+    bool isRemoved = false;
+    for (auto iter = listeners_.begin(); iter != listeners_.end();) {
+        if (iter->second->listener_.lock() == listener) {
+            iter = listeners_.erase(iter);
+            isRemoved = true;
+        } else {
+            ++iter;
+        }
+    }
+    if (isRemoved) {
+        RebuildListenerRoute();
+    }
+}
+
+void HiviewPlatform::DumpRouteIndex(int fd)
+{
+    std::lock_guard<std::mutex> lock(routeMutex_);
+    auto dumpRoute = [fd] (const char* name, auto route, const RouteStat& stat) {
+        if (route == nullptr) {
+            dprintf(fd, "%s: not built\n", name);
+            return;
+        }
+        dprintf(fd, "%s: targets=%zu, rules=%zu, builds=%u, lastBuildCost=%" PRIu64 "us, lookupsSinceBuild=%" PRIu64 "\n",
+            name, route->GetTargetCount(), route->GetRuleCount(), stat.buildCount, stat.buildCost,
+            route->GetLookupCount());
+    };
+    dprintf(fd, "Event Route Index:\n");
+    dumpRoute("listener", std::atomic_load(&listenerRoute_), listenerRouteStat_);
+    dumpRoute("dispatcher", std::atomic_load(&dispatcherRoute_), dispatcherRouteStat_);
+    dumpRoute("pipeline", std::atomic_load(&pipelineRoute_), pipelineRouteStat_);
+    dprintf(fd, "Dump Event Route Index Done.\n\n");
 }
 } // namespace HiviewDFX
 } // namespace OHOS
@@ -41,6 +41,7 @@ public:
     virtual std::string GetName() = 0;
     virtual int ReceiveMsg(std::vector<std::shared_ptr<EventReceiver>> &receivers) = 0;
     virtual bool IsValidMsg(char* msg, int32_t len) = 0;
+    virtual void Dump(int fd) {}
 }; // DeviceNode
 } // namespace HiviewDFX
 } // namespace OHOS
@@ -0,0 +1,198 @@
+/*
+ * Copyright (c) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef HIVIEW_CORE_EVENT_ROUTE_INDEX_H
+#define HIVIEW_CORE_EVENT_ROUTE_INDEX_H
+
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+#include "defines.h"
+
+namespace OHOS {
+namespace HiviewDFX {
+/*
+ * Routing index from <message type, domain, name, tag> to subscribers. It is built
+ * once when subscriptions change and is read only afterwards, so a lookup is a few
+ * hash probes instead of matching the rules of every subscriber.
+ */
+template<typename T>
+class EventRouteIndex {
+public:
+    using TargetList = std::vector<std::weak_ptr<T>>;
+
+    size_t AddTarget(std::weak_ptr<T> target)
+    {
+        targets_.emplace_back(std::move(target));
+        return targets_.size() - 1;
+    }
+
+    void AddTypeRule(size_t id, uint32_t type)
+    {
+        typeNodes_[type].all.emplace_back(id);
+        ++ruleCount_;
+    }
+
+    void AddNameRule(size_t id, const std::string& name, uint32_t type)
+    {
+        typeNodes_[type].names[name].emplace_back(id);
+        ++ruleCount_;
+    }
+
+    void AddNameRule(size_t id, const std::string& name)
+    {
+        anyTypeNode_.names[name].emplace_back(id);
+        ++ruleCount_;
+    }
+
+    void AddTagRule(size_t id, const std::string& tag)
+    {
+        anyTypeNode_.tags[tag].emplace_back(id);
+        ++ruleCount_;
+    }
+
+    void AddDomainRule(size_t id, const std::string& domain, const DomainRule& rule, uint32_t type)
+    {
+        AddDomainRule(typeNodes_[type], id, domain, rule);
+    }
+
+    void AddDomainRule(size_t id, const std::string& domain, const DomainRule& rule)
+    {
+        AddDomainRule(anyTypeNode_, id, domain, rule);
+    }
+
+    TargetList Find(uint32_t type, const std::string& domain, const std::string& name,
+        const std::string& tag = "") const
+    {
+        std::vector<size_t> ids = FindIds(type, domain, name, tag);
+        TargetList targets;
+        targets.reserve(ids.size());
+        for (auto id : ids) {
+            targets.emplace_back(targets_[id]);
+        }
+        return targets;
+    }
+
+    // the target added first wins if the event matches several targets
+    std::weak_ptr<T> FindFirst(uint32_t type, const std::string& domain, const std::string& name) const
+    {
+        std::vector<size_t> ids = FindIds(type, domain, name, "");
+        return ids.empty() ? std::weak_ptr<T>() : targets_[ids.front()];
+    }
+
+    size_t GetTargetCount() const
+    {
+        return targets_.size();
+    }
+
+    size_t GetRuleCount() const
+    {
+        return ruleCount_;
+    }
+
+    uint64_t GetLookupCount() const
+    {
+        return lookupCount_.load(std::memory_order_relaxed);
+    }
+
+private:
+    struct DomainRoute {
+        std::unordered_map<std::string, std::vector<size_t>> includes;
+        std::vector<std::pair<size_t, std::unordered_set<std::string>>> excludes;
+    };
+
+    struct RouteNode {
+        std::vector<size_t> all;
+        std::unordered_map<std::string, std::vector<size_t>> names;
+        std::unordered_map<std::string, std::vector<size_t>> tags;
+        std::unordered_map<std::string, DomainRoute> domains;
+    };
+
+    void AddDomainRule(RouteNode& node, size_t id, const std::string& domain, const DomainRule& rule)
+    {
+        auto& domainRoute = node.domains[domain];
+        if (rule.filterType == DomainRule::INCLUDE) {
+            for (const auto& name : rule.eventlist) {
+                domainRoute.includes[name].emplace_back(id);
+            }
+        } else {
+            domainRoute.excludes.emplace_back(id, rule.eventlist);
+        }
+        ++ruleCount_;
+    }
+
+    static void CollectIds(const std::unordered_map<std::string, std::vector<size_t>>& idMap,
+        const std::string& key, std::vector<size_t>& ids)
+    {
+        if (idMap.empty()) {
+            return;
+        }
+        if (auto iter = idMap.find(key); iter != idMap.end()) {
+            ids.insert(ids.end(), iter->second.begin(), iter->second.end());
+        }
+    }
+
+    static void CollectIds(const RouteNode& node, const std::string& domain, const std::string& name,
+        const std::string& tag, std::vector<size_t>& ids)
+    {
+        ids.insert(ids.end(), node.all.begin(), node.all.end());
+        CollectIds(node.names, name, ids);
+        CollectIds(node.tags, tag, ids);
+        if (node.domains.empty()) {
+            return;
+        }
+        auto domainIter = node.domains.find(domain);
+        if (domainIter == node.domains.end()) {
+            return;
+        }
+        CollectIds(domainIter->second.includes, name, ids);
+        for (const auto& [id, excludeNames] : domainIter->second.excludes) {
+            if (excludeNames.find(name) == excludeNames.end()) {
+                ids.emplace_back(id);
+            }
+        }
+    }
+
+    std::vector<size_t> FindIds(uint32_t type, const std::string& domain, const std::string& name,
+        const std::string& tag) const
+    {
+        lookupCount_.fetch_add(1, std::memory_order_relaxed);
+        std::vector<size_t> ids;
+        if (auto iter = typeNodes_.find(type); iter != typeNodes_.end()) {
+            CollectIds(iter->second, domain, name, tag, ids);
+        }
+        CollectIds(anyTypeNode_, domain, name, tag, ids);
+
+        // a target matched by several rules is returned once
+        std::sort(ids.begin(), ids.end());
+        ids.erase(std::unique(ids.begin(), ids.end()), ids.end());
+        return ids;
+    }
+
+private:
+    std::vector<std::weak_ptr<T>> targets_;
+    std::unordered_map<uint32_t, RouteNode> typeNodes_;
+    RouteNode anyTypeNode_;
+    size_t ruleCount_ = 0;
+    mutable std::atomic<uint64_t> lookupCount_ { 0 };
+};
+} // namespace HiviewDFX
+} // namespace OHOS
+#endif // HIVIEW_CORE_EVENT_ROUTE_INDEX_H
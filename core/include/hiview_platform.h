@@ -22,6 +22,7 @@
 #include "dynamic_module.h"
 #include "event_dispatch_queue.h"
 #include "event_loop.h"
+#include "event_route_index.h"
 #include "event_source.h"
 #include "pipeline.h"
 #include "plugin.h"
@@ -70,6 +71,8 @@ public:
     void AddListenerInfo(uint32_t type, const std::string& name) override;
     std::vector<std::weak_ptr<EventListener>> GetListenerInfo(uint32_t type,
         const std::string& eventName, const std::string& domain) override;
+    std::shared_ptr<Pipeline> GetPipelineByEvent(const std::string& domain, const std::string& eventName);
+    void DumpRouteIndex(int fd);
 
     PipelineConfigMap& GetPipelineConfigMap()
     {
@@ -102,28 +105,6 @@ private:
         std::vector<uint32_t> messageTypes_;
         std::map<uint32_t, std::set<std::string>> eventsInfo_;
         std::map<uint32_t, std::map<std::string, DomainRule>> domainsInfo_;
-        bool Match(uint32_t type, const std::string& eventName, const std::string& domain)
-        {
-            auto it = std::find(messageTypes_.begin(), messageTypes_.end(), type);
-            if (it != messageTypes_.end()) {
-                return true;
-            }
-            auto itEventList = eventsInfo_.find(type);
-            if (itEventList != eventsInfo_.end()) {
-                auto eventList = itEventList->second;
-                if (eventList.find(eventName) != eventList.end()) {
-                    return true;
-                }
-            }
-            auto itDomainsInfo = domainsInfo_.find(type);
-            if (itDomainsInfo != domainsInfo_.end()) {
-                auto itDomainRule = itDomainsInfo->second.find(domain);
-                if (itDomainRule != itDomainsInfo->second.end()) {
-                    return itDomainRule->second.FindEvent(eventName);
-                }
-            }
-            return false;
-        }
     };
 
     struct DispatchInfo {
@@ -132,24 +113,6 @@ private:
         std::unordered_set<std::string> eventsInfo_;
         std::unordered_set<std::string> tagsInfo_;
         std::unordered_map<std::string, DomainRule> domainsInfo_;
-        bool Match(uint8_t type, const std::string& eventName, const std::string& tag,
-            const std::string& domain)
-        {
-            if (typesInfo_.find(type) != typesInfo_.end()) {
-                return true;
-            }
-            if (tagsInfo_.find(tag) != tagsInfo_.end()) {
-                return true;
-            }
-            if (eventsInfo_.find(eventName) != eventsInfo_.end()) {
-                return true;
-            }
-            auto itDomainRule = domainsInfo_.find(domain);
-            if (itDomainRule != domainsInfo_.end()) {
-                return itDomainRule->second.FindEvent(eventName);
-            }
-            return false;
-        }
     };
 
     void CreateWorkingDirectories(const std::string& platformConfigDir);
@@ -180,6 +143,10 @@ private:
     std::string SearchPluginBundle(const std::string& name) const;
     void AddWatchDog();
     void SaveStack();
+    void RebuildListenerRoute();
+    void RebuildDispatcherRoute();
+    void RebuildPipelineRoute();
+    void RemoveRouteInfo(std::shared_ptr<Plugin> plugin);
 
     bool isReady_;
     std::string defaultConfigDir_;
@@ -200,6 +167,19 @@ private:
     std::unordered_map<std::string, std::shared_ptr<ListenerInfo>> listeners_;
     std::unordered_map<std::string, std::shared_ptr<DispatchInfo>> dispatchers_;
     PipelineConfigMap pipelineRules_;
+
+    // routing indexes are rebuilt from the infos above and replaced as a whole on every change
+    struct RouteStat {
+        uint32_t buildCount = 0;
+        uint64_t buildCost = 0; // us
+    };
+    std::mutex routeMutex_;
+    std::shared_ptr<const EventRouteIndex<EventListener>> listenerRoute_;
+    std::shared_ptr<const EventRouteIndex<Plugin>> dispatcherRoute_;
+    std::shared_ptr<const EventRouteIndex<Pipeline>> pipelineRoute_;
+    RouteStat listenerRouteStat_;
+    RouteStat dispatcherRouteStat_;
+    RouteStat pipelineRouteStat_;
     std::vector<std::shared_ptr<Plugin>> eventSourceList_;
 
     // the max waited time before destroy plugin instance
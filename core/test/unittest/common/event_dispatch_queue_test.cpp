@@ -108,3 +108,35 @@ HWTEST_F(EventDispatchQueueTest, EventDispatchQueueCreateTest002, TestSize.Level
     unorderQueue->Stop();
     ASSERT_EQ(false, unorderQueue->IsRunning());
 }
+
+/**
+ * @tc.name: EventRouteIndexTest001
+ * @tc.desc: route unordered events to listeners through the routing index
+ * @tc.type: FUNC
+ * @tc.require: issueI9IA2M
+ */
+HWTEST_F(EventDispatchQueueTest, EventRouteIndexTest001, TestSize.Level3)
+{
+    const std::string listenerName = "route_listener";
+    const std::string testDomain = "TEST_DOMAIN";
+    HiviewPlatform platform;
+    auto listener = std::make_shared<ExtendEventListener>(listenerName);
+    platform.RegisterUnorderedEventListener(listener);
+    DomainRule domainRule;
+    domainRule.filterType = DomainRule::INCLUDE;
+    domainRule.eventlist = { TEST_EVENT_NAME };
+    platform.AddListenerInfo(Event::MessageType::SYS_EVENT, listenerName, {}, { { testDomain, domainRule } });
+
+    auto listeners = platform.GetListenerInfo(Event::MessageType::SYS_EVENT, TEST_EVENT_NAME, testDomain);
+    ASSERT_EQ(listeners.size(), 1);
+    ASSERT_EQ(listeners.front().lock(), listener);
+    ASSERT_TRUE(platform.GetListenerInfo(Event::MessageType::SYS_EVENT, TEST_MESSAGE, testDomain).empty());
+    ASSERT_TRUE(platform.GetListenerInfo(Event::MessageType::FAULT_EVENT, TEST_EVENT_NAME, testDomain).empty());
+
+    // a listener matched by several rules is returned once
+    platform.AddListenerInfo(Event::MessageType::SYS_EVENT, listenerName);
+    listeners = platform.GetListenerInfo(Event::MessageType::SYS_EVENT, TEST_EVENT_NAME, testDomain);
+    ASSERT_EQ(listeners.size(), 1);
+    listeners = platform.GetListenerInfo(Event::MessageType::SYS_EVENT, TEST_MESSAGE, testDomain);
+    ASSERT_EQ(listeners.size(), 1);
+}
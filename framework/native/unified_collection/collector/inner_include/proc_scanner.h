@@ -0,0 +1,130 @@
+/*
+ * Copyright (c) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef HIVIEW_FRAMEWORK_NATIVE_UNIFIED_COLLECTION_PROC_SCANNER_H
+#define HIVIEW_FRAMEWORK_NATIVE_UNIFIED_COLLECTION_PROC_SCANNER_H
+
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace OHOS {
+namespace HiviewDFX {
+namespace UCollectUtil {
+namespace ProcParser {
+bool ParseInt(std::string_view str, int64_t& value);
+int32_t ToInt32(int64_t value);
+std::string_view ParseProcNameFromCmdline(std::string_view content);
+std::string_view ParseProcNameFromStat(std::string_view content);
+std::string_view TrimLine(std::string_view content);
+
+/*
+ * Parse the lines formatted as "Key:   value kB" such as /proc/<pid>/smaps_rollup, /proc/<pid>/io and
+ * /proc/meminfo, the handler is called with the views of the key and the parsed value of each line.
+ */
+template<typename Handler>
+void ParseKeyValueLines(std::string_view content, Handler&& handler)
+{
+    while (!content.empty()) {
+        size_t lineEnd = content.find('\n');
+        std::string_view line = content.substr(0, lineEnd);
+        content = (lineEnd == std::string_view::npos) ? std::string_view() : content.substr(lineEnd + 1);
+        size_t keyEnd = line.find(':');
+        if (keyEnd == std::string_view::npos) {
+            continue;
+        }
+        int64_t value = 0;
+        if (!ParseInt(line.substr(keyEnd + 1), value)) {
+            value = 0;
+        }
+        handler(line.substr(0, keyEnd), value);
+    }
+}
+} // namespace ProcParser
+
+/*
+ * Reads the files of /proc/<pid>/ relative to a /proc directory fd into a buffer which is reused by
+ * all the reads, so a reader must not be shared by threads and a returned view is only valid until
+ * the next read. The default one reads relative to the /proc fd kept open by the process, for the
+ * collection of a single pid without a scanner.
+ */
+class ProcFileReader {
+public:
+    ProcFileReader();
+    explicit ProcFileReader(int procDirFd);
+    ~ProcFileReader() = default;
+
+public:
+    bool Read(int32_t pid, const char* fileName, std::string_view& content);
+    std::string ReadProcName(int32_t pid);
+
+private:
+    int procDirFd_;
+    std::vector<char> buffer_;
+};
+
+/*
+ * Walks the pid directories of /proc and hands each pid with a ProcFileReader to the collector,
+ * the pids are spread across threadNum threads when threadNum is greater than 1.
+ */
+class ProcScanner {
+public:
+    explicit ProcScanner(uint32_t threadNum = 1);
+    ~ProcScanner();
+    ProcScanner(const ProcScanner&) = delete;
+    ProcScanner& operator=(const ProcScanner&) = delete;
+
+public:
+    bool IsValid() const;
+    std::vector<int32_t> GetPids() const;
+    ProcFileReader CreateReader() const;
+
+    // datas are returned in the order of pids and those failed to be collected are dropped
+    template<typename T>
+    std::vector<T> Collect(const std::function<bool(int32_t, ProcFileReader&, T&)>& collector) const
+    {
+        std::vector<int32_t> pids = GetPids();
+        std::vector<T> datas(pids.size());
+        std::vector<uint8_t> succFlags(pids.size(), 0);
+        Scan(pids.size(), [&pids, &datas, &succFlags, &collector] (size_t index, ProcFileReader& reader) {
+            succFlags[index] = collector(pids[index], reader, datas[index]) ? 1 : 0;
+        });
+        size_t succCnt = 0;
+        for (size_t i = 0; i < datas.size(); ++i) {
+            if (succFlags[i] == 0) {
+                continue;
+            }
+            if (succCnt != i) {
+                datas[succCnt] = std::move(datas[i]);
+            }
+            ++succCnt;
+        }
+        datas.resize(succCnt);
+        return datas;
+    }
+
+private:
+    void Scan(size_t taskCnt, const std::function<void(size_t, ProcFileReader&)>& handler) const;
+
+private:
+    int procDirFd_ = -1;
+    uint32_t threadNum_ = 1;
+};
+} // namespace UCollectUtil
+} // namespace HiviewDFX
+} // namespace OHOS
+#endif // HIVIEW_FRAMEWORK_NATIVE_UNIFIED_COLLECTION_PROC_SCANNER_H
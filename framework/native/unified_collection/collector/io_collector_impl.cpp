@@ -15,6 +15,7 @@
 
 #include "io_collector_impl.h"
 
+#include <algorithm>
 #include <regex>
 
 #include <fcntl.h>
@@ -28,6 +29,7 @@
 #include "io_calculator.h"
 #include "io_decorator.h"
 #include "hiview_logger.h"
+#include "proc_scanner.h"
 #include "process_status.h"
 #include "string_util.h"
 #include "time_util.h"
@@ -55,6 +57,35 @@ const std::string PROC_IO_STATS_FILE_PREFIX = "proc_io_stats_";
 const std::string SYS_IO_STATS_FILE_PREFIX = "sys_io_stats_";
 const std::string PROC_DISKSTATS = "/proc/diskstats";
 const std::string COLLECTION_IO_PATH = "/data/log/hiview/unified_collection/io/";
+
+void ReadProcessIo(int32_t pid, ProcFileReader& reader, ProcessIo& processIO)
+{
+    processIO.pid = pid;
+    std::string_view content;
+    if (reader.Read(pid, "comm", content)) {
+        processIO.name = std::string(ProcParser::TrimLine(content));
+    }
+    if (!reader.Read(pid, "io", content)) {
+        return;
+    }
+    static const std::pair<std::string_view, int32_t ProcessIo::*> memberOfTypes[] = {
+        {"rchar", &ProcessIo::rchar},
+        {"wchar", &ProcessIo::wchar},
+        {"syscr", &ProcessIo::syscr},
+        {"syscw", &ProcessIo::syscw},
+        {"read_bytes", &ProcessIo::readBytes},
+        {"cancelled_write_bytes", &ProcessIo::cancelledWriteBytes},
+        {"write_bytes", &ProcessIo::writeBytes},
+    };
+    ProcParser::ParseKeyValueLines(content, [&processIO] (std::string_view type, int64_t value) {
+        for (const auto& [name, member] : memberOfTypes) {
+            if (name == type) {
+                processIO.*member = ProcParser::ToInt32(value);
+                return;
+            }
+        }
+    });
+}
 }
 
 std::shared_ptr<IoCollector> IoCollector::Create()
@@ -88,35 +119,8 @@ void IoCollectorImpl::InitProcIoData()
 CollectResult<ProcessIo> IoCollectorImpl::CollectProcessIo(int32_t pid)
 {
     CollectResult<ProcessIo> result;
-    std::string filename = PROC + std::to_string(pid) + IO;
-    std::string content;
-    FileUtil::LoadStringFromFile(filename, content);
-    std::vector<std::string> vec;
-    OHOS::SplitStr(content, "\n", vec);
-    ProcessIo& processIO = result.data;
-    processIO.pid = pid;
-    processIO.name = CommonUtils::GetProcNameByPid(pid);
-    std::string type;
-    int32_t value = 0;
-    for (const std::string &str : vec) {
-        if (CommonUtil::ParseTypeAndValue(str, type, value)) {
-            if (type == "rchar") {
-                processIO.rchar = value;
-            } else if (type == "wchar") {
-                processIO.wchar = value;
-            } else if (type == "syscr") {
-                processIO.syscr = value;
-            } else if (type == "syscw") {
-                processIO.syscw = value;
-            } else if (type == "read_bytes") {
-                processIO.readBytes = value;
-            } else if (type == "cancelled_write_bytes") {
-                processIO.cancelledWriteBytes = value;
-            } else if (type == "write_bytes") {
-                processIO.writeBytes = value;
-            }
-        }
-    }
+    ProcFileReader reader;
+    ReadProcessIo(pid, reader, result.data);
     result.retCode = UcError::SUCCESS;
     return result;
 }
@@ -500,31 +504,23 @@ void IoCollectorImpl::GetProcIoStats(std::vector<ProcessIoStats>& allProcIoStats
 
 void IoCollectorImpl::CalculateAllProcIoStats(uint64_t period, bool isUpdate)
 {
-    DIR *dir = opendir(PROC);
-    if (dir == nullptr) {
+    // the io file of a process is small, so the pids are scanned in the current thread with one reader
+    ProcScanner scanner;
+    if (!scanner.IsValid()) {
         HIVIEW_LOGE("open dir=%{public}s failed.", PROC);
         return;
     }
-
-    struct dirent *de = nullptr;
-    while ((de = readdir(dir)) != nullptr) {
-        if (de->d_type != DT_DIR) {
-            continue;
-        }
-        int32_t pid = StringUtil::StrToInt(std::string(de->d_name));
-        if (pid <= 0) {
-            continue;
-        }
-        auto collectProcIoResult = CollectProcessIo(pid);
-        if (collectProcIoResult.retCode == UcError::SUCCESS) {
-            CalculateProcIoStats(collectProcIoResult.data, pid, period);
-            if (isUpdate) {
-                procIoStatsMap_[pid].collectTime = currCollectProcIoTime_;
-                procIoStatsMap_[pid].preData = collectProcIoResult.data;
-            }
+    auto reader = scanner.CreateReader();
+    ProcessIo processIo;
+    for (int32_t pid : scanner.GetPids()) {
+        processIo = ProcessIo();
+        ReadProcessIo(pid, reader, processIo);
+        CalculateProcIoStats(processIo, pid, period);
+        if (isUpdate) {
+            procIoStatsMap_[pid].collectTime = currCollectProcIoTime_;
+            procIoStatsMap_[pid].preData = processIo;
         }
     }
-    closedir(dir);
 }
 
 bool IoCollectorImpl::ProcIoStatsFilter(const ProcessIoStats& stats)
@@ -33,6 +33,7 @@
 #include "file_util.h"
 #include "hiview_logger.h"
 #include "memory_decorator.h"
+#include "proc_scanner.h"
 #include "process_status.h"
 #include "string_util.h"
 #include "time_util.h"
@@ -52,6 +53,9 @@ DEFINE_LOG_TAG("UCollectUtil");
 std::mutex g_memMutex;
 const int NON_PC_APP_STATE = -1;
 const std::string DDR_CUR_FREQ = "/sys/class/devfreq/ddrfreq/cur_freq";
+constexpr char SMAPS_ROLLUP_FILE_NAME[] = "smaps_rollup";
+// reading smaps_rollup walks all the vmas of a process in kernel, so the processes are scanned in parallel
+constexpr uint32_t PROC_SCAN_THREAD_NUM = 4;
 
 static std::string GetCurrTimestamp()
 {
@@ -119,39 +123,6 @@ static bool WriteAIProcessMemToFile(std::string& filePath, const std::vector<AIP
     return true;
 }
 
-static bool GetSmapsFromProcPath(const std::string& procPath, ProcessMemory& procMem)
-{
-    std::string content;
-    if (!FileUtil::FileExists(procPath)) {
-        HIVIEW_LOGI("%{public}s is not exist, process exit.", procPath.c_str());
-        return false;
-    }
-    if (!FileUtil::LoadStringFromFile(procPath, content)) {
-        HIVIEW_LOGE("load string from %{public}s failed.", procPath.c_str());
-        return false;
-    }
-    std::stringstream ss(content);
-    std::string line;
-    unsigned rss = 0;
-    unsigned pss = 0;
-    unsigned swapPss = 0;
-
-    while (std::getline(ss, line)) {
-        unsigned temp;
-        if (sscanf_s(line.c_str(), "Rss: %u kB", &temp) == 1) {
-            rss += temp;
-        } else if (sscanf_s(line.c_str(), "Pss: %u kB", &temp) == 1) {
-            pss += temp;
-        } else if (sscanf_s(line.c_str(), "SwapPss: %u kB", &temp) == 1) {
-            swapPss += temp;
-        }
-    }
-    procMem.rss = static_cast<int32_t>(rss);
-    procMem.pss = static_cast<int32_t>(pss);
-    procMem.swapPss = static_cast<int32_t>(swapPss);
-    return true;
-}
-
 static bool ReadMemFromAILib(AIProcessMem memInfos[], int len, int& realSize)
 {
     std::string libName = "libai_mnt_client.so";
@@ -237,80 +208,55 @@ static CollectResult<std::string> CollectRawInfo(const std::string& filePath, co
     return result;
 }
 
-static void SetValueOfProcessMemory(ProcessMemory& processMemory, const std::string& attrName, int32_t value)
+static void SetValueOfProcessMemory(ProcessMemory& processMemory, std::string_view attrName, int32_t value)
 {
-    static std::map<std::string, std::function<void(ProcessMemory&, int32_t)>> assignFuncMap = {
-        {"Rss", [] (ProcessMemory& memory, int32_t value) {
-            memory.rss = value;
-        }},
-        {"Pss", [] (ProcessMemory& memory, int32_t value) {
-            memory.pss = value;
-        }},
-        {"Shared_Dirty", [] (ProcessMemory& memory, int32_t value) {
-            memory.sharedDirty = value;
-        }},
-        {"Private_Dirty", [] (ProcessMemory& memory, int32_t value) {
-            memory.privateDirty = value;
-        }},
-        {"SwapPss", [] (ProcessMemory& memory, int32_t value) {
-            memory.swapPss = value;
-        }},
-        {"Shared_Clean", [] (ProcessMemory& memory, int32_t value) {
-            memory.sharedClean = value;
-        }},
-        {"Private_Clean", [] (ProcessMemory& memory, int32_t value) {
-            memory.privateClean = value;
-        }},
+    static const std::pair<std::string_view, int32_t ProcessMemory::*> memberOfAttrs[] = {
+        {"Rss", &ProcessMemory::rss},
+        {"Pss", &ProcessMemory::pss},
+        {"Shared_Dirty", &ProcessMemory::sharedDirty},
+        {"Private_Dirty", &ProcessMemory::privateDirty},
+        {"SwapPss", &ProcessMemory::swapPss},
+        {"Shared_Clean", &ProcessMemory::sharedClean},
+        {"Private_Clean", &ProcessMemory::privateClean},
     };
-    auto iter = assignFuncMap.find(attrName);
-    if (iter == assignFuncMap.end() || iter->second == nullptr) {
-        HIVIEW_LOGD("%{public}s isn't defined in ProcessMemory.", attrName.c_str());
-        return;
+    for (const auto& [name, member] : memberOfAttrs) {
+        if (name == attrName) {
+            processMemory.*member = value;
+            return;
+        }
     }
-    iter->second(processMemory, value);
 }
 
-static void InitSmapsOfProcessMemory(const std::string& procDir, ProcessMemory& memory)
+static void InitSmapsOfProcessMemory(ProcFileReader& reader, ProcessMemory& memory)
 {
-    std::string smapsFilePath = procDir + SMAPS_ROLLUP;
-    std::string content;
-    if (!FileUtil::LoadStringFromFile(smapsFilePath, content)) {
-        HIVIEW_LOGW("failed to read smaps file:%{public}s.", smapsFilePath.c_str());
+    std::string_view content;
+    if (!reader.Read(memory.pid, SMAPS_ROLLUP_FILE_NAME, content)) {
+        HIVIEW_LOGW("failed to read smaps file of pid=%{public}d.", memory.pid);
         return;
     }
-    std::vector<std::string> vec;
-    OHOS::SplitStr(content, "\n", vec);
-    for (const std::string& str : vec) {
-        std::string attrName;
-        int32_t value = 0;
-        if (CommonUtil::ParseTypeAndValue(str, attrName, value)) {
-            SetValueOfProcessMemory(memory, attrName, value);
-        }
-    }
+    ProcParser::ParseKeyValueLines(content, [&memory] (std::string_view attrName, int64_t value) {
+        SetValueOfProcessMemory(memory, attrName, ProcParser::ToInt32(value));
+    });
 }
 
-static void InitAdjOfProcessMemory(const std::string& procDir, ProcessMemory& memory)
+static void InitAdjOfProcessMemory(ProcFileReader& reader, ProcessMemory& memory)
 {
-    std::string adjFilePath = procDir + "/oom_score_adj";
-    std::string content;
-    if (!FileUtil::LoadStringFromFile(adjFilePath, content)) {
-        HIVIEW_LOGW("failed to read adj file:%{public}s.", adjFilePath.c_str());
+    std::string_view content;
+    if (!reader.Read(memory.pid, "oom_score_adj", content)) {
+        HIVIEW_LOGW("failed to read adj file of pid=%{public}d.", memory.pid);
         return;
     }
-    if (!CommonUtil::StrToNum(content, memory.adj)) {
-        HIVIEW_LOGW("failed to translate \"%{public}s\" into number.", content.c_str());
+    if (int64_t adj = 0; ProcParser::ParseInt(content, adj)) {
+        memory.adj = ProcParser::ToInt32(adj);
+    } else {
+        HIVIEW_LOGW("failed to translate adj of pid=%{public}d into number.", memory.pid);
     }
 }
 
-static bool InitProcessMemory(int32_t pid, ProcessMemory& memory)
+static bool InitProcessMemory(int32_t pid, ProcFileReader& reader, ProcessMemory& memory)
 {
-    std::string procDir = PROC + std::to_string(pid);
-    if (!FileUtil::FileExists(procDir)) {
-        HIVIEW_LOGW("%{public}s isn't exist.", procDir.c_str());
-        return false;
-    }
     memory.pid = pid;
-    memory.name = CommonUtils::GetProcFullNameByPid(pid);
+    memory.name = reader.ReadProcName(pid);
     if (memory.name.empty()) {
         HIVIEW_LOGD("process name is empty, pid=%{public}d.", pid);
         return false;
@@ -320,8 +266,8 @@ static bool InitProcessMemory(int32_t pid, ProcessMemory& memory)
 #else
     memory.procState = NON_PC_APP_STATE;
 #endif
-    InitSmapsOfProcessMemory(procDir, memory);
-    InitAdjOfProcessMemory(procDir, memory);
+    InitSmapsOfProcessMemory(reader, memory);
+    InitAdjOfProcessMemory(reader, memory);
     return true;
 }
 
@@ -363,7 +309,8 @@ std::shared_ptr<MemoryCollector> MemoryCollector::Create()
 CollectResult<ProcessMemory> MemoryCollectorImpl::CollectProcessMemory(int32_t pid)
 {
     CollectResult<ProcessMemory> result;
-    result.retCode = InitProcessMemory(pid, result.data) ? UcError::SUCCESS : UcError::READ_FAILED;
+    ProcFileReader reader;
+    result.retCode = InitProcessMemory(pid, reader, result.data) ? UcError::SUCCESS : UcError::READ_FAILED;
     return result;
 }
 
@@ -404,23 +351,12 @@ CollectResult<std::string> MemoryCollectorImpl::ExportMemView()
 CollectResult<std::vector<ProcessMemory>> MemoryCollectorImpl::CollectAllProcessMemory()
 {
     CollectResult<std::vector<ProcessMemory>> result;
-    std::vector<ProcessMemory> procMemoryVec;
-    std::vector<std::string> procFiles;
-    FileUtil::GetDirFiles(PROC, procFiles, false);
-    for (auto& procFile : procFiles) {
-        std::string fileName = FileUtil::ExtractFileName(procFile);
-        int value = 0;
-        if (!StringUtil::StrToInt(fileName, value)) {
-            HIVIEW_LOGD("%{public}s is not num string, value=%{public}d.", fileName.c_str(), value);
-            continue;
-        }
-        ProcessMemory procMemory;
-        if (!InitProcessMemory(value, procMemory)) {
-            continue;
-        }
-        procMemoryVec.emplace_back(procMemory);
+    ProcScanner scanner(PROC_SCAN_THREAD_NUM);
+    if (!scanner.IsValid()) {
+        result.retCode = UcError::READ_FAILED;
+        return result;
     }
-    result.data = procMemoryVec;
+    result.data = scanner.Collect<ProcessMemory>(InitProcessMemory);
     result.retCode = UcError::SUCCESS;
     return result;
 }
@@ -0,0 +1,285 @@
+/*
+ * Copyright (c) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "proc_scanner.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <charconv>
+#include <cstring>
+#include <dirent.h>
+#include <fcntl.h>
+#include <limits>
+#include <unistd.h>
+
+#include "ffrt.h"
+#include "hiview_logger.h"
+
+namespace OHOS {
+namespace HiviewDFX {
+namespace UCollectUtil {
+DEFINE_LOG_TAG("UCollectUtil-ProcScanner");
+namespace {
+constexpr size_t INIT_BUFFER_SIZE = 4096;
+constexpr size_t MAX_BUFFER_SIZE = 4 * 1024 * 1024; // 4M
+constexpr size_t MAX_PATH_LEN = 64;
+constexpr uint32_t MAX_THREAD_NUM = 8;
+constexpr size_t MIN_TASK_CNT_PER_THREAD = 16;
+
+bool IsPidDirName(const char* name)
+{
+    if (name == nullptr || *name == '\0') {
+        return false;
+    }
+    for (const char* ch = name; *ch != '\0'; ++ch) {
+        if (*ch < '0' || *ch > '9') {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool BuildRelativePath(int32_t pid, const char* fileName, char (&path)[MAX_PATH_LEN])
+{
+    // "<pid>/<fileName>" relative to the fd of /proc
+    auto [end, ec] = std::to_chars(path, path + MAX_PATH_LEN, pid);
+    if (ec != std::errc()) {
+        return false;
+    }
+    size_t pos = static_cast<size_t>(end - path);
+    path[pos++] = '/';
+    for (const char* ch = fileName; *ch != '\0'; ++ch) {
+        if (pos >= MAX_PATH_LEN - 1) {
+            return false;
+        }
+        path[pos++] = *ch;
+    }
+    path[pos] = '\0';
+    return true;
+}
+
+int GetSharedProcDirFd()
+{
+    // opened once and kept open for the lifetime of the process
+    static int procDirFd = [] {
+        int fd = open("/proc", O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+        if (fd < 0) {
+            HIVIEW_LOGE("failed to open /proc, errno=%{public}d", errno);
+        }
+        return fd;
+    }();
+    return procDirFd;
+}
+}
+
+namespace ProcParser {
+bool ParseInt(std::string_view str, int64_t& value)
+{
+    size_t start = str.find_first_not_of(" \t");
+    if (start == std::string_view::npos) {
+        return false;
+    }
+    str.remove_prefix(start);
+    if (!str.empty() && str.front() == '+') {
+        str.remove_prefix(1);
+    }
+    auto [ptr, ec] = std::from_chars(str.data(), str.data() + str.size(), value);
+    return ec == std::errc();
+}
+
+int32_t ToInt32(int64_t value)
+{
+    // saturate as the stream based parsing did
+    return static_cast<int32_t>(std::clamp<int64_t>(value, std::numeric_limits<int32_t>::min(),
+        std::numeric_limits<int32_t>::max()));
+}
+
+std::string_view ParseProcNameFromCmdline(std::string_view content)
+{
+    // same as the name parsed from cmdline by CommonUtils::GetProcFullNameByPid
+    content = content.substr(0, content.find('\n'));
+    content = content.substr(0, content.find('\0'));
+    size_t nameStart = content.rfind('/');
+    return (nameStart == std::string_view::npos) ? content : content.substr(nameStart + 1);
+}
+
+std::string_view ParseProcNameFromStat(std::string_view content)
+{
+    // for the format '40 (hiview) I ...'
+    size_t nameStart = content.find('(');
+    size_t nameEnd = content.find(')');
+    if (nameStart == std::string_view::npos || nameEnd == std::string_view::npos || nameEnd <= nameStart + 1) {
+        return std::string_view();
+    }
+    return content.substr(nameStart + 1, nameEnd - nameStart - 1);
+}
+
+std::string_view TrimLine(std::string_view content)
+{
+    size_t end = content.find_last_not_of(" \n\r\t");
+    return (end == std::string_view::npos) ? std::string_view() : content.substr(0, end + 1);
+}
+} // namespace ProcParser
+
+ProcFileReader::ProcFileReader() : ProcFileReader(GetSharedProcDirFd())
+{}
+
+ProcFileReader::ProcFileReader(int procDirFd) : procDirFd_(procDirFd)
+{
+    buffer_.resize(INIT_BUFFER_SIZE);
+}
+
+bool ProcFileReader::Read(int32_t pid, const char* fileName, std::string_view& content)
+{
+    char path[MAX_PATH_LEN] = {0};
+    if (procDirFd_ < 0 || fileName == nullptr || !BuildRelativePath(pid, fileName, path)) {
+        return false;
+    }
+    int fd = openat(procDirFd_, path, O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        return false;
+    }
+    // the size of files in /proc is always 0, so read until the end of the file
+    size_t len = 0;
+    bool isSucc = true;
+    while (true) {
+        if (len == buffer_.size()) {
+            if (buffer_.size() >= MAX_BUFFER_SIZE) {
+                break;
+            }
+            buffer_.resize(buffer_.size() * 2); // 2: double the buffer
+        }
+        ssize_t ret = read(fd, buffer_.data() + len, buffer_.size() - len);
+        if (ret < 0 && errno == EINTR) {
+            continue;
+        }
+        if (ret <= 0) {
+            isSucc = (ret == 0);
+            break;
+        }
+        len += static_cast<size_t>(ret);
+    }
+    int readErrno = errno;
+    close(fd);
+    errno = readErrno;
+    content = std::string_view(buffer_.data(), len);
+    return isSucc;
+}
+
+std::string ProcFileReader::ReadProcName(int32_t pid)
+{
+    std::string_view content;
+    errno = 0;
+    if (Read(pid, "cmdline", content)) {
+        if (auto name = ProcParser::ParseProcNameFromCmdline(content); !name.empty()) {
+            return std::string(name);
+        }
+    }
+    if (errno == ESRCH || errno == ENOENT) { // the process has exited
+        return "";
+    }
+    if (!Read(pid, "stat", content)) {
+        return "";
+    }
+    return std::string(ProcParser::ParseProcNameFromStat(content));
+}
+
+ProcScanner::ProcScanner(uint32_t threadNum) : threadNum_(std::clamp<uint32_t>(threadNum, 1, MAX_THREAD_NUM))
+{
+    procDirFd_ = open("/proc", O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+    if (procDirFd_ < 0) {
+        HIVIEW_LOGE("failed to open /proc, errno=%{public}d", errno);
+    }
+}
+
+ProcScanner::~ProcScanner()
+{
+    if (procDirFd_ >= 0) {
+        close(procDirFd_);
+    }
+}
+
+bool ProcScanner::IsValid() const
+{
+    return procDirFd_ >= 0;
+}
+
+std::vector<int32_t> ProcScanner::GetPids() const
+{
+    std::vector<int32_t> pids;
+    if (procDirFd_ < 0) {
+        return pids;
+    }
+    // the dir stream takes the ownership of the fd, so a duplicated one is used
+    int dirFd = dup(procDirFd_);
+    if (dirFd < 0) {
+        return pids;
+    }
+    DIR* dir = fdopendir(dirFd);
+    if (dir == nullptr) {
+        close(dirFd);
+        return pids;
+    }
+    rewinddir(dir);
+    struct dirent* ent = nullptr;
+    while ((ent = readdir(dir)) != nullptr) {
+        if ((ent->d_type != DT_DIR && ent->d_type != DT_UNKNOWN) || !IsPidDirName(ent->d_name)) {
+            continue;
+        }
+        int32_t pid = 0;
+        auto [ptr, ec] = std::from_chars(ent->d_name, ent->d_name + strlen(ent->d_name), pid);
+        if (ec == std::errc() && pid > 0) {
+            pids.emplace_back(pid);
+        }
+    }
+    closedir(dir);
+    return pids;
+}
+
+ProcFileReader ProcScanner::CreateReader() const
+{
+    return ProcFileReader(procDirFd_);
+}
+
+void ProcScanner::Scan(size_t taskCnt, const std::function<void(size_t, ProcFileReader&)>& handler) const
+{
+    size_t threadNum = std::min<size_t>(threadNum_, taskCnt / MIN_TASK_CNT_PER_THREAD);
+    if (threadNum <= 1) {
+        ProcFileReader reader(procDirFd_);
+        for (size_t i = 0; i < taskCnt; ++i) {
+            handler(i, reader);
+        }
+        return;
+    }
+    std::atomic<size_t> nextTask = 0;
+    auto worker = [this, taskCnt, &nextTask, &handler] {
+        ProcFileReader reader(procDirFd_);
+        for (size_t i = nextTask++; i < taskCnt; i = nextTask++) {
+            handler(i, reader);
+        }
+    };
+    std::vector<ffrt::dependence> workers;
+    workers.reserve(threadNum - 1);
+    for (size_t i = 1; i < threadNum; ++i) {
+        workers.emplace_back(ffrt::submit_h(worker, {}, {},
+            ffrt::task_attr().name("dft_proc_scan").qos(ffrt::qos_default)));
+    }
+    worker(); // the current thread works as well
+    ffrt::wait(workers);
+}
+} // namespace UCollectUtil
+} // namespace HiviewDFX
+} // namespace OHOS
@@ -31,6 +31,8 @@ public:
     void SaveToStore(std::shared_ptr<SysEvent> event) const;
     void StartCheckStoreTask(std::shared_ptr<EventLoop> looper);
     void CheckStore();
+    void CommitStore();
+    void DumpCommitStat(int fd);
 }; // SysEventDbMgr
 } // namespace HiviewDFX
 } // namespace OHOS
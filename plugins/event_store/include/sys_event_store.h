@@ -16,6 +16,8 @@
 #ifndef HIVIEW_PLUGINS_EVENT_SERVICE_INCLUDE_SYS_EVENT_SERVICE_H
 #define HIVIEW_PLUGINS_EVENT_SERVICE_INCLUDE_SYS_EVENT_SERVICE_H
 #include <memory>
+#include <string>
+#include <vector>
 
 #include "event.h"
 #include "plugin.h"
@@ -30,6 +32,7 @@ public:
     void OnLoad() override;
     void OnUnload() override;
     bool OnEvent(std::shared_ptr<Event>& event) override;
+    void Dump(int fd, const std::vector<std::string>& cmds) override;
 
 private:
     std::shared_ptr<SysEvent> Convert2SysEvent(std::shared_ptr<Event>& event);
@@ -16,6 +16,7 @@
 #include "sys_event_db_mgr.h"
 
 #include <cinttypes>
+#include <cstdio>
 #include <ctime>
 #include <string>
 
@@ -45,6 +46,40 @@ void SysEventDbMgr::StartCheckStoreTask(std::shared_ptr<EventLoop> looper)
     auto statusTask = std::bind(&SysEventDbMgr::CheckStore, this);
     int delay = TimeUtil::SECONDS_PER_HOUR; // 1 hour
     looper->AddTimerEvent(nullptr, nullptr, statusTask, delay, true);
+
+    // flush the events pending for group commit once their latency bound is reached
+    EventStore::GroupCommitStat commitStat;
+    if (SysEventDao::GetCommitStat(commitStat)) {
+        HIVIEW_LOGI("init group commit task");
+        auto commitTask = [] {
+            SysEventDao::Commit(false);
+        };
+        constexpr uint64_t commitCheckInterval = 1; // 1s
+        looper->AddTimerEvent(nullptr, nullptr, commitTask, commitCheckInterval, true);
+    }
+}
+
+void SysEventDbMgr::CommitStore()
+{
+    if (int ret = SysEventDao::Commit(); ret != DOC_STORE_SUCCESS) {
+        HIVIEW_LOGW("failed to commit store, ret=%{public}d", ret);
+    }
+}
+
+void SysEventDbMgr::DumpCommitStat(int fd)
+{
+    EventStore::GroupCommitStat stat;
+    if (!SysEventDao::GetCommitStat(stat)) {
+        dprintf(fd, "group commit is disabled\n");
+        return;
+    }
+    dprintf(fd, "group commit: commit_count=%" PRIu64 ", event_count=%" PRIu64 ", byte_count=%" PRIu64
+        ", avg_batch_events=%.2f, max_batch_events=%" PRIu64 ", avg_latency=%.2fus, max_latency=%" PRIu64 "us"
+        ", fail_count=%" PRIu64 "\n",
+        stat.commitCnt, stat.eventCnt, stat.byteCnt,
+        (stat.commitCnt == 0) ? 0.0 : (static_cast<double>(stat.eventCnt) / stat.commitCnt), stat.maxBatchEventCnt,
+        (stat.commitCnt == 0) ? 0.0 : (static_cast<double>(stat.totalLatency) / stat.commitCnt), stat.maxLatency,
+        stat.failCnt);
 }
 
 void SysEventDbMgr::CheckStore()
@@ -62,6 +62,12 @@ void SysEventStore::OnUnload()
 {
     HIVIEW_LOGI("sys event service unload");
     EventExportEngine::GetInstance().Stop();
+    sysEventDbMgr_->CommitStore();
+}
+
+void SysEventStore::Dump(int fd, const std::vector<std::string>& cmds)
+{
+    sysEventDbMgr_->DumpCommitStat(fd);
 }
 
 bool SysEventStore::IsNeedBackup(const std::string& dateStr)
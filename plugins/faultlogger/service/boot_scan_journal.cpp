@@ -0,0 +1,96 @@
+/*
+ * Copyright (c) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "boot_scan_journal.h"
+
+#include <cstdio>
+#include <sstream>
+
+#include "file_util.h"
+#include "hiview_logger.h"
+
+namespace OHOS {
+namespace HiviewDFX {
+DEFINE_LOG_LABEL(0xD002D11, "BootScanJournal");
+namespace {
+constexpr int64_t SEC_TO_NANOSEC = 1000000000;
+constexpr char JOURNAL_VERSION[] = "v1";
+}
+
+BootScanJournal::Record BootScanJournal::MakeRecord(const struct stat& fileStat)
+{
+    Record record;
+    record.size = static_cast<int64_t>(fileStat.st_size);
+    record.mtimeNs = static_cast<int64_t>(fileStat.st_mtim.tv_sec) * SEC_TO_NANOSEC + fileStat.st_mtim.tv_nsec;
+    return record;
+}
+
+bool BootScanJournal::Load()
+{
+    lastRecords_.clear();
+    std::string content;
+    if (!FileUtil::FileExists(path_) || !FileUtil::LoadStringFromFile(path_, content)) {
+        return false;
+    }
+    std::istringstream stream(content);
+    std::string version;
+    if (!std::getline(stream, version) || version != JOURNAL_VERSION) {
+        HIVIEW_LOGW("unknown version of journal %{public}s, scan all files", path_.c_str());
+        return false;
+    }
+    uint64_t inode = 0;
+    Record record;
+    while (stream >> inode >> record.size >> record.mtimeNs) {
+        lastRecords_[inode] = record;
+    }
+    return true;
+}
+
+bool BootScanJournal::Save() const
+{
+    std::string content = std::string(JOURNAL_VERSION) + "\n";
+    for (const auto& record : currentRecords_) {
+        content.append(std::to_string(record.first)).append(" ")
+            .append(std::to_string(record.second.size)).append(" ")
+            .append(std::to_string(record.second.mtimeNs)).append("\n");
+    }
+    // write aside and rename, a journal broken by a power loss would skip the unprocessed files forever
+    std::string tempPath = path_ + ".tmp";
+    if (!FileUtil::SaveStringToFile(tempPath, content) || rename(tempPath.c_str(), path_.c_str()) != 0) {
+        HIVIEW_LOGE("failed to save journal %{public}s", path_.c_str());
+        return false;
+    }
+    return true;
+}
+
+bool BootScanJournal::IsProcessed(const struct stat& fileStat)
+{
+    auto iter = lastRecords_.find(static_cast<uint64_t>(fileStat.st_ino));
+    if (iter == lastRecords_.end()) {
+        return false;
+    }
+    auto record = MakeRecord(fileStat);
+    if (iter->second.size != record.size || iter->second.mtimeNs != record.mtimeNs) {
+        return false;
+    }
+    currentRecords_[iter->first] = record;
+    return true;
+}
+
+void BootScanJournal::MarkProcessed(const struct stat& fileStat)
+{
+    currentRecords_[static_cast<uint64_t>(fileStat.st_ino)] = MakeRecord(fileStat);
+}
+} // namespace HiviewDFX
+} // namespace OHOS
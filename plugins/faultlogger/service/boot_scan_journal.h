@@ -0,0 +1,56 @@
+/*
+ * Copyright (c) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef HIVIEWDFX_HIVIEW_FAULTLOGGER_BOOT_SCAN_JOURNAL_H
+#define HIVIEWDFX_HIVIEW_FAULTLOGGER_BOOT_SCAN_JOURNAL_H
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+
+#include <sys/stat.h>
+
+namespace OHOS {
+namespace HiviewDFX {
+/*
+ * Records the temp fault logs handled by the boot scan. A file is identified by its inode, size and mtime,
+ * so an unchanged file is skipped on the next boot without being parsed again, while a file which is
+ * rewritten or replaced under the same name is scanned again. Only the files seen in the latest scan are
+ * kept when saving, so the journal never outgrows the temp folder.
+ */
+class BootScanJournal {
+public:
+    explicit BootScanJournal(const std::string& path) : path_(path) {};
+    bool Load();
+    bool Save() const;
+    bool IsProcessed(const struct stat& fileStat);
+    void MarkProcessed(const struct stat& fileStat);
+    size_t GetRecordCount() const
+    {
+        return currentRecords_.size();
+    }
+
+private:
+    struct Record {
+        int64_t size = 0;
+        int64_t mtimeNs = 0;
+    };
+    static Record MakeRecord(const struct stat& fileStat);
+
+    std::string path_;
+    std::unordered_map<uint64_t, Record> lastRecords_;
+    std::unordered_map<uint64_t, Record> currentRecords_;
+};
+} // namespace HiviewDFX
+} // namespace OHOS
+#endif // HIVIEWDFX_HIVIEW_FAULTLOGGER_BOOT_SCAN_JOURNAL_H
@@ -0,0 +1,133 @@
+/*
+ * Copyright (c) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "fault_rate_limiter.h"
+
+#include <cinttypes>
+
+#include <unistd.h>
+
+#include "hiview_logger.h"
+
+namespace OHOS {
+namespace HiviewDFX {
+DEFINE_LOG_LABEL(0xD002D11, "FaultRateLimiter");
+
+void FaultRateLimiter::SetBudget(int32_t faultType, const RateLimitBudget& budget)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto& limiter = limiters_[faultType];
+    if (limiter.budget.keyType != budget.keyType || limiter.budget.windowSec != budget.windowSec) {
+        // windows of the old budget are keyed or queued differently, start over
+        limiter.windows.clear();
+        limiter.expiries.clear();
+    }
+    limiter.budget = budget;
+}
+
+void FaultRateLimiter::RemoveBudget(int32_t faultType)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    limiters_.erase(faultType);
+}
+
+FaultRateLimiter::WindowKey FaultRateLimiter::MakeKey(const RateLimitBudget& budget, int32_t pid, int32_t uid,
+    const std::string& module)
+{
+    WindowKey key;
+    switch (budget.keyType) {
+        case RateLimitKeyType::UID:
+            key.id = uid;
+            break;
+        case RateLimitKeyType::MODULE:
+            key.module = module;
+            break;
+        default:
+            key.id = pid;
+            break;
+    }
+    return key;
+}
+
+void FaultRateLimiter::Expire(TypeLimiter& limiter, uint64_t nowSec)
+{
+    while (!limiter.expiries.empty() && limiter.expiries.front().time <= nowSec) {
+        limiter.windows.erase(limiter.expiries.front().key);
+        limiter.expiries.pop_front();
+    }
+}
+
+bool FaultRateLimiter::Check(int32_t faultType, int32_t pid, int32_t uid, const std::string& module,
+    uint64_t nowSec)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto iter = limiters_.find(faultType);
+    if (iter == limiters_.end()) {
+        return true;
+    }
+    auto& limiter = iter->second;
+    Expire(limiter, nowSec);
+
+    WindowKey key = MakeKey(limiter.budget, pid, uid, module);
+    auto result = limiter.windows.emplace(key, Window());
+    auto& window = result.first->second;
+    if (result.second) {
+        // windows of one type have the same length, so the queue stays ordered by expiry time
+        limiter.expiries.push_back({nowSec + limiter.budget.windowSec, std::move(key)});
+    }
+    if (window.count >= limiter.budget.maxCount) {
+        limiter.stat.suppressed++;
+        HIVIEW_LOGW("fault type:%{public}d pid:%{public}d uid:%{public}d is suppressed, %{public}u in %{public}us",
+            faultType, pid, uid, window.count, limiter.budget.windowSec);
+        return false;
+    }
+    window.count++;
+    limiter.stat.passed++;
+    return true;
+}
+
+std::map<int32_t, RateLimitStat> FaultRateLimiter::GetStats() const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::map<int32_t, RateLimitStat> stats;
+    for (const auto& limiter : limiters_) {
+        stats[limiter.first] = limiter.second.stat;
+    }
+    return stats;
+}
+
+size_t FaultRateLimiter::GetTrackedKeyCount() const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    size_t count = 0;
+    for (const auto& limiter : limiters_) {
+        count += limiter.second.windows.size();
+    }
+    return count;
+}
+
+void FaultRateLimiter::Dump(int fd) const
+{
+    static const char* const KEY_TYPE_NAMES[] = {"pid", "uid", "module"};
+    std::lock_guard<std::mutex> lock(mutex_);
+    dprintf(fd, "Fault rate limit:\n");
+    for (const auto& limiter : limiters_) {
+        const auto& budget = limiter.second.budget;
+        dprintf(fd, "type:%d key:%s budget:%u/%us keys:%zu passed:%" PRIu64 " suppressed:%" PRIu64 "\n",
+            limiter.first, KEY_TYPE_NAMES[static_cast<int>(budget.keyType)], budget.maxCount, budget.windowSec,
+            limiter.second.windows.size(), limiter.second.stat.passed, limiter.second.stat.suppressed);
+    }
+}
+} // namespace HiviewDFX
+} // namespace OHOS
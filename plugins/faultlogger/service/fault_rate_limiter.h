@@ -0,0 +1,95 @@
+/*
+ * Copyright (c) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef HIVIEWDFX_HIVIEW_FAULT_RATE_LIMITER_H
+#define HIVIEWDFX_HIVIEW_FAULT_RATE_LIMITER_H
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+namespace OHOS {
+namespace HiviewDFX {
+enum class RateLimitKeyType {
+    PID = 0,
+    UID,
+    MODULE,
+};
+
+struct RateLimitBudget {
+    RateLimitKeyType keyType = RateLimitKeyType::PID;
+    uint32_t windowSec = 60; // 60 : length of one limiting window in seconds
+    uint32_t maxCount = 1; // faults passed in one window of a key, the rest are suppressed
+};
+
+struct RateLimitStat {
+    uint64_t passed = 0;
+    uint64_t suppressed = 0;
+};
+
+/*
+ * Limits the fault logs of a fault type within a fixed window per pid, uid or module. Every window is queued
+ * by its expiry time when it starts, so the expired keys are dropped from the head of the queue instead of
+ * walking the whole table on each fault.
+ */
+class FaultRateLimiter {
+public:
+    void SetBudget(int32_t faultType, const RateLimitBudget& budget);
+    void RemoveBudget(int32_t faultType);
+    bool Check(int32_t faultType, int32_t pid, int32_t uid, const std::string& module, uint64_t nowSec);
+    std::map<int32_t, RateLimitStat> GetStats() const;
+    size_t GetTrackedKeyCount() const;
+    void Dump(int fd) const;
+
+private:
+    struct Window {
+        uint32_t count = 0;
+    };
+    // pid or uid as the id, or the module name, all keys of a type limiter are of the key type of its budget
+    struct WindowKey {
+        int32_t id = 0;
+        std::string module;
+        bool operator==(const WindowKey& other) const
+        {
+            return id == other.id && module == other.module;
+        }
+    };
+    struct WindowKeyHash {
+        size_t operator()(const WindowKey& key) const
+        {
+            return key.module.empty() ? std::hash<int32_t>()(key.id) : std::hash<std::string>()(key.module);
+        }
+    };
+    struct Expiry {
+        uint64_t time;
+        WindowKey key;
+    };
+    struct TypeLimiter {
+        RateLimitBudget budget;
+        std::unordered_map<WindowKey, Window, WindowKeyHash> windows;
+        std::deque<Expiry> expiries;
+        RateLimitStat stat;
+    };
+    static WindowKey MakeKey(const RateLimitBudget& budget, int32_t pid, int32_t uid, const std::string& module);
+    static void Expire(TypeLimiter& limiter, uint64_t nowSec);
+
+    mutable std::mutex mutex_;
+    std::map<int32_t, TypeLimiter> limiters_;
+};
+} // namespace HiviewDFX
+} // namespace OHOS
+#endif // HIVIEWDFX_HIVIEW_FAULT_RATE_LIMITER_H
@@ -16,9 +16,14 @@
 
 #include <algorithm>
 #include <cinttypes>
+#include <climits>
 #include <list>
+#include <map>
 #include <mutex>
 #include <string>
+#include <unordered_set>
+
+#include <unistd.h>
 
 #include "faultlog_info.h"
 #include "faultlog_util.h"
@@ -41,6 +46,43 @@ static const std::vector<std::string> QUERY_ITEMS = {
     "time_", "name_", "uid_", "pid_", "MODULE", "REASON", "SUMMARY", "LOG_PATH", "FAULT_TYPE"
 };
 static const std::string LOG_PATH_BASE = "/data/log/faultlog/faultlogger/";
+constexpr int MAX_BATCH_QUERY_NUM = 10000;
+constexpr int MAX_INDEX_NUM = 1000;
+const std::vector<int32_t> INDEXED_FAULT_TYPES = {
+    FaultLogType::CPP_CRASH, FaultLogType::JS_CRASH, FaultLogType::APP_FREEZE,
+    FaultLogType::SYS_FREEZE, FaultLogType::SYS_WARNING, FaultLogType::RUST_PANIC
+};
+constexpr uint32_t PID_SHIFT = 32;
+uint64_t MakeFaultKey(int64_t pid, int64_t uid)
+{
+    return (static_cast<uint64_t>(static_cast<uint32_t>(pid)) << PID_SHIFT) | static_cast<uint32_t>(uid);
+}
+
+bool IsWrittenByHiview(const SysEvent& sysEvent)
+{
+    // the same fields as matched by the store queries, faults written by hiview keep the ids of the faulting
+    // process even if they are 0, the others are identified by the process writing them
+    return sysEvent.domain_ == HiSysEvent::Domain::RELIABILITY;
+}
+
+void ParseFaultLogInfoFromEvent(SysEvent& sysEvent, FaultLogInfo& info)
+{
+    constexpr int64_t DEFAULT_INT_VALUE = 0;
+    info.time = static_cast<int64_t>(std::atoll(sysEvent.GetEventValue("HAPPEN_TIME").c_str()));
+    if (info.time == DEFAULT_INT_VALUE) {
+        info.time = sysEvent.GetEventIntValue("HAPPEN_TIME") != DEFAULT_INT_VALUE?
+                    sysEvent.GetEventIntValue("HAPPEN_TIME") : sysEvent.GetEventIntValue("time_");
+    }
+    bool isWrittenByHiview = IsWrittenByHiview(sysEvent);
+    info.pid = sysEvent.GetEventIntValue(isWrittenByHiview ? "PID" : "pid_");
+    info.id = sysEvent.GetEventIntValue(isWrittenByHiview ? "UID" : "uid_");
+    StringUtil::ConvertStringTo<int32_t>(sysEvent.GetEventValue("FAULT_TYPE"), info.faultLogType);
+    info.module = sysEvent.GetEventValue("MODULE");
+    info.reason = sysEvent.GetEventValue("REASON");
+    info.summary = StringUtil::UnescapeJsonStringValue(sysEvent.GetEventValue("SUMMARY"));
+    info.logPath = LOG_PATH_BASE + GetFaultLogName(info);
+}
+
 bool ParseFaultLogInfoFromJson(std::shared_ptr<EventRaw::RawData> rawData, FaultLogInfo& info)
 {
     if (rawData == nullptr) {
@@ -50,27 +92,13 @@ bool ParseFaultLogInfoFromJson(std::shared_ptr<EventRaw::RawData> rawData, Fault
     auto sysEvent = std::make_unique<SysEvent>("FaultLogDatabase", nullptr, rawData);
     constexpr string::size_type FIRST_200_BYTES = 200;
     HIVIEW_LOGI("parse FaultLogInfo from %{public}s.", sysEvent->AsJsonStr().substr(0, FIRST_200_BYTES).c_str());
-    constexpr int64_t DEFAULT_INT_VALUE = 0;
-    info.time = static_cast<int64_t>(std::atoll(sysEvent->GetEventValue("HAPPEN_TIME").c_str()));
-    if (info.time == DEFAULT_INT_VALUE) {
-        info.time = sysEvent->GetEventIntValue("HAPPEN_TIME") != DEFAULT_INT_VALUE?
-                    sysEvent->GetEventIntValue("HAPPEN_TIME") : sysEvent->GetEventIntValue("time_");
-    }
-    info.pid = sysEvent->GetEventIntValue("PID") != DEFAULT_INT_VALUE ?
-               sysEvent->GetEventIntValue("PID") : sysEvent->GetEventIntValue("pid_");
-
-    info.id = sysEvent->GetEventIntValue("UID") != DEFAULT_INT_VALUE ?
-              sysEvent->GetEventIntValue("UID") : sysEvent->GetEventIntValue("uid_");
-    info.faultLogType = static_cast<int32_t>(std::stoi(sysEvent->GetEventValue("FAULT_TYPE").c_str()));
-    info.module = sysEvent->GetEventValue("MODULE");
-    info.reason = sysEvent->GetEventValue("REASON");
-    info.summary = StringUtil::UnescapeJsonStringValue(sysEvent->GetEventValue("SUMMARY"));
-    info.logPath = LOG_PATH_BASE + GetFaultLogName(info);
+    ParseFaultLogInfoFromEvent(*sysEvent, info);
     return true;
 }
 }
 
-FaultLogDatabase::FaultLogDatabase(const std::shared_ptr<EventLoop>& eventLoop) : eventLoop_(eventLoop) {}
+FaultLogDatabase::FaultLogDatabase(const std::shared_ptr<EventLoop>& eventLoop)
+    : eventLoop_(eventLoop), index_(MAX_INDEX_NUM), batchQueryLimit_(MAX_BATCH_QUERY_NUM) {}
 
 void FaultLogDatabase::SaveFaultLogInfo(FaultLogInfo& info)
 {
@@ -86,6 +114,8 @@ void FaultLogDatabase::SaveFaultLogInfo(FaultLogInfo& info)
         HIVIEW_LOGE("eventLoop_ is not inited.");
         return;
     }
+    // keyed by the PID and UID written below, so the faults of root processes stay under uid 0
+    index_.Add(info);
     auto task = [info] () mutable {
         HiSysEventWrite(
             HiSysEvent::Domain::RELIABILITY,
@@ -154,6 +184,57 @@ std::list<std::shared_ptr<EventStore::SysEventQuery>> CreateQueries(
     return queries;
 }
 
+void FaultLogDatabase::AddFaultEventToIndex(SysEvent& sysEvent)
+{
+    // only the events found by the store queries are indexed
+    if (sysEvent.eventName_ != "JS_ERROR" ||
+        (sysEvent.domain_ != HiSysEvent::Domain::ACE && sysEvent.domain_ != HiSysEvent::Domain::AAFWK)) {
+        return;
+    }
+    std::lock_guard<std::mutex> lock(mutex_);
+    FaultLogInfo info;
+    ParseFaultLogInfoFromEvent(sysEvent, info);
+    index_.Add(info);
+}
+
+void FaultLogDatabase::BuildIndexIfNeed()
+{
+    // the faults indexed may be removed with the files cleared from the store, rebuild the index then
+    uint64_t removedFileCnt = EventStore::SysEventDao::GetRemovedFileCount();
+    if (isIndexBuilt_ && removedFileCnt == indexedRemovedFileCnt_) {
+        return;
+    }
+    if (isIndexBuilt_) {
+        HIVIEW_LOGI("rebuild fault index since files are removed from store.");
+        index_ = FaultLogIndex(MAX_INDEX_NUM);
+    }
+    isIndexBuilt_ = true;
+    indexedRemovedFileCnt_ = removedFileCnt;
+    EventStore::Cond hiviewUidCond("uid_", EventStore::Op::EQ, static_cast<int64_t>(getuid()));
+    EventStore::Cond allUidCond("uid_", EventStore::Op::GE, static_cast<int64_t>(0));
+    size_t eventNum = 0;
+    for (auto faultType : INDEXED_FAULT_TYPES) {
+        auto queries = CreateQueries(faultType, hiviewUidCond, allUidCond);
+        for (auto query : queries) {
+            EventStore::ResultSet resultSet = query->Execute(MAX_INDEX_NUM);
+            int count = 0;
+            while (resultSet.HasNext()) {
+                // the records of the result set are parsed in place, no copy of the raw data is made
+                auto it = resultSet.Next();
+                FaultLogInfo info;
+                ParseFaultLogInfoFromEvent(*it, info);
+                index_.Add(info);
+                count++;
+            }
+            if (count >= MAX_INDEX_NUM) {
+                index_.MarkIncomplete();
+            }
+            eventNum += static_cast<size_t>(count);
+        }
+    }
+    HIVIEW_LOGI("fault index is built from %{public}zu events, size:%{public}zu.", eventNum, index_.GetSize());
+}
+
 std::list<FaultLogInfo> FaultLogDatabase::GetFaultInfoList(const std::string& module, int32_t id,
     int32_t faultType, int32_t maxNum)
 {
@@ -163,6 +244,22 @@ std::list<FaultLogInfo> FaultLogDatabase::GetFaultInfoList(const std::string& mo
         HIVIEW_LOGE("Unsupported fault type, please check it!");
         return queryResult;
     }
+    BuildIndexIfNeed();
+    if (!index_.Query(module, id, faultType, maxNum, queryResult) ||
+        (queryResult.size() < static_cast<size_t>(maxNum) && !index_.IsComplete(id))) {
+        // the summary is not kept in the index, or older faults may have been evicted from the index
+        return QueryFaultInfoList(module, id, faultType, maxNum);
+    }
+    for (auto& info : queryResult) {
+        info.logPath = LOG_PATH_BASE + GetFaultLogName(info);
+    }
+    return queryResult;
+}
+
+std::list<FaultLogInfo> FaultLogDatabase::QueryFaultInfoList(const std::string& module, int32_t id,
+    int32_t faultType, int32_t maxNum)
+{
+    std::list<FaultLogInfo> queryResult;
     EventStore::Cond hiviewUidCond("uid_", EventStore::Op::EQ, static_cast<int64_t>(getuid()));
     EventStore::Cond uidUpperCond = hiviewUidCond.And("UID", EventStore::Op::EQ, id);
     EventStore::Cond uidLowerCond("uid_", EventStore::Op::EQ, id);
@@ -202,6 +299,78 @@ bool FaultLogDatabase::IsFaultExist(int32_t pid, int32_t uid, int32_t faultType)
         HIVIEW_LOGE("Unsupported fault type, please check it!");
         return false;
     }
+    BuildIndexIfNeed();
+    if (index_.Contains(pid, uid, faultType)) {
+        return true;
+    }
+    return index_.IsComplete(uid) ? false : QueryFaultExist(pid, uid, faultType);
+}
+
+std::vector<bool> FaultLogDatabase::IsFaultExist(const std::vector<FaultLogInfo>& infos)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::vector<bool> exists(infos.size(), false);
+    BuildIndexIfNeed();
+    std::map<int32_t, std::vector<size_t>> typeIndexes;
+    for (size_t index = 0; index < infos.size(); ++index) {
+        const auto& info = infos[index];
+        exists[index] = index_.Contains(info.pid, info.id, info.faultLogType);
+        if (!exists[index] && !index_.IsComplete(info.id)) {
+            typeIndexes[info.faultLogType].push_back(index);
+        }
+    }
+    for (const auto& typeIndex : typeIndexes) {
+        if (typeIndex.first < FaultLogType::ALL || typeIndex.first > FaultLogType::RUST_PANIC) {
+            HIVIEW_LOGE("Unsupported fault type, please check it!");
+            continue;
+        }
+        QueryFaultsExist(infos, typeIndex.second, typeIndex.first, exists);
+    }
+    return exists;
+}
+
+void FaultLogDatabase::QueryFaultsExist(const std::vector<FaultLogInfo>& infos, const std::vector<size_t>& indexes,
+    int32_t faultType, std::vector<bool>& exists)
+{
+    // query the faults of the whole pid range once and match them in memory
+    int32_t minPid = INT_MAX;
+    int32_t maxPid = INT_MIN;
+    for (auto index : indexes) {
+        minPid = std::min(minPid, infos[index].pid);
+        maxPid = std::max(maxPid, infos[index].pid);
+    }
+    EventStore::Cond hiviewUidCond("uid_", EventStore::Op::EQ, static_cast<int64_t>(getuid()));
+    EventStore::Cond pidUpperCond = hiviewUidCond.And("PID", EventStore::Op::GE, minPid).
+        And("PID", EventStore::Op::LE, maxPid);
+    EventStore::Cond pidLowerCond("pid_", EventStore::Op::GE, minPid);
+    pidLowerCond = pidLowerCond.And("pid_", EventStore::Op::LE, maxPid);
+    auto queries = CreateQueries(faultType, pidUpperCond, pidLowerCond);
+    std::unordered_set<uint64_t> faultKeys;
+    bool isTruncated = false;
+    for (auto query : queries) {
+        auto resultSet = query->Execute(batchQueryLimit_);
+        int count = 0;
+        while (resultSet.HasNext()) {
+            auto it = resultSet.Next();
+            bool isWrittenByHiview = IsWrittenByHiview(*it);
+            faultKeys.insert(MakeFaultKey(it->GetEventIntValue(isWrittenByHiview ? "PID" : "pid_"),
+                it->GetEventIntValue(isWrittenByHiview ? "UID" : "uid_")));
+            count++;
+        }
+        isTruncated = isTruncated || (count >= batchQueryLimit_);
+    }
+    for (auto index : indexes) {
+        const auto& info = infos[index];
+        exists[index] = faultKeys.find(MakeFaultKey(info.pid, info.id)) != faultKeys.end();
+        if (!exists[index] && isTruncated) {
+            // the oldest faults of the range may be cut off by the limit, check them one by one
+            exists[index] = QueryFaultExist(info.pid, info.id, faultType);
+        }
+    }
+}
+
+bool FaultLogDatabase::QueryFaultExist(int32_t pid, int32_t uid, int32_t faultType)
+{
     EventStore::Cond hiviewUidCond("uid_", EventStore::Op::EQ, static_cast<int64_t>(getuid()));
     EventStore::Cond pidUpperCond = hiviewUidCond.And("PID", EventStore::Op::EQ, pid).
         And("UID", EventStore::Op::EQ, uid);
@@ -21,8 +21,10 @@
 #include <memory>
 #include <mutex>
 #include <string>
+#include <vector>
 
 #include "event_loop.h"
+#include "faultlog_index.h"
 #include "faultlog_info.h"
 #include "sys_event.h"
 
@@ -35,9 +37,22 @@ public:
     std::list<FaultLogInfo> GetFaultInfoList(
         const std::string& module, int32_t id, int32_t faultType, int32_t maxNum);
     bool IsFaultExist(int32_t pid, int32_t uid, int32_t faultType);
+    std::vector<bool> IsFaultExist(const std::vector<FaultLogInfo>& infos);
+    void AddFaultEventToIndex(SysEvent& sysEvent);
 private:
+    void BuildIndexIfNeed();
+    std::list<FaultLogInfo> QueryFaultInfoList(
+        const std::string& module, int32_t id, int32_t faultType, int32_t maxNum);
+    bool QueryFaultExist(int32_t pid, int32_t uid, int32_t faultType);
+    void QueryFaultsExist(const std::vector<FaultLogInfo>& infos, const std::vector<size_t>& indexes,
+        int32_t faultType, std::vector<bool>& exists);
+
     std::shared_ptr<EventLoop> eventLoop_{nullptr};
     std::mutex mutex_;
+    FaultLogIndex index_;
+    bool isIndexBuilt_{false};
+    uint64_t indexedRemovedFileCnt_{0};
+    int batchQueryLimit_;
 };
 }  // namespace HiviewDFX
 }  // namespace OHOS
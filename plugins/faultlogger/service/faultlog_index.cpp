@@ -0,0 +1,108 @@
+/*
+ * Copyright (c) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "faultlog_index.h"
+
+#include <climits>
+
+namespace OHOS {
+namespace HiviewDFX {
+namespace {
+constexpr size_t MAX_KEPT_SUMMARY_SIZE = 1024; // 1KB for each entry at most
+}
+
+bool FaultLogIndex::IsTypeMatched(int32_t queryType, int32_t faultType)
+{
+    if (queryType != FaultLogType::ALL) {
+        return queryType == faultType;
+    }
+    // same fault names as the store queries of all types
+    return faultType == FaultLogType::JS_CRASH || faultType == FaultLogType::CPP_CRASH ||
+        faultType == FaultLogType::APP_FREEZE;
+}
+
+bool FaultLogIndex::Add(const FaultLogInfo& info)
+{
+    Key key = {info.id, info.time, info.pid, info.faultLogType};
+    bool isSummaryKept = info.summary.size() <= MAX_KEPT_SUMMARY_SIZE;
+    Entry entry = {info.module, info.reason, isSummaryKept ? info.summary : "", isSummaryKept};
+    if (!entries_.emplace(key, std::move(entry)).second) {
+        return false;
+    }
+    timeOrder_.emplace(info.time, key);
+    faultCounts_[FaultId(info.faultLogType, info.pid, info.id)]++;
+    if (entries_.size() > capacity_) {
+        EvictOldest();
+    }
+    return true;
+}
+
+void FaultLogIndex::EvictOldest()
+{
+    auto oldest = timeOrder_.begin();
+    const Key& key = oldest->second;
+    auto countIter = faultCounts_.find(FaultId(key.faultType, key.pid, key.uid));
+    if (countIter != faultCounts_.end() && --(countIter->second) == 0) {
+        faultCounts_.erase(countIter);
+    }
+    evictedUids_.insert(key.uid);
+    entries_.erase(key);
+    timeOrder_.erase(oldest);
+}
+
+bool FaultLogIndex::Query(const std::string& module, int32_t id, int32_t faultType, int32_t maxNum,
+    std::list<FaultLogInfo>& infos) const
+{
+    auto begin = entries_.lower_bound({id, LLONG_MIN, INT_MIN, INT_MIN});
+    auto end = entries_.upper_bound({id, LLONG_MAX, INT_MAX, INT_MAX});
+    // latest first, the same order as the store queries
+    for (auto iter = std::make_reverse_iterator(end); iter != std::make_reverse_iterator(begin); ++iter) {
+        if (infos.size() >= static_cast<size_t>(maxNum)) {
+            break;
+        }
+        const Key& key = iter->first;
+        if (!IsTypeMatched(faultType, key.faultType) || (id != 0 && iter->second.module != module)) {
+            continue;
+        }
+        if (!iter->second.isSummaryKept) {
+            infos.clear();
+            return false;
+        }
+        FaultLogInfo info;
+        info.time = key.time;
+        info.id = key.uid;
+        info.pid = key.pid;
+        info.faultLogType = key.faultType;
+        info.module = iter->second.module;
+        info.reason = iter->second.reason;
+        info.summary = iter->second.summary;
+        infos.push_back(std::move(info));
+    }
+    return true;
+}
+
+bool FaultLogIndex::Contains(int32_t pid, int32_t uid, int32_t faultType) const
+{
+    if (faultType != FaultLogType::ALL) {
+        return faultCounts_.find(FaultId(faultType, pid, uid)) != faultCounts_.end();
+    }
+    for (auto type : {FaultLogType::JS_CRASH, FaultLogType::CPP_CRASH, FaultLogType::APP_FREEZE}) {
+        if (faultCounts_.find(FaultId(type, pid, uid)) != faultCounts_.end()) {
+            return true;
+        }
+    }
+    return false;
+}
+} // namespace HiviewDFX
+} // namespace OHOS
@@ -0,0 +1,86 @@
+/*
+ * Copyright (c) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef HIVIEWDFX_HIVIEW_FAULTLOGGER_FAULTLOG_INDEX_H
+#define HIVIEWDFX_HIVIEW_FAULTLOGGER_FAULTLOG_INDEX_H
+#include <cstdint>
+#include <list>
+#include <map>
+#include <memory>
+#include <string>
+#include <tuple>
+#include <unordered_set>
+
+#include "faultlog_info.h"
+
+namespace OHOS {
+namespace HiviewDFX {
+/*
+ * In-memory index of the fault infos in the event store. Entries are ordered by uid and time, so the faults of
+ * one uid are a single range of the index, and a (type, pid, uid) table answers whether a fault was processed.
+ * The oldest entries are evicted beyond the capacity. The uids losing entries, or all uids if the index was
+ * loaded partially, are no longer complete, and the caller has to fall back to the event store for the faults
+ * of them not found here. Long summaries are not kept, the caller reads the faults of them from the event store.
+ */
+class FaultLogIndex {
+public:
+    explicit FaultLogIndex(size_t capacity) : capacity_(capacity) {};
+    bool Add(const FaultLogInfo& info);
+    bool Query(const std::string& module, int32_t id, int32_t faultType, int32_t maxNum,
+        std::list<FaultLogInfo>& infos) const;
+    bool Contains(int32_t pid, int32_t uid, int32_t faultType) const;
+    void MarkIncomplete()
+    {
+        isComplete_ = false;
+    }
+    bool IsComplete(int32_t uid) const
+    {
+        return isComplete_ && evictedUids_.find(uid) == evictedUids_.end();
+    }
+    size_t GetSize() const
+    {
+        return entries_.size();
+    }
+
+private:
+    struct Key {
+        int32_t uid;
+        int64_t time;
+        int32_t pid;
+        int32_t faultType;
+        bool operator<(const Key& other) const
+        {
+            return std::tie(uid, time, pid, faultType) < std::tie(other.uid, other.time, other.pid, other.faultType);
+        }
+    };
+    struct Entry {
+        std::string module;
+        std::string reason;
+        std::string summary;
+        bool isSummaryKept;
+    };
+    using FaultId = std::tuple<int32_t, int32_t, int32_t>; // fault type, pid and uid
+    static bool IsTypeMatched(int32_t queryType, int32_t faultType);
+    void EvictOldest();
+
+    size_t capacity_;
+    bool isComplete_ = true;
+    std::map<Key, Entry> entries_;
+    std::multimap<int64_t, Key> timeOrder_;
+    std::map<FaultId, uint32_t> faultCounts_;
+    std::unordered_set<int32_t> evictedUids_;
+};
+} // namespace HiviewDFX
+} // namespace OHOS
+#endif // HIVIEWDFX_HIVIEW_FAULTLOGGER_FAULTLOG_INDEX_H
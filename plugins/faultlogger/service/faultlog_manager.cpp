@@ -194,5 +194,21 @@ bool FaultLogManager::IsProcessedFault(int32_t pid, int32_t uid, int32_t faultTy
 
     return faultLogDb_->IsFaultExist(pid, uid, faultType);
 }
+
+std::vector<bool> FaultLogManager::IsProcessedFault(const std::vector<FaultLogInfo>& infos)
+{
+    if (faultLogDb_ == nullptr) {
+        return std::vector<bool>(infos.size(), false);
+    }
+
+    return faultLogDb_->IsFaultExist(infos);
+}
+
+void FaultLogManager::AddFaultEventToIndex(SysEvent& sysEvent)
+{
+    if (faultLogDb_ != nullptr) {
+        faultLogDb_->AddFaultEventToIndex(sysEvent);
+    }
+}
 } // namespace HiviewDFX
 } // namespace OHOS
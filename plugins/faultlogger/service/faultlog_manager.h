@@ -20,11 +20,13 @@
 #include <memory>
 #include <mutex>
 #include <string>
+#include <vector>
 
 #include "event_loop.h"
 #include "log_store_ex.h"
 
 #include "faultlog_info.h"
+#include "sys_event.h"
 
 namespace OHOS {
 namespace HiviewDFX {
@@ -45,6 +47,8 @@ public:
     std::list<FaultLogInfo> GetFaultInfoList(
         const std::string& module, int32_t id, int32_t faultType, int32_t maxNum) const;
     bool IsProcessedFault(int32_t pid, int32_t uid, int32_t faultType);
+    std::vector<bool> IsProcessedFault(const std::vector<FaultLogInfo>& infos);
+    void AddFaultEventToIndex(SysEvent& sysEvent);
 
 private:
     void ReduceLogFileListSize(std::list<std::string>& infoVec, int32_t maxNum) const;
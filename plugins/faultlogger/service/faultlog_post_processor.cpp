@@ -0,0 +1,128 @@
+/*
+ * Copyright (c) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "faultlog_post_processor.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/ioctl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "hiview_logger.h"
+
+namespace OHOS {
+namespace HiviewDFX {
+DEFINE_LOG_LABEL(0xD002D11, "FaultLogPostProcessor");
+namespace {
+constexpr size_t SCAN_WINDOW_SIZE = 16 * 1024;
+constexpr size_t READ_PIPE_BUFFER_SIZE = 4096;
+
+// offset of the first marker in file, size of the file if not found
+off_t FindMarker(int fd, off_t fileSize, const std::string& marker)
+{
+    if (marker.empty()) {
+        return fileSize;
+    }
+    // the tail of each window is kept, so a marker across two windows is still found
+    size_t keepSize = marker.size() - 1;
+    std::vector<char> window(SCAN_WINDOW_SIZE + keepSize);
+    size_t dataLen = 0;
+    off_t windowOffset = 0;
+    off_t readOffset = 0;
+    while (readOffset < fileSize) {
+        ssize_t nread = TEMP_FAILURE_RETRY(pread(fd, window.data() + dataLen, SCAN_WINDOW_SIZE, readOffset));
+        if (nread <= 0) {
+            break;
+        }
+        readOffset += nread;
+        dataLen += static_cast<size_t>(nread);
+        void* found = memmem(window.data(), dataLen, marker.data(), marker.size());
+        if (found != nullptr) {
+            return windowOffset + (static_cast<char*>(found) - window.data());
+        }
+        size_t keepLen = std::min(keepSize, dataLen);
+        std::copy(window.begin() + (dataLen - keepLen), window.begin() + dataLen, window.begin());
+        windowOffset += static_cast<off_t>(dataLen - keepLen);
+        dataLen = keepLen;
+    }
+    return fileSize;
+}
+}
+
+bool TruncateFaultLog(const std::string& logPath, const std::string& marker, size_t maxSize)
+{
+    int fd = TEMP_FAILURE_RETRY(open(logPath.c_str(), O_RDWR | O_CLOEXEC));
+    if (fd < 0) {
+        HIVIEW_LOGE("failed to open %{public}s, errno: %{public}d", logPath.c_str(), errno);
+        return false;
+    }
+    struct stat st;
+    if (fstat(fd, &st) != 0) {
+        close(fd);
+        return false;
+    }
+    off_t markerPos = FindMarker(fd, st.st_size, marker);
+    if (markerPos == st.st_size) {
+        HIVIEW_LOGW("No %{public}s Found In Fault Log", marker.c_str());
+    }
+    bool ret = true;
+    if (static_cast<size_t>(markerPos) > maxSize) {
+        std::string note = "\nThe cpp crash log length is " + std::to_string(markerPos) +
+            ", which exceeesd the limit of " + std::to_string(maxSize) + " and is truncated.\n";
+        ret = ftruncate(fd, static_cast<off_t>(maxSize)) == 0 &&
+            TEMP_FAILURE_RETRY(pwrite(fd, note.data(), note.size(), static_cast<off_t>(maxSize))) ==
+            static_cast<ssize_t>(note.size());
+    } else if (markerPos < st.st_size) {
+        ret = ftruncate(fd, markerPos) == 0;
+    }
+    if (!ret) {
+        HIVIEW_LOGE("failed to truncate %{public}s, errno: %{public}d", logPath.c_str(), errno);
+    }
+    close(fd);
+    return ret;
+}
+
+bool ReadPipeContent(int fd, std::string& content, size_t maxSize)
+{
+    char buffer[READ_PIPE_BUFFER_SIZE];
+    ssize_t nread = TEMP_FAILURE_RETRY(read(fd, buffer, std::min(sizeof(buffer), maxSize)));
+    if (nread <= 0) {
+        HIVIEW_LOGE("read pipe failed");
+        return false;
+    }
+    content.append(buffer, nread);
+    while (content.size() < maxSize) {
+        int available = 0;
+        if (ioctl(fd, FIONREAD, &available) != 0 || available <= 0) {
+            break;
+        }
+        size_t offset = content.size();
+        size_t readSize = std::min(static_cast<size_t>(available), maxSize - offset);
+        content.resize(offset + readSize);
+        nread = TEMP_FAILURE_RETRY(read(fd, &content[offset], readSize));
+        if (nread <= 0) {
+            content.resize(offset);
+            break;
+        }
+        content.resize(offset + static_cast<size_t>(nread));
+    }
+    return true;
+}
+} // namespace HiviewDFX
+} // namespace OHOS
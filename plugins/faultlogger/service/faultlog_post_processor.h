@@ -0,0 +1,36 @@
+/*
+ * Copyright (c) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef HIVIEWDFX_HIVIEW_FAULTLOG_POST_PROCESSOR_H
+#define HIVIEWDFX_HIVIEW_FAULTLOG_POST_PROCESSOR_H
+#include <cstddef>
+#include <string>
+
+namespace OHOS {
+namespace HiviewDFX {
+/*
+ * Cuts the log at the first marker and limits it to maxSize, a note of the original length is appended
+ * if it is limited. The file is scanned through a fixed window and cut in place by ftruncate, so the memory
+ * used does not grow with the size of the log.
+ */
+bool TruncateFaultLog(const std::string& logPath, const std::string& marker, size_t maxSize);
+
+/*
+ * Reads the data written to the pipe, waits for the first bytes like a blocking read and then takes the
+ * bytes already in the pipe, at most maxSize. The buffer only grows to the size of the data.
+ */
+bool ReadPipeContent(int fd, std::string& content, size_t maxSize);
+} // namespace HiviewDFX
+} // namespace OHOS
+#endif // HIVIEWDFX_HIVIEW_FAULTLOG_POST_PROCESSOR_H
@@ -14,6 +14,8 @@
  */
 #include "faultlogger.h"
 
+#include <algorithm>
+#include <cinttypes>
 #include <climits>
 #include <cstdint>
 #include <ctime>
@@ -34,20 +36,24 @@
 #include <sys/types.h>
 #include <sys/wait.h>
 
+#include <atomic>
 #include <cerrno>
 #include <future>
 #include <thread>
 #include <unistd.h>
 
 #include "accesstoken_kit.h"
+#include "boot_scan_journal.h"
 #include "bundle_mgr_client.h"
 #include "common_utils.h"
 #include "constants.h"
 #include "crash_exception.h"
 #include "event.h"
 #include "event_publish.h"
+#include "fault_rate_limiter.h"
 #include "faultlog_formatter.h"
 #include "faultlog_info.h"
+#include "faultlog_post_processor.h"
 #include "faultlog_query_result_inner.h"
 #include "faultlog_util.h"
 #include "faultlogger_adapter.h"
@@ -69,6 +75,7 @@
 #include "dfx_bundle_util.h"
 #include "freeze_json_generator.h"
 #include "freeze_json_util.h"
+#include "hilog_capture.h"
 
 namespace OHOS {
 namespace HiviewDFX {
@@ -88,11 +95,18 @@ constexpr int DUMP_START_PARSE_MODULE_NAME = 3;
 constexpr uint32_t MAX_NAME_LENGTH = 4096;
 constexpr char TEMP_LOG_PATH[] = "/data/log/faultlog/temp";
 constexpr time_t FORTYEIGHT_HOURS = 48 * 60 * 60;
-constexpr int READ_HILOG_BUFFER_SIZE = 1024;
+constexpr char BOOT_SCAN_JOURNAL_PATH[] = "/data/log/faultlog/boot_scan_journal";
+constexpr size_t BOOT_SCAN_WORKER_NUM = 4;
+constexpr uint32_t HILOG_LINE_LIMIT = 1000;
+constexpr size_t HILOG_SIZE_LIMIT = 512 * 1024;
+constexpr int32_t HILOG_TIMEOUT_MS = 3000;
 constexpr char APP_CRASH_TYPE[] = "APP_CRASH";
 constexpr char APP_FREEZE_TYPE[] = "APP_FREEZE";
 constexpr int REPORT_HILOG_LINE = 100;
 constexpr const char STACK_ERROR_MESSAGE[] = "Cannot get SourceMap info, dump raw stack:";
+constexpr uint32_t RATE_LIMIT_WINDOW_SEC = 60;
+constexpr char RATE_LIMIT_BUDGET_PARAM[] = "persist.hiviewdfx.faultlogger.ratelimit";
+constexpr uint64_t SEC_TO_MILLISEC = 1000;
 DumpRequest InitDumpRequest()
 {
     DumpRequest request;
@@ -101,6 +115,7 @@ DumpRequest InitDumpRequest()
     request.fileName = "";
     request.moduleName = "";
     request.time = -1;
+    request.requestRateLimit = false;
     return request;
 }
 
@@ -354,6 +369,9 @@ void Faultlogger::Dump(int fd, const std::vector<std::string> &cmds)
         } else if ((*it) == "-d") {
             request.requestDetail = true;
             continue;
+        } else if ((*it) == "-r") {
+            request.requestRateLimit = true;
+            continue;
         } else if ((*it) == "Faultlogger") {
             // skip first params
             continue;
@@ -382,6 +400,11 @@ void Faultlogger::Dump(int fd, const std::vector<std::string> &cmds)
 
 void Faultlogger::Dump(int fd, const DumpRequest &request) const
 {
+    if (request.requestRateLimit) {
+        rateLimiter_.Dump(fd);
+        return;
+    }
+
     if (!request.fileName.empty()) {
         std::string content;
         if (mgr_->GetFaultLogContent(request.fileName, content)) {
@@ -416,36 +439,28 @@ void Faultlogger::Dump(int fd, const DumpRequest &request) const
     dprintf(fd, "%s\n", FILE_SEPERATOR);
 }
 
-bool Faultlogger::JudgmentRateLimiting(std::shared_ptr<Event> event)
+void Faultlogger::InitRateLimiter()
 {
-    int interval = 60; // 60s time interval
-    auto sysEvent = std::static_pointer_cast<SysEvent>(event);
-    long pid = sysEvent->GetPid();
-    std::string eventPid = std::to_string(pid);
-
-    std::time_t now = std::time(0);
-    for (auto it = eventTagTime_.begin(); it != eventTagTime_.end();) {
-        if ((now - it->second) >= interval) {
-            it = eventTagTime_.erase(it);
-            continue;
-        }
-        ++it;
+    // limiting is off unless a budget is configured, 0 keeps every fault log
+    uint64_t maxCount = Parameter::GetUnsignedInteger(RATE_LIMIT_BUDGET_PARAM, 0);
+    if (maxCount == 0) {
+        return;
     }
+    HIVIEW_LOGI("limit faults to %{public}" PRIu64 " per module in %{public}us", maxCount, RATE_LIMIT_WINDOW_SEC);
+    // crash storms usually come from one module restarting with new pids, so budgets are kept per module
+    RateLimitBudget budget;
+    budget.keyType = RateLimitKeyType::MODULE;
+    budget.windowSec = RATE_LIMIT_WINDOW_SEC;
+    budget.maxCount = static_cast<uint32_t>(std::min<uint64_t>(maxCount, UINT32_MAX));
+    rateLimiter_.SetBudget(FaultLogType::JS_CRASH, budget);
+    rateLimiter_.SetBudget(FaultLogType::RUST_PANIC, budget);
+    rateLimiter_.SetBudget(FaultLogType::ADDR_SANITIZER, budget);
+}
 
-    auto it = eventTagTime_.find(eventPid);
-    if (it != eventTagTime_.end()) {
-        if ((now - it->second) < interval) {
-            HIVIEW_LOGW("event: id:0x%{public}d, eventName:%{public}s pid:%{public}s. \
-                interval:%{public}d There's not enough interval",
-                sysEvent->eventId_, sysEvent->eventName_.c_str(), eventPid.c_str(), interval);
-            return false;
-        }
-    }
-    eventTagTime_[eventPid] = now;
-    HIVIEW_LOGI("event: id:0x%{public}d, eventName:%{public}s pid:%{public}s. \
-        interval:%{public}d normal interval",
-        sysEvent->eventId_, sysEvent->eventName_.c_str(), eventPid.c_str(), interval);
-    return true;
+bool Faultlogger::JudgmentRateLimiting(const FaultLogInfo& info)
+{
+    uint64_t now = TimeUtil::GetSteadyClockTimeMs() / SEC_TO_MILLISEC;
+    return rateLimiter_.Check(info.faultLogType, info.pid, info.id, info.module, now);
 }
 
 bool Faultlogger::IsInterestedPipelineEvent(std::shared_ptr<Event> event)
@@ -538,8 +553,16 @@ bool Faultlogger::OnEvent(std::shared_ptr<Event> &event)
         HIVIEW_LOGI("Skip non address_sanitizer request.");
         return true;
     }
+    if (!JudgmentRateLimiting(info)) {
+        // the suppressed event is still stored without a log file
+        info.logPath = "";
+        UpdateSysEvent(*sysEvent, info);
+        mgr_->AddFaultEventToIndex(*sysEvent);
+        return true;
+    }
     AddFaultLog(info);
     UpdateSysEvent(*sysEvent, info);
+    mgr_->AddFaultEventToIndex(*sysEvent);
     if (info.faultLogType == FaultLogType::JS_CRASH) {
         ReportJsErrorToAppEvent(sysEvent);
     }
@@ -664,6 +687,7 @@ void Faultlogger::OnLoad()
 {
     mgr_ = std::make_unique<FaultLogManager>(GetHiviewContext()->GetSharedWorkLoop());
     mgr_->Init();
+    InitRateLimiter();
     hasInit_ = true;
     workLoop_ = GetHiviewContext()->GetSharedWorkLoop();
 #ifndef UNITTEST
@@ -672,7 +696,10 @@ void Faultlogger::OnLoad()
     // some crash happened before hiview start, ensure every crash event is added into eventdb
     if (workLoop_ != nullptr) {
         auto task = [this] {
-            StartBootScan();
+            // parsing the temp files takes long after a crash-heavy session, keep it off the shared loop
+            ffrt::submit([this] {
+                StartBootScan();
+            }, {}, {}, ffrt::task_attr().name("dft_fault_boot_scan").qos(ffrt::qos_default));
         };
         workLoop_->AddTimerEvent(nullptr, nullptr, task, 10, false); // delay 10 seconds
     }
@@ -728,33 +755,12 @@ std::unique_ptr<FaultLogQueryResultInner> Faultlogger::QuerySelfFaultLog(int32_t
 
 void Faultlogger::FaultlogLimit(const std::string &logPath, int32_t faultType) const
 {
-    std::ifstream logReadFile(logPath);
-    std::string readContent(std::istreambuf_iterator<char>(logReadFile), (std::istreambuf_iterator<char>()));
-    bool modified = false;
-    if (faultType == FaultLogType::CPP_CRASH) {
-        size_t pos = readContent.find("HiLog:");
-        if (pos == std::string::npos) {
-            HIVIEW_LOGW("No Hilog Found In Crash Log");
-        } else {
-            readContent.resize(pos);
-            modified = true;
-        }
-        // The CppCrash file size is limited to 1 MB after reporting CppCrash to AppEvent
-        constexpr size_t maxLogSize = 1024 * 1024;
-        auto fileLen = readContent.length();
-        if (fileLen > maxLogSize) {
-            readContent.resize(maxLogSize);
-            readContent += "\nThe cpp crash log length is " + std::to_string(fileLen) +
-                ", which exceeesd the limit of " + std::to_string(maxLogSize) + " and is truncated.\n";
-            modified = true;
-        }
-    }
-
-    if (modified) {
-        std::ofstream logWriteFile(logPath);
-        logWriteFile << readContent;
-        logWriteFile.close();
+    if (faultType != FaultLogType::CPP_CRASH) {
+        return;
     }
+    // The CppCrash file is cut before the hilog and limited to 1 MB after reporting CppCrash to AppEvent
+    constexpr size_t maxLogSize = 1024 * 1024;
+    TruncateFaultLog(logPath, "HiLog:", maxLogSize);
 }
 
 void Faultlogger::AddFaultLogIfNeed(FaultLogInfo& info, std::shared_ptr<Event> event)
@@ -828,37 +834,86 @@ void Faultlogger::StartBootScan()
     std::vector<std::string> files;
     time_t now = time(nullptr);
     FileUtil::GetDirFiles(TEMP_LOG_PATH, files);
+    BootScanJournal journal(BOOT_SCAN_JOURNAL_PATH);
+    journal.Load();
+    std::vector<std::string> scanFiles;
+    std::vector<struct stat> scanStats;
     for (const auto& file : files) {
         // if file type is not cppcrash, skip!
         if (file.find("cppcrash") == std::string::npos) {
             HIVIEW_LOGI("Skip this file(%{public}s) that the type is not cppcrash.", file.c_str());
             continue;
         }
-        time_t lastAccessTime = GetFileLastAccessTimeStamp(file);
-        if ((now > lastAccessTime) && (now - lastAccessTime > FORTYEIGHT_HOURS)) {
+        struct stat fileStat;
+        if (stat(file.c_str(), &fileStat) != 0) {
+            continue;
+        }
+        if ((now > fileStat.st_atime) && (now - fileStat.st_atime > FORTYEIGHT_HOURS)) {
             HIVIEW_LOGI("Skip this file(%{public}s) that were created 48 hours ago.", file.c_str());
             continue;
         }
-        auto info = ParseFaultLogInfoFromFile(file, true);
+        if (journal.IsProcessed(fileStat)) {
+            continue;
+        }
+        scanFiles.push_back(file);
+        scanStats.push_back(fileStat);
+    }
+    HIVIEW_LOGI("boot scan %{public}zu of %{public}zu temp files.", scanFiles.size(), files.size());
+
+    auto infos = ParseBootScanFiles(scanFiles);
+    std::vector<FaultLogInfo> validInfos;
+    std::vector<size_t> validIndexes;
+    for (size_t index = 0; index < infos.size(); ++index) {
+        auto& info = infos[index];
         if (info.summary.find("#00") == std::string::npos) {
-            HIVIEW_LOGI("Skip this file(%{public}s) which stack is empty.", file.c_str());
+            HIVIEW_LOGI("Skip this file(%{public}s) which stack is empty.", scanFiles[index].c_str());
             HiSysEventWrite(HiSysEvent::Domain::RELIABILITY, "CPP_CRASH_NO_LOG", HiSysEvent::EventType::FAULT,
                 "PID", info.pid,
                 "UID", info.id,
                 "PROCESS_NAME", info.module,
                 "HAPPEN_TIME", std::to_string(info.time)
             );
-            if (remove(file.c_str()) != 0) {
-                HIVIEW_LOGE("Failed to remove file(%{public}s) which stack is empty", file.c_str());
+            if (remove(scanFiles[index].c_str()) != 0) {
+                HIVIEW_LOGE("Failed to remove file(%{public}s) which stack is empty", scanFiles[index].c_str());
             }
             continue;
         }
-        if (mgr_->IsProcessedFault(info.pid, info.id, info.faultLogType)) {
-            HIVIEW_LOGI("Skip processed fault.(%{public}d:%{public}d) ", info.pid, info.id);
+        validInfos.push_back(std::move(info));
+        validIndexes.push_back(index);
+    }
+
+    auto processed = mgr_->IsProcessedFault(validInfos);
+    for (size_t i = 0; i < validInfos.size(); ++i) {
+        journal.MarkProcessed(scanStats[validIndexes[i]]);
+        if (processed[i]) {
+            HIVIEW_LOGI("Skip processed fault.(%{public}d:%{public}d) ", validInfos[i].pid, validInfos[i].id);
             continue;
         }
-        AddFaultLogIfNeed(info, nullptr);
+        AddFaultLogIfNeed(validInfos[i], nullptr);
     }
+    journal.Save();
+}
+
+std::vector<FaultLogInfo> Faultlogger::ParseBootScanFiles(const std::vector<std::string>& files) const
+{
+    std::vector<FaultLogInfo> infos(files.size());
+    std::atomic<size_t> nextIndex {0};
+    auto parseTask = [&files, &infos, &nextIndex] () {
+        for (size_t index = nextIndex++; index < files.size(); index = nextIndex++) {
+            infos[index] = ParseFaultLogInfoFromFile(files[index], true);
+        }
+    };
+
+    // the calling thread also works as one of the workers
+    size_t workerNum = std::min(BOOT_SCAN_WORKER_NUM, files.size());
+    std::vector<ffrt::dependence> workers;
+    for (size_t i = 1; i < workerNum; ++i) {
+        workers.emplace_back(ffrt::submit_h(parseTask, {}, {},
+            ffrt::task_attr().name("dft_fault_scan").qos(ffrt::qos_default)));
+    }
+    parseTask();
+    ffrt::wait(workers);
+    return infos;
 }
 
 void Faultlogger::ReportCppCrashToAppEvent(const FaultLogInfo& info) const
@@ -885,16 +940,10 @@ void Faultlogger::GetStackInfo(const FaultLogInfo& info, std::string& stackInfo)
         HIVIEW_LOGE("invalid fd");
         return;
     }
-    ssize_t nread = -1;
-    char *buffer = new char[MAX_PIPE_SIZE];
-    nread = TEMP_FAILURE_RETRY(read(*info.pipeFd, buffer, MAX_PIPE_SIZE));
-    if (nread <= 0) {
-        HIVIEW_LOGE("read pipe failed");
-        delete []buffer;
+    std::string stackInfoOriginal;
+    if (!ReadPipeContent(*info.pipeFd, stackInfoOriginal, MAX_PIPE_SIZE)) {
         return;
     }
-    std::string stackInfoOriginal(buffer, nread);
-    delete []buffer;
     Json::Reader reader;
     Json::Value stackInfoObj;
     if (!reader.parse(stackInfoOriginal, stackInfoObj)) {
@@ -923,62 +972,13 @@ void Faultlogger::GetStackInfo(const FaultLogInfo& info, std::string& stackInfo)
     stackInfo.append(Json::FastWriter().write(stackInfoObj));
 }
 
-int Faultlogger::DoGetHilogProcess(int32_t pid, int writeFd) const
-{
-    HIVIEW_LOGD("Start do get hilog process, pid:%{public}d", pid);
-    if (writeFd < 0 || dup2(writeFd, STDOUT_FILENO) == -1 ||
-        dup2(writeFd, STDERR_FILENO) == -1) {
-        HIVIEW_LOGE("dup2 writeFd fail");
-        return -1;
-    }
-
-    int ret = -1;
-    ret = execl("/system/bin/hilog", "hilog", "-z", "1000", "-P", std::to_string(pid).c_str(), nullptr);
-    if (ret < 0) {
-        HIVIEW_LOGE("execl %{public}d, errno: %{public}d", ret, errno);
-        return ret;
-    }
-    return 0;
-}
-
 bool Faultlogger::GetHilog(int32_t pid, std::string& log) const
 {
-    int fds[2] = {-1, -1}; // 2: one read pipe, one write pipe
-    if (pipe(fds) != 0) {
-        HIVIEW_LOGE("Failed to create pipe for get log.");
-        return false;
-    }
-    int childPid = fork();
-    if (childPid < 0) {
-        HIVIEW_LOGE("fork fail");
-        return false;
-    } else if (childPid == 0) {
-        syscall(SYS_close, fds[0]);
-        int rc = DoGetHilogProcess(pid, fds[1]);
-        syscall(SYS_close, fds[1]);
-        _exit(rc);
-    } else {
-        syscall(SYS_close, fds[1]);
-        // read log from fds[0]
-        while (true) {
-            char buffer[READ_HILOG_BUFFER_SIZE] = {0};
-            ssize_t nread = TEMP_FAILURE_RETRY(read(fds[0], buffer, sizeof(buffer) - 1));
-            if (nread <= 0) {
-                HIVIEW_LOGI("read hilog finished");
-                break;
-            }
-            log.append(buffer);
-        }
-        syscall(SYS_close, fds[0]);
-
-        if (TEMP_FAILURE_RETRY(waitpid(childPid, nullptr, 0)) != childPid) {
-            HIVIEW_LOGE("waitpid fail, pid: %{public}d, errno: %{public}d", childPid, errno);
-            return false;
-        }
-        HIVIEW_LOGI("get hilog waitpid %{public}d success", childPid);
-        return true;
-    }
-    return false;
+    HilogCaptureOption option;
+    option.lineLimit = HILOG_LINE_LIMIT;
+    option.sizeLimit = HILOG_SIZE_LIMIT;
+    option.timeoutMs = HILOG_TIMEOUT_MS;
+    return HilogCapture::Capture(pid, log, option);
 }
 
 std::list<std::string> GetDightStrArr(const std::string& target)
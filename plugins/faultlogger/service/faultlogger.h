@@ -25,6 +25,7 @@
 #include "plugin.h"
 #include "sys_event.h"
 
+#include "fault_rate_limiter.h"
 #include "faultlog_info.h"
 #include "faultlog_manager.h"
 #include "faultlog_query_result_inner.h"
@@ -39,6 +40,7 @@ struct DumpRequest {
     std::string fileName;
     std::string moduleName;
     time_t time;
+    bool requestRateLimit;
 };
 
 class Faultlogger : public FaultloggerPlugin, public EventListener {
@@ -76,14 +78,15 @@ private:
     void AddCppCrashInfo(FaultLogInfo& info);
     void Dump(int fd, const DumpRequest& request) const;
     void StartBootScan();
-    bool JudgmentRateLimiting(std::shared_ptr<Event> event);
+    std::vector<FaultLogInfo> ParseBootScanFiles(const std::vector<std::string>& files) const;
+    void InitRateLimiter();
+    bool JudgmentRateLimiting(const FaultLogInfo& info);
     std::unique_ptr<FaultLogManager> mgr_;
     volatile bool hasInit_;
-    std::unordered_map<std::string, std::time_t> eventTagTime_;
+    FaultRateLimiter rateLimiter_;
     static void HandleNotify(int32_t type, const std::string& fname);
     void ReportCppCrashToAppEvent(const FaultLogInfo& info) const;
     bool GetHilog(int32_t pid, std::string& log) const;
-    int DoGetHilogProcess(int32_t pid, int writeFd) const;
     void GetStackInfo(const FaultLogInfo& info, std::string& stackInfo) const;
     void ReportJsErrorToAppEvent(std::shared_ptr<SysEvent> sysEvent) const;
     void ReportSanitizerToAppEvent(std::shared_ptr<SysEvent> sysEvent) const;
@@ -0,0 +1,193 @@
+/*
+ * Copyright (c) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "hilog_capture.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <csignal>
+
+#include <fcntl.h>
+#include <poll.h>
+#include <spawn.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include "hiview_logger.h"
+
+extern char** environ;
+
+namespace OHOS {
+namespace HiviewDFX {
+DEFINE_LOG_LABEL(0xD002D11, "HilogCapture");
+namespace {
+constexpr char HILOG_PATH[] = "/system/bin/hilog";
+constexpr size_t READ_BUFFER_SIZE = 4096;
+
+int64_t GetSteadyMs()
+{
+    return std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+void ClosePipe(int fds[])
+{
+    for (int i = 0; i < 2; ++i) { // 2: one read pipe, one write pipe
+        if (fds[i] >= 0) {
+            close(fds[i]);
+            fds[i] = -1;
+        }
+    }
+}
+}
+
+bool HilogCapture::Capture(int32_t pid, std::string& log, const HilogCaptureOption& option)
+{
+    return Capture(pid, [&log] (const char* data, size_t len) {
+        log.append(data, len);
+    }, option);
+}
+
+bool HilogCapture::Capture(int32_t pid, const Writer& writer, const HilogCaptureOption& option)
+{
+    if (pid <= 0 || writer == nullptr) {
+        return false;
+    }
+    int fds[2] = {-1, -1}; // 2: one read pipe, one write pipe
+    if (pipe2(fds, O_CLOEXEC) != 0) {
+        HIVIEW_LOGE("Failed to create pipe for get log, errno: %{public}d", errno);
+        return false;
+    }
+    pid_t childPid = option.allowSpawn ? SpawnHilog(pid, option.lineLimit, fds[1]) : -1;
+    if (childPid < 0) {
+        childPid = ForkHilog(pid, option.lineLimit, fds[1]);
+    }
+    if (childPid < 0) {
+        ClosePipe(fds);
+        return false;
+    }
+    // the child holds its own copy, closing ours lets the read end see eof once hilog exits
+    close(fds[1]);
+    fds[1] = -1;
+    ReadResult result = ReadOutput(fds[0], writer, option);
+    ClosePipe(fds);
+    if (result == ReadResult::TIMEOUT) {
+        HIVIEW_LOGW("get hilog of %{public}d timeout after %{public}dms", pid, option.timeoutMs);
+    } else if (result == ReadResult::TRUNCATED) {
+        HIVIEW_LOGI("hilog of %{public}d is truncated to %{public}zu bytes", pid, option.sizeLimit);
+    }
+    bool isReaped = ReapHilog(childPid, result != ReadResult::FINISHED);
+    return isReaped && result != ReadResult::FAILED;
+}
+
+pid_t HilogCapture::SpawnHilog(int32_t pid, uint32_t lineLimit, int writeFd)
+{
+    posix_spawn_file_actions_t actions;
+    if (posix_spawn_file_actions_init(&actions) != 0) {
+        return -1;
+    }
+    std::string lineStr = std::to_string(lineLimit);
+    std::string pidStr = std::to_string(pid);
+    char* const argv[] = {
+        const_cast<char*>("hilog"), const_cast<char*>("-z"), lineStr.data(),
+        const_cast<char*>("-P"), pidStr.data(), nullptr
+    };
+    pid_t childPid = -1;
+    int ret = posix_spawn_file_actions_adddup2(&actions, writeFd, STDOUT_FILENO);
+    if (ret == 0) {
+        ret = posix_spawn_file_actions_adddup2(&actions, writeFd, STDERR_FILENO);
+    }
+    if (ret == 0) {
+        ret = posix_spawn(&childPid, HILOG_PATH, &actions, nullptr, argv, environ);
+    }
+    posix_spawn_file_actions_destroy(&actions);
+    if (ret != 0) {
+        HIVIEW_LOGW("spawn hilog failed, ret: %{public}d, fall back to fork", ret);
+        return -1;
+    }
+    return childPid;
+}
+
+pid_t HilogCapture::ForkHilog(int32_t pid, uint32_t lineLimit, int writeFd)
+{
+    std::string lineStr = std::to_string(lineLimit);
+    std::string pidStr = std::to_string(pid);
+    pid_t childPid = fork();
+    if (childPid < 0) {
+        HIVIEW_LOGE("fork fail, errno: %{public}d", errno);
+        return -1;
+    }
+    if (childPid == 0) {
+        if (dup2(writeFd, STDOUT_FILENO) == -1 || dup2(writeFd, STDERR_FILENO) == -1) {
+            _exit(-1);
+        }
+        execl(HILOG_PATH, "hilog", "-z", lineStr.c_str(), "-P", pidStr.c_str(), nullptr);
+        _exit(-1);
+    }
+    return childPid;
+}
+
+HilogCapture::ReadResult HilogCapture::ReadOutput(int readFd, const Writer& writer,
+    const HilogCaptureOption& option)
+{
+    int64_t deadline = GetSteadyMs() + option.timeoutMs;
+    size_t totalSize = 0;
+    char buffer[READ_BUFFER_SIZE];
+    while (true) {
+        int64_t remainTime = deadline - GetSteadyMs();
+        if (remainTime <= 0) {
+            return ReadResult::TIMEOUT;
+        }
+        struct pollfd pollFd = { .fd = readFd, .events = POLLIN, .revents = 0 };
+        int ret = TEMP_FAILURE_RETRY(poll(&pollFd, 1, static_cast<int>(remainTime)));
+        if (ret == 0) {
+            return ReadResult::TIMEOUT;
+        }
+        if (ret < 0) {
+            HIVIEW_LOGE("poll hilog output failed, errno: %{public}d", errno);
+            return ReadResult::FAILED;
+        }
+        ssize_t nread = TEMP_FAILURE_RETRY(read(readFd, buffer, sizeof(buffer)));
+        if (nread == 0) {
+            return ReadResult::FINISHED;
+        }
+        if (nread < 0) {
+            HIVIEW_LOGE("read hilog output failed, errno: %{public}d", errno);
+            return ReadResult::FAILED;
+        }
+        size_t writeSize = std::min(static_cast<size_t>(nread), option.sizeLimit - totalSize);
+        writer(buffer, writeSize);
+        totalSize += writeSize;
+        if (totalSize >= option.sizeLimit) {
+            return ReadResult::TRUNCATED;
+        }
+    }
+}
+
+bool HilogCapture::ReapHilog(pid_t childPid, bool needKill)
+{
+    // hilog still running has nothing more to give, it is killed instead of waited for
+    if (needKill) {
+        kill(childPid, SIGKILL);
+    }
+    if (TEMP_FAILURE_RETRY(waitpid(childPid, nullptr, 0)) != childPid) {
+        HIVIEW_LOGE("waitpid fail, pid: %{public}d, errno: %{public}d", childPid, errno);
+        return false;
+    }
+    HIVIEW_LOGI("get hilog waitpid %{public}d success", childPid);
+    return true;
+}
+} // namespace HiviewDFX
+} // namespace OHOS
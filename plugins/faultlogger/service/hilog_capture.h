@@ -0,0 +1,58 @@
+/*
+ * Copyright (c) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef HIVIEWDFX_HIVIEW_HILOG_CAPTURE_H
+#define HIVIEWDFX_HIVIEW_HILOG_CAPTURE_H
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+
+#include <sys/types.h>
+
+namespace OHOS {
+namespace HiviewDFX {
+struct HilogCaptureOption {
+    uint32_t lineLimit = 1000; // lines of the process asked from hilog
+    size_t sizeLimit = 512 * 1024; // bytes captured at most, the rest is dropped
+    int32_t timeoutMs = 3000; // time of one capture at most, the hilog process is killed after it
+    bool allowSpawn = true; // false to always fork the hilog process
+};
+
+/*
+ * Captures the hilog of a process for the fault log. hilog is started with posix_spawn, which shares the
+ * address space of hiview until exec instead of copying its page tables as fork does, and fork is only
+ * the fallback if spawning fails. The output is streamed to the writer within the limits of the option.
+ */
+class HilogCapture {
+public:
+    using Writer = std::function<void(const char* data, size_t len)>;
+    static bool Capture(int32_t pid, std::string& log, const HilogCaptureOption& option = {});
+    static bool Capture(int32_t pid, const Writer& writer, const HilogCaptureOption& option = {});
+
+private:
+    enum class ReadResult {
+        FINISHED,
+        TRUNCATED,
+        TIMEOUT,
+        FAILED,
+    };
+    static pid_t SpawnHilog(int32_t pid, uint32_t lineLimit, int writeFd);
+    static pid_t ForkHilog(int32_t pid, uint32_t lineLimit, int writeFd);
+    static ReadResult ReadOutput(int readFd, const Writer& writer, const HilogCaptureOption& option);
+    static bool ReapHilog(pid_t childPid, bool needKill);
+};
+} // namespace HiviewDFX
+} // namespace OHOS
+#endif // HIVIEWDFX_HIVIEW_HILOG_CAPTURE_H
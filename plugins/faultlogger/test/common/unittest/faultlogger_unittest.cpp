@@ -12,6 +12,7 @@
  * See the License for the specific language governing permissions and
  * limitations under the License.
  */
+#include <chrono>
 #include <string>
 #include <vector>
 
@@ -26,18 +27,23 @@
 #include <sys/ioctl.h>
 #include <unistd.h>
 
+#include "boot_scan_journal.h"
 #include "bundle_mgr_client.h"
 #include "event.h"
+#include "fault_rate_limiter.h"
 #include "faultlog_util.h"
 #include "faultlog_database.h"
 #include "faultlogger.h"
 #include "faultevent_listener.h"
 #include "faultlog_formatter.h"
+#include "faultlog_index.h"
+#include "faultlog_post_processor.h"
 #include "faultlog_info_ohos.h"
 #include "faultlog_query_result_ohos.h"
 #include "faultlogger_adapter.h"
 #include "faultlogger_service_ohos.h"
 #include "file_util.h"
+#include "hilog_capture.h"
 #include "hisysevent_manager.h"
 #include "hiview_global.h"
 #include "hiview_platform.h"
@@ -1616,5 +1622,377 @@ HWTEST_F(FaultloggerUnittest, FaultloggerServiceOhosUnittest001, testing::ext::T
     ASSERT_EQ(res, nullptr);
     faultloggerServiceOhos.Destroy();
 }
+
+/**
+ * @tc.name: HilogCaptureTest001
+ * @tc.desc: test HilogCapture keeps the size limit with both spawn and fork
+ * @tc.type: FUNC
+ */
+HWTEST_F(FaultloggerUnittest, HilogCaptureTest001, testing::ext::TestSize.Level3)
+{
+    std::string log;
+    ASSERT_FALSE(HilogCapture::Capture(-1, log));
+    ASSERT_TRUE(log.empty());
+
+    HilogCaptureOption option;
+    option.sizeLimit = 16; // 16 is a small size to truncate the log
+    ASSERT_TRUE(HilogCapture::Capture(getpid(), log, option));
+    ASSERT_LE(log.size(), option.sizeLimit);
+
+    log.clear();
+    option.allowSpawn = false;
+    ASSERT_TRUE(HilogCapture::Capture(getpid(), log, option));
+    ASSERT_LE(log.size(), option.sizeLimit);
+
+    size_t streamedSize = 0;
+    option.sizeLimit = 1024; // 1024 is the size limit of the stream
+    ASSERT_TRUE(HilogCapture::Capture(getpid(), [&streamedSize] (const char* data, size_t len) {
+        ASSERT_NE(data, nullptr);
+        streamedSize += len;
+    }, option));
+    ASSERT_LE(streamedSize, option.sizeLimit);
+}
+
+/**
+ * @tc.name: HilogCaptureBenchmarkTest001
+ * @tc.desc: compare the hilog capture throughput of spawn and fork under a crash storm
+ * @tc.type: PERF
+ */
+HWTEST_F(FaultloggerUnittest, HilogCaptureBenchmarkTest001, testing::ext::TestSize.Level3)
+{
+    constexpr int faultCnt = 20; // 20 faults captured one after another
+    auto runStorm = [] (bool allowSpawn) {
+        HilogCaptureOption option;
+        option.allowSpawn = allowSpawn;
+        auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < faultCnt; ++i) {
+            std::string log;
+            EXPECT_TRUE(HilogCapture::Capture(getpid(), log, option));
+        }
+        return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start);
+    };
+    auto forkCost = runStorm(false);
+    auto spawnCost = runStorm(true);
+    printf("hilog capture of %d faults, fork: %lldus, spawn: %lldus\n", faultCnt,
+        static_cast<long long>(forkCost.count()), static_cast<long long>(spawnCost.count()));
+    ASSERT_GT(spawnCost.count(), 0);
+    ASSERT_GT(forkCost.count(), 0);
+}
+
+/**
+ * @tc.name: FaultLogPostProcessorTest001
+ * @tc.desc: test TruncateFaultLog cuts the log at the marker and to the size limit in place
+ * @tc.type: FUNC
+ */
+HWTEST_F(FaultloggerUnittest, FaultLogPostProcessorTest001, testing::ext::TestSize.Level3)
+{
+    const std::string logPath = "/data/test/faultlog_post_processor_test";
+    const std::string body = "Pid:1\nReason:Signal:SIGSEGV\n";
+    std::string content;
+
+    // cut at the marker
+    ASSERT_TRUE(FileUtil::SaveStringToFile(logPath, body + "HiLog:\nline1\nline2\n", true));
+    ASSERT_TRUE(TruncateFaultLog(logPath, "HiLog:", 1024)); // 1024 is the size limit
+    ASSERT_TRUE(FileUtil::LoadStringFromFile(logPath, content));
+    ASSERT_EQ(content, body);
+
+    // no marker and within the limit, left as it is
+    ASSERT_TRUE(TruncateFaultLog(logPath, "HiLog:", 1024)); // 1024 is the size limit
+    ASSERT_TRUE(FileUtil::LoadStringFromFile(logPath, content));
+    ASSERT_EQ(content, body);
+
+    // a marker across the scan windows and a log over the limit
+    constexpr size_t bigSize = 64 * 1024 - 3; // 3 puts the marker across two 16K scan windows
+    constexpr size_t maxSize = 1024;
+    ASSERT_TRUE(FileUtil::SaveStringToFile(logPath, std::string(bigSize, 'a') + "HiLog:\nline1\n", true));
+    ASSERT_TRUE(TruncateFaultLog(logPath, "HiLog:", maxSize));
+    ASSERT_TRUE(FileUtil::LoadStringFromFile(logPath, content));
+    ASSERT_EQ(content.substr(0, maxSize), std::string(maxSize, 'a'));
+    ASSERT_NE(content.find("The cpp crash log length is " + std::to_string(bigSize)), std::string::npos);
+    ASSERT_EQ(content.find("HiLog:"), std::string::npos);
+    (void)FileUtil::RemoveFile(logPath);
+
+    ASSERT_FALSE(TruncateFaultLog("/data/test/faultlog_post_processor_none", "HiLog:", maxSize));
+}
+
+/**
+ * @tc.name: FaultLogPostProcessorTest002
+ * @tc.desc: test the stack info is read from pipe up to the size limit
+ * @tc.type: FUNC
+ */
+HWTEST_F(FaultloggerUnittest, FaultLogPostProcessorTest002, testing::ext::TestSize.Level3)
+{
+    int fds[2] = {-1, -1}; // 2: one read pipe, one write pipe
+    ASSERT_EQ(pipe(fds), 0);
+    const std::string stack = "{\"time\":1,\"bundle_name\":\"old\"} \n";
+    ASSERT_EQ(write(fds[1], stack.data(), stack.size()), static_cast<ssize_t>(stack.size()));
+    std::string stackInfo;
+    ASSERT_TRUE(ReadPipeContent(fds[0], stackInfo, 1024)); // 1024 is the size limit
+    ASSERT_EQ(stackInfo, stack);
+
+    // the data beyond the limit are left in the pipe
+    constexpr size_t limit = 10; // 10 is less than the size of the stack
+    ASSERT_EQ(write(fds[1], stack.data(), stack.size()), static_cast<ssize_t>(stack.size()));
+    std::string limitedInfo;
+    ASSERT_TRUE(ReadPipeContent(fds[0], limitedInfo, limit));
+    ASSERT_EQ(limitedInfo, stack.substr(0, limit));
+    close(fds[0]);
+    close(fds[1]);
+}
+
+/**
+ * @tc.name: FaultRateLimiterTest001
+ * @tc.desc: Test budgets and expiry of FaultRateLimiter
+ * @tc.type: FUNC
+ */
+HWTEST_F(FaultloggerUnittest, FaultRateLimiterTest001, testing::ext::TestSize.Level3)
+{
+    FaultRateLimiter limiter;
+    ASSERT_TRUE(limiter.Check(FaultLogType::JS_CRASH, 1, 0, "", 0)); // no budget, nothing is limited
+
+    RateLimitBudget budget;
+    budget.keyType = RateLimitKeyType::MODULE;
+    budget.windowSec = 10; // 10 : window of the test
+    budget.maxCount = 2; // 2 : budget of one module
+    limiter.SetBudget(FaultLogType::JS_CRASH, budget);
+    budget.keyType = RateLimitKeyType::PID;
+    budget.maxCount = 1;
+    limiter.SetBudget(FaultLogType::RUST_PANIC, budget);
+
+    // new pids of one module share the module budget
+    ASSERT_TRUE(limiter.Check(FaultLogType::JS_CRASH, 100, 0, "com.test.a", 100)); // 100 : now
+    ASSERT_TRUE(limiter.Check(FaultLogType::JS_CRASH, 101, 0, "com.test.a", 101)); // 101 : now
+    ASSERT_FALSE(limiter.Check(FaultLogType::JS_CRASH, 102, 0, "com.test.a", 102)); // 102 : now
+    ASSERT_TRUE(limiter.Check(FaultLogType::JS_CRASH, 103, 0, "com.test.b", 102)); // 102 : now
+    ASSERT_TRUE(limiter.Check(FaultLogType::RUST_PANIC, 100, 0, "com.test.a", 102)); // 102 : now
+    ASSERT_FALSE(limiter.Check(FaultLogType::RUST_PANIC, 100, 0, "com.test.a", 105)); // 105 : now
+    ASSERT_EQ(limiter.GetTrackedKeyCount(), 3); // 3 : a, b and pid 100
+
+    // the window of a starts at 100 and expires at 110, b and pid 100 expire at 112
+    ASSERT_TRUE(limiter.Check(FaultLogType::JS_CRASH, 104, 0, "com.test.a", 110)); // 110 : now
+    ASSERT_EQ(limiter.GetTrackedKeyCount(), 3); // 3 : a again, b and pid 100
+    ASSERT_TRUE(limiter.Check(FaultLogType::RUST_PANIC, 100, 0, "com.test.a", 112)); // 112 : now
+    ASSERT_EQ(limiter.GetTrackedKeyCount(), 3); // 3 : b is dropped on the next js crash only
+    ASSERT_TRUE(limiter.Check(FaultLogType::JS_CRASH, 105, 0, "com.test.a", 112)); // 112 : now
+    ASSERT_EQ(limiter.GetTrackedKeyCount(), 2); // 2 : a and pid 100
+
+    auto stats = limiter.GetStats();
+    ASSERT_EQ(stats[FaultLogType::JS_CRASH].passed, 5); // 5 : passed js crashes
+    ASSERT_EQ(stats[FaultLogType::JS_CRASH].suppressed, 1);
+    ASSERT_EQ(stats[FaultLogType::RUST_PANIC].passed, 2); // 2 : passed rust panics
+    ASSERT_EQ(stats[FaultLogType::RUST_PANIC].suppressed, 1);
+
+    auto plugin = GetFaultloggerInstance();
+    int fd = TEMP_FAILURE_RETRY(open("/data/test/testFile", O_CREAT | O_WRONLY | O_TRUNC, 770));
+    ASSERT_GT(fd, 0);
+    std::vector<std::string> cmds;
+    cmds.push_back("-r");
+    plugin->Dump(fd, cmds);
+    close(fd);
+}
+
+/**
+ * @tc.name: BootScanJournalTest001
+ * @tc.desc: Test the unchanged temp files are skipped by BootScanJournal
+ * @tc.type: FUNC
+ */
+HWTEST_F(FaultloggerUnittest, BootScanJournalTest001, testing::ext::TestSize.Level3)
+{
+    std::string journalPath = "/data/test/boot_scan_journal";
+    std::string file1 = "/data/test/cppcrash-1-1";
+    std::string file2 = "/data/test/cppcrash-2-2";
+    ASSERT_TRUE(FileUtil::SaveStringToFile(file1, "crash1"));
+    ASSERT_TRUE(FileUtil::SaveStringToFile(file2, "crash2"));
+    remove(journalPath.c_str());
+
+    struct stat stat1;
+    struct stat stat2;
+    ASSERT_EQ(stat(file1.c_str(), &stat1), 0);
+    ASSERT_EQ(stat(file2.c_str(), &stat2), 0);
+    BootScanJournal journal(journalPath);
+    ASSERT_FALSE(journal.Load());
+    ASSERT_FALSE(journal.IsProcessed(stat1));
+    journal.MarkProcessed(stat1);
+    journal.MarkProcessed(stat2);
+    ASSERT_TRUE(journal.Save());
+
+    // file1 is unchanged, file2 is rewritten and scanned again
+    ASSERT_TRUE(FileUtil::SaveStringToFile(file2, "crash2 rewritten"));
+    ASSERT_EQ(stat(file2.c_str(), &stat2), 0);
+    BootScanJournal nextJournal(journalPath);
+    ASSERT_TRUE(nextJournal.Load());
+    ASSERT_TRUE(nextJournal.IsProcessed(stat1));
+    ASSERT_FALSE(nextJournal.IsProcessed(stat2));
+    ASSERT_TRUE(nextJournal.Save());
+
+    // only the files seen in the last scan are kept
+    BootScanJournal lastJournal(journalPath);
+    ASSERT_TRUE(lastJournal.Load());
+    ASSERT_FALSE(lastJournal.IsProcessed(stat2));
+    ASSERT_EQ(lastJournal.GetRecordCount(), 0);
+    remove(file1.c_str());
+    remove(file2.c_str());
+    remove(journalPath.c_str());
+}
+
+/**
+ * @tc.name: FaultLogIndexTest001
+ * @tc.desc: Test the queries and eviction of FaultLogIndex
+ * @tc.type: FUNC
+ */
+HWTEST_F(FaultloggerUnittest, FaultLogIndexTest001, testing::ext::TestSize.Level3)
+{
+    constexpr size_t capacity = 4; // 4 : capacity of the test index
+    FaultLogIndex index(capacity);
+    auto makeInfo = [] (int32_t uid, int32_t pid, int32_t faultType, int64_t time, const std::string& module) {
+        FaultLogInfo info;
+        info.id = uid;
+        info.pid = pid;
+        info.faultLogType = faultType;
+        info.time = time;
+        info.module = module;
+        info.summary = "summary of " + std::to_string(pid);
+        return info;
+    };
+    ASSERT_TRUE(index.Add(makeInfo(20010001, 100, FaultLogType::CPP_CRASH, 1, "com.test.a")));
+    ASSERT_FALSE(index.Add(makeInfo(20010001, 100, FaultLogType::CPP_CRASH, 1, "com.test.a")));
+    ASSERT_TRUE(index.Add(makeInfo(20010001, 101, FaultLogType::JS_CRASH, 3, "com.test.a")));
+    ASSERT_TRUE(index.Add(makeInfo(20010001, 102, FaultLogType::SYS_FREEZE, 4, "com.test.a")));
+    ASSERT_TRUE(index.Add(makeInfo(20010002, 103, FaultLogType::CPP_CRASH, 2, "com.test.b")));
+
+    // latest first, sys freeze is not a type of all
+    std::list<FaultLogInfo> infos;
+    ASSERT_TRUE(index.Query("com.test.a", 20010001, FaultLogType::ALL, 10, infos)); // 10 : max num
+    ASSERT_EQ(infos.size(), 2); // 2 : js crash and cpp crash
+    ASSERT_EQ(infos.front().pid, 101);
+    ASSERT_EQ(infos.front().summary, "summary of 101");
+    ASSERT_EQ(infos.back().pid, 100);
+    infos.clear();
+    ASSERT_TRUE(index.Query("com.test.a", 20010001, FaultLogType::ALL, 1, infos));
+    ASSERT_EQ(infos.size(), 1);
+    infos.clear();
+    ASSERT_TRUE(index.Query("com.test.b", 20010001, FaultLogType::ALL, 10, infos)); // 10 : max num
+    ASSERT_EQ(infos.size(), 0);
+    ASSERT_TRUE(index.Contains(101, 20010001, FaultLogType::JS_CRASH));
+    ASSERT_TRUE(index.Contains(101, 20010001, FaultLogType::ALL));
+    ASSERT_FALSE(index.Contains(101, 20010002, FaultLogType::JS_CRASH));
+    ASSERT_TRUE(index.IsComplete(20010001));
+
+    // the oldest cpp crash of uid 20010001 is evicted
+    ASSERT_TRUE(index.Add(makeInfo(20010002, 104, FaultLogType::APP_FREEZE, 5, "com.test.b")));
+    ASSERT_EQ(index.GetSize(), capacity);
+    ASSERT_FALSE(index.Contains(100, 20010001, FaultLogType::CPP_CRASH));
+    ASSERT_FALSE(index.IsComplete(20010001));
+    ASSERT_TRUE(index.IsComplete(20010002));
+    index.MarkIncomplete();
+    ASSERT_FALSE(index.IsComplete(20010002));
+
+    // the long summary is not kept, the fault is still known but has to be read from the store
+    FaultLogIndex longSummaryIndex(capacity);
+    auto longSummaryInfo = makeInfo(20010003, 105, FaultLogType::CPP_CRASH, 6, "com.test.c");
+    longSummaryInfo.summary = std::string(4096, 's'); // 4096 : size of the summary longer than kept
+    ASSERT_TRUE(longSummaryIndex.Add(longSummaryInfo));
+    ASSERT_TRUE(longSummaryIndex.Contains(105, 20010003, FaultLogType::CPP_CRASH));
+    infos.clear();
+    ASSERT_FALSE(longSummaryIndex.Query("com.test.c", 20010003, FaultLogType::ALL, 10, infos)); // 10 : max num
+    ASSERT_TRUE(infos.empty());
+}
+
+/**
+ * @tc.name: FaultlogDatabaseUnittest002
+ * @tc.desc: Test the batched IsFaultExist of faults missed by the index
+ * @tc.type: FUNC
+ */
+HWTEST_F(FaultloggerUnittest, FaultlogDatabaseUnittest002, testing::ext::TestSize.Level3)
+{
+    constexpr int32_t appUid = 20010040; // 20010040 : uid of the faulting app
+    const std::vector<std::pair<int32_t, int32_t>> faults = {
+        {4000, 0}, {4001, appUid}, {4003, appUid} // 4000, 4001, 4003 : pids of the stored faults
+    };
+    for (size_t i = 0; i < faults.size(); ++i) {
+        std::string jsonStr = R"~({"domain_":"RELIABILITY", "name_":"CPP_CRASH", "type_":1, "time_":)~" +
+            std::to_string(1501973703000 + i) + R"~(, "tz_":"+0800", "pid_":1854, "tid_":1854, "uid_":)~" +
+            std::to_string(getuid()) + R"~(, "FAULT_TYPE":"2", "PID":)~" + std::to_string(faults[i].first) +
+            R"~(, "UID":)~" + std::to_string(faults[i].second) + R"~(, "MODULE":"FaultlogDatabaseUnittest002",
+            "REASON":"unittest", "SUMMARY":"summary", "LOG_PATH":"", "HAPPEN_TIME":")~" +
+            std::to_string(1501973703 + i) + R"~(", "level_":"CRITICAL", "tag_":"STABILITY", "info_":""})~";
+        auto sysEvent = std::make_shared<SysEvent>("SysEventSource", nullptr, jsonStr);
+        sysEvent->SetLevel("MINOR");
+        sysEvent->SetEventSeq(1100 + i); // 1100 : first seq of the test
+        EventStore::SysEventDao::Insert(sysEvent);
+    }
+
+    std::vector<FaultLogInfo> infos(5); // 5 : candidates in the pid range 4000 to 4003
+    const std::vector<std::pair<int32_t, int32_t>> candidates = {
+        {4000, 0}, {4001, appUid}, {4002, appUid}, {4003, 0}, {4003, appUid}
+    };
+    for (size_t i = 0; i < infos.size(); ++i) {
+        infos[i].pid = candidates[i].first;
+        infos[i].id = candidates[i].second;
+        infos[i].faultLogType = FaultLogType::CPP_CRASH;
+    }
+    const std::vector<bool> expects = {true, true, false, false, true};
+
+    auto faultLogDb = std::make_unique<FaultLogDatabase>(GetHiviewContext().GetSharedWorkLoop());
+    // an empty index missing older faults, every candidate is checked in the store
+    faultLogDb->isIndexBuilt_ = true;
+    faultLogDb->indexedRemovedFileCnt_ = EventStore::SysEventDao::GetRemovedFileCount();
+    faultLogDb->index_.MarkIncomplete();
+    ASSERT_EQ(faultLogDb->IsFaultExist(infos), expects);
+
+    // the range query is cut off, the candidates not found are checked one by one
+    faultLogDb->batchQueryLimit_ = 1;
+    ASSERT_EQ(faultLogDb->IsFaultExist(infos), expects);
+}
+
+/**
+ * @tc.name: FaultLogIndexBenchmarkTest001
+ * @tc.desc: compare the latency of fault queries from the index and from the event store
+ * @tc.type: PERF
+ */
+HWTEST_F(FaultloggerUnittest, FaultLogIndexBenchmarkTest001, testing::ext::TestSize.Level3)
+{
+    constexpr int faultCnt = 50; // 50 faults of one uid in the store
+    constexpr int queryCnt = 20; // 20 queries of each path
+    constexpr int32_t uid = 20010039; // 20010039 : uid of the faulting app, not the uid of hiview writing it
+    for (int i = 0; i < faultCnt; ++i) {
+        std::string jsonStr = R"~({"domain_":"RELIABILITY", "name_":"CPP_CRASH", "type_":1, "time_":)~" +
+            std::to_string(1501973702000 + i) + R"~(, "tz_":"+0800", "pid_":1854, "tid_":1854, "uid_":)~" +
+            std::to_string(getuid()) + R"~(, "FAULT_TYPE":"2", "PID":)~" + std::to_string(3000 + i) +
+            R"~(, "UID":)~" + std::to_string(uid) + R"~(,
+            "MODULE":"FaultLogIndexBenchmark", "REASON":"benchmark", "SUMMARY":"summary", "LOG_PATH":"",
+            "HAPPEN_TIME":")~" + std::to_string(1501973702 + i) + R"~(", "level_":"CRITICAL",
+            "tag_":"STABILITY", "info_":""})~";
+        auto sysEvent = std::make_shared<SysEvent>("SysEventSource", nullptr, jsonStr);
+        sysEvent->SetLevel("MINOR");
+        sysEvent->SetEventSeq(1000 + i); // 1000 : first seq of the benchmark
+        EventStore::SysEventDao::Insert(sysEvent);
+    }
+
+    auto faultLogDb = std::make_unique<FaultLogDatabase>(GetHiviewContext().GetSharedWorkLoop());
+    auto start = std::chrono::steady_clock::now();
+    auto indexList = faultLogDb->GetFaultInfoList("FaultLogIndexBenchmark", uid, FaultLogType::CPP_CRASH, 10);
+    auto buildCost = std::chrono::steady_clock::now() - start;
+    auto measure = [&faultLogDb, uid] (bool fromIndex) {
+        auto begin = std::chrono::steady_clock::now();
+        for (int i = 0; i < queryCnt; ++i) {
+            auto list = fromIndex ?
+                faultLogDb->GetFaultInfoList("FaultLogIndexBenchmark", uid, FaultLogType::CPP_CRASH, 10) :
+                faultLogDb->QueryFaultInfoList("FaultLogIndexBenchmark", uid, FaultLogType::CPP_CRASH, 10);
+            EXPECT_GT(list.size(), 0);
+        }
+        return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - begin);
+    };
+    auto storeCost = measure(false);
+    auto indexCost = measure(true);
+    printf("fault queries x%d, store: %lldus, index: %lldus, index build: %lldus\n", queryCnt,
+        static_cast<long long>(storeCost.count()), static_cast<long long>(indexCost.count()),
+        static_cast<long long>(std::chrono::duration_cast<std::chrono::microseconds>(buildCost).count()));
+    auto storeList = faultLogDb->QueryFaultInfoList("FaultLogIndexBenchmark", uid, FaultLogType::CPP_CRASH, 10);
+    ASSERT_EQ(indexList.size(), storeList.size());
+    ASSERT_EQ(indexList.front().id, uid);
+    ASSERT_TRUE(faultLogDb->IsFaultExist(3000, uid, FaultLogType::CPP_CRASH)); // 3000 : pid of the first fault
+    ASSERT_FALSE(faultLogDb->IsFaultExist(3000, getuid(), FaultLogType::CPP_CRASH)); // 3000 : pid of the first fault
+}
 } // namespace HiviewDFX
 } // namespace OHOS
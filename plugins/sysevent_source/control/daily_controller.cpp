@@ -23,13 +23,33 @@ namespace OHOS {
 namespace HiviewDFX {
 DEFINE_LOG_TAG("DailyController");
 namespace {
-constexpr int32_t COUNT_OF_INIT = 1;
+constexpr int64_t UPDATE_INTERVAL = 600; // 10min
+constexpr char DATE_FORMAT[] = "%Y%m%d";
 }
 
 DailyController::DailyController(const std::string& workPath, const std::string& configPath)
 {
     dbHelper_ = std::make_unique<DailyDbHelper>(workPath);
     config_ = std::make_unique<DailyConfig>(configPath);
+
+    // the db of the last day is left if hiview restarts on a new day
+    int64_t nowTime = TimeUtil::GetSeconds();
+    if (dbHelper_->NeedReport(nowTime)) {
+        dbHelper_->Report();
+    }
+    curDate_ = TimeUtil::TimestampFormatToDate(nowTime, DATE_FORMAT);
+    lastDateCheckTime_ = nowTime;
+    lastUpdateTime_ = nowTime;
+    LoadCacheFromDb();
+    dbQueue_ = std::make_unique<ffrt::queue>("dft_daily_ctrl");
+}
+
+DailyController::~DailyController()
+{
+    // counts not updated to db yet are flushed before the db helper is released
+    auto handle = dbQueue_->submit_h([this] { UpdateCacheToDb(); }, ffrt::task_attr().name("dft_daily_flush"));
+    dbQueue_->wait(handle);
+    dbQueue_ = nullptr;
 }
 
 bool DailyController::CheckThreshold(std::shared_ptr<SysEvent> event)
@@ -39,157 +59,210 @@ bool DailyController::CheckThreshold(std::shared_ptr<SysEvent> event)
         return false;
     }
 
-    // try to update cache to db and report db before checking
+    // try to report db before checking
     int64_t nowTime = TimeUtil::GetSeconds();
-    TryToUpdateCacheToDb(nowTime);
     TryToReportDb(nowTime);
 
     // check the threshold of event
     auto cacheKey = std::make_pair(event->domain_, event->eventName_);
-    int32_t threshold = GetThreshold(cacheKey, event->eventType_);
-    int32_t count = GetCount(cacheKey) + 1;
+    int32_t threshold = 0;
+    int32_t count = 0;
+    {
+        std::shared_lock<std::shared_mutex> dateLock(dateMutex_);
+        auto info = GetControlInfo(cacheKey);
+        threshold = GetThreshold(cacheKey, *info, event->eventType_);
+        count = info->count.fetch_add(1, std::memory_order_relaxed) + 1;
 
-    // update cache and db after checking
-    UpdateCacheAndDb(cacheKey, threshold, count);
+        // check the first time the event crosses the threshold
+        if (count == (threshold + 1)) {
+            info->exceedTime.store(nowTime, std::memory_order_relaxed);
+            HIVIEW_LOGI("event first exceeds threshold, domain=%{public}s, name=%{public}s",
+                cacheKey.first.c_str(), cacheKey.second.c_str());
+        }
+        info->isDirty.store(true, std::memory_order_release);
+    }
+
+    // try to update cache to db in the background after checking
+    TryToUpdateCacheToDb(nowTime);
     return config_->IsValid() ? (count <= threshold) : true;
 }
 
-void DailyController::TryToUpdateCacheToDb(int64_t nowTime)
+void DailyController::LoadCacheFromDb()
 {
-    if (CheckTimeOfCache(nowTime) || CheckSizeOfCache()) {
-        UpdateCacheToDb();
+    std::vector<DailyDbHelper::EventInfo> eventInfos;
+    if (dbHelper_->QueryEventInfos(eventInfos) < 0) {
+        HIVIEW_LOGW("failed to load event infos from db");
+        return;
+    }
+    for (const auto& eventInfo : eventInfos) {
+        auto info = GetControlInfo(std::make_pair(eventInfo.domain, eventInfo.name));
+        info->count.store(eventInfo.count, std::memory_order_relaxed);
+        info->exceedTime.store(eventInfo.exceedTime, std::memory_order_relaxed);
     }
+    HIVIEW_LOGI("succ to load event infos from db, size=%{public}zu", eventInfos.size());
 }
 
-bool DailyController::CheckTimeOfCache(int64_t nowTime)
+void DailyController::TryToUpdateCacheToDb(int64_t nowTime)
 {
-    static int64_t lastUpdateTime = 0;
-    if (lastUpdateTime == 0) {
-        lastUpdateTime = TimeUtil::GetSeconds();
-        return false;
+    int64_t lastUpdateTime = lastUpdateTime_.load(std::memory_order_relaxed);
+    if (std::abs(nowTime - lastUpdateTime) <= UPDATE_INTERVAL ||
+        !lastUpdateTime_.compare_exchange_strong(lastUpdateTime, nowTime)) {
+        return;
     }
-
-    constexpr int64_t updateInterval = 600; // 10min
-    if (std::abs(nowTime - lastUpdateTime) <= updateInterval) {
-        return false;
+    std::string date;
+    {
+        std::shared_lock<std::shared_mutex> lock(dateMutex_);
+        date = curDate_;
     }
-    lastUpdateTime = nowTime;
-    return true;
+    dbQueue_->submit([this, date] { UpdateCacheToDb(date); }, ffrt::task_attr().name("dft_daily_flush"));
 }
 
-bool DailyController::CheckSizeOfCache()
+void DailyController::TryToReportDb(int64_t nowTime)
 {
-    constexpr size_t maxSizeOfCache = 1000;
-    return cache_.size() > maxSizeOfCache;
+    // the date is checked at most once per second
+    int64_t lastCheckTime = lastDateCheckTime_.load(std::memory_order_relaxed);
+    if (lastCheckTime == nowTime || !lastDateCheckTime_.compare_exchange_strong(lastCheckTime, nowTime)) {
+        return;
+    }
+    std::string date = TimeUtil::TimestampFormatToDate(nowTime, DATE_FORMAT);
+    {
+        std::shared_lock<std::shared_mutex> lock(dateMutex_);
+        if (date == curDate_) {
+            return;
+        }
+    }
+
+    // the counts are swapped on the db queue, so the flushes queued before still update the old db
+    dbQueue_->submit([this, date, nowTime] { ReportDb(date, nowTime); }, ffrt::task_attr().name("dft_daily_report"));
 }
 
-void DailyController::UpdateCacheToDb()
+void DailyController::ReportDb(const std::string& date, int64_t nowTime)
 {
-    HIVIEW_LOGI("start to update cache to db, size=%{public}zu", cache_.size());
-    for (const auto& [key, value] : cache_) {
-        // means that the record has been inserted and does not need to be updated
-        if (value.count == COUNT_OF_INIT) {
-            continue;
+    std::vector<CacheMap> caches;
+    {
+        std::unique_lock<std::shared_mutex> lock(dateMutex_);
+        if (date == curDate_) {
+            // swapped by a report queued before
+            return;
         }
-
-        DailyDbHelper::EventInfo eventInfo = {
-            .domain = key.first,
-            .name = key.second,
-            .count = value.count,
-            .exceedTime = value.exceedTime,
-        };
-        if (dbHelper_->UpdateEventInfo(eventInfo) < 0) {
-            HIVIEW_LOGW("failed to update, domain=%{public}s, name=%{public}s",
-                key.first.c_str(), key.second.c_str());
+        curDate_ = date;
+        for (auto& shard : shards_) {
+            std::unique_lock<std::shared_mutex> shardLock(shard.mutex);
+            caches.emplace_back(std::move(shard.infos));
+            shard.infos.clear();
         }
     }
-    cache_.clear();
-}
 
-void DailyController::TryToReportDb(int64_t nowTime)
-{
+    // counts of the new day start from zero, the old ones are updated to the old db before reporting
+    HIVIEW_LOGI("date changes to %{public}s", date.c_str());
+    UpdateCacheToDb(caches);
     if (dbHelper_->NeedReport(nowTime)) {
-        UpdateCacheToDb();
         dbHelper_->Report();
     }
 }
 
-int32_t DailyController::GetThreshold(const CacheKey& cachekey, int32_t type)
+void DailyController::UpdateCacheToDb()
 {
-    if (cache_.find(cachekey) != cache_.end()) {
-        return cache_[cachekey].threshold;
+    std::vector<DailyDbHelper::EventInfo> eventInfos;
+    std::vector<ControlInfoPtr> dirtyInfos;
+    for (auto& shard : shards_) {
+        std::shared_lock<std::shared_mutex> lock(shard.mutex);
+        CollectDirtyInfos(shard.infos, eventInfos, dirtyInfos);
     }
-    int32_t threshold = config_->GetThreshold(cachekey.first, cachekey.second, type);
-    if (threshold < 0) {
-        HIVIEW_LOGW("failed to get threshold from config, threshold=%{public}d", threshold);
-        return 0;
-    }
-    return threshold;
+    UpdateDb(eventInfos, dirtyInfos);
 }
 
-int32_t DailyController::GetCount(const CacheKey& cachekey)
+void DailyController::UpdateCacheToDb(const std::string& date)
 {
-    if (cache_.find(cachekey) != cache_.end()) {
-        return cache_[cachekey].count;
+    {
+        std::shared_lock<std::shared_mutex> lock(dateMutex_);
+        if (date != curDate_) {
+            // the counts of that date are updated by the report, the new ones belong to the new db
+            return;
+        }
     }
+    UpdateCacheToDb();
+}
 
-    DailyDbHelper::EventInfo eventInfo = {
-        .domain = cachekey.first,
-        .name = cachekey.second,
-    };
-    if (dbHelper_->QueryEventInfo(eventInfo) < 0) {
-        HIVIEW_LOGW("failed to query event info from db, count=%{public}d", eventInfo.count);
-        return 0;
+void DailyController::UpdateCacheToDb(const std::vector<CacheMap>& caches)
+{
+    std::vector<DailyDbHelper::EventInfo> eventInfos;
+    std::vector<ControlInfoPtr> dirtyInfos;
+    for (const auto& cache : caches) {
+        CollectDirtyInfos(cache, eventInfos, dirtyInfos);
     }
-    return eventInfo.count;
+    UpdateDb(eventInfos, dirtyInfos);
 }
 
-void DailyController::UpdateCacheAndDb(const CacheKey& cachekey, int32_t threshold, int32_t count)
+void DailyController::CollectDirtyInfos(const CacheMap& cache, std::vector<DailyDbHelper::EventInfo>& eventInfos,
+    std::vector<ControlInfoPtr>& dirtyInfos)
 {
-    // check the first time the event crosses the threshold
-    int64_t exceedTime = 0;
-    if (count == (threshold + 1)) {
-        exceedTime = TimeUtil::GetSeconds();
-        HIVIEW_LOGI("event first exceeds threshold, domain=%{public}s, name=%{public}s",
-            cachekey.first.c_str(), cachekey.second.c_str());
+    for (const auto& [key, value] : cache) {
+        if (!value->isDirty.exchange(false, std::memory_order_acquire)) {
+            continue;
+        }
+        DailyDbHelper::EventInfo eventInfo = {
+            .domain = key.first,
+            .name = key.second,
+            .count = value->count.load(std::memory_order_relaxed),
+            .exceedTime = value->exceedTime.load(std::memory_order_relaxed),
+        };
+        eventInfos.emplace_back(eventInfo);
+        dirtyInfos.emplace_back(value);
     }
-
-    UpdateCache(cachekey, threshold, count, exceedTime);
-    UpdateDb(cachekey, count, exceedTime);
 }
 
-void DailyController::UpdateCache(const CacheKey& cachekey, int32_t threshold, int32_t count, int64_t exceedTime)
+void DailyController::UpdateDb(const std::vector<DailyDbHelper::EventInfo>& eventInfos,
+    const std::vector<ControlInfoPtr>& dirtyInfos)
 {
-    if (cache_.find(cachekey) == cache_.end()) {
-        cache_[cachekey] = {
-            .threshold = threshold,
-            .count = count,
-            .exceedTime = exceedTime,
-        };
+    if (eventInfos.empty()) {
         return;
     }
-
-    cache_[cachekey].count = count;
-    if (exceedTime != 0) {
-        cache_[cachekey].exceedTime = exceedTime;
+    HIVIEW_LOGI("start to update cache to db, size=%{public}zu", eventInfos.size());
+    if (dbHelper_->UpsertEventInfos(eventInfos) < 0) {
+        // keep the records dirty, so that they are updated next time
+        for (const auto& info : dirtyInfos) {
+            info->isDirty.store(true, std::memory_order_relaxed);
+        }
     }
 }
 
-void DailyController::UpdateDb(const CacheKey& cachekey, int32_t count, int64_t exceedTime)
+DailyController::CacheShard& DailyController::GetShard(const CacheKey& cacheKey)
 {
-    // the record does not exist in the db, need to init the record
-    if (count == COUNT_OF_INIT) {
-        DailyDbHelper::EventInfo eventInfo = {
-            .domain = cachekey.first,
-            .name = cachekey.second,
-            .count = count,
-            .exceedTime = exceedTime,
-        };
-        if (dbHelper_->InsertEventInfo(eventInfo) < 0) {
-            HIVIEW_LOGW("failed to insert, domain=%{public}s, name=%{public}s",
-                eventInfo.domain.c_str(), eventInfo.name.c_str());
+    return shards_[EventPairHash()(cacheKey) % SHARD_NUM];
+}
+
+DailyController::ControlInfoPtr DailyController::GetControlInfo(const CacheKey& cacheKey)
+{
+    auto& shard = GetShard(cacheKey);
+    {
+        std::shared_lock<std::shared_mutex> lock(shard.mutex);
+        auto iter = shard.infos.find(cacheKey);
+        if (iter != shard.infos.end()) {
+            return iter->second;
         }
     }
+    std::unique_lock<std::shared_mutex> lock(shard.mutex);
+    auto& info = shard.infos[cacheKey];
+    if (info == nullptr) {
+        info = std::make_shared<ControlInfo>();
+    }
+    return info;
+}
+
+int32_t DailyController::GetThreshold(const CacheKey& cacheKey, ControlInfo& info, int32_t type)
+{
+    int32_t threshold = info.threshold.load(std::memory_order_relaxed);
+    if (threshold >= 0) {
+        return threshold;
+    }
+    threshold = config_->GetThreshold(cacheKey.first, cacheKey.second, type);
+    if (threshold < 0) {
+        HIVIEW_LOGW("failed to get threshold from config, threshold=%{public}d", threshold);
+        threshold = 0;
+    }
+    info.threshold.store(threshold, std::memory_order_relaxed);
+    return threshold;
 }
 } // namespace HiviewDFX
 } // namespace OHOS
@@ -194,6 +194,89 @@ int32_t DailyDbHelper::QueryEventInfo(EventInfo& info)
     return 0;
 }
 
+int32_t DailyDbHelper::QueryEventInfos(std::vector<EventInfo>& infos)
+{
+    if (dbStore_ == nullptr) {
+        return -1;
+    }
+
+    NativeRdb::AbsRdbPredicates predicates(EVENTS_TABLE);
+    auto resultSet = dbStore_->Query(predicates,
+        {EVENTS_COLUMIN_DOMAIN, EVENTS_COLUMIN_NAME, EVENTS_COLUMIN_COUNT, EVENTS_COLUMIN_EXCEED_TIME});
+    if (resultSet == nullptr) {
+        HIVIEW_LOGW("failed to query table=%{public}s", EVENTS_TABLE.c_str());
+        return -1;
+    }
+
+    while (resultSet->GoToNextRow() == NativeRdb::E_OK) {
+        EventInfo info;
+        if (resultSet->GetString(0, info.domain) != NativeRdb::E_OK ||  // 0: domain
+            resultSet->GetString(1, info.name) != NativeRdb::E_OK ||    // 1: name
+            resultSet->GetInt(2, info.count) != NativeRdb::E_OK ||      // 2: count
+            resultSet->GetLong(3, info.exceedTime) != NativeRdb::E_OK || // 3: exceed_time
+            info.count < 0) {
+            HIVIEW_LOGW("failed to get event info, domain=%{public}s, name=%{public}s",
+                info.domain.c_str(), info.name.c_str());
+            continue;
+        }
+        infos.emplace_back(info);
+    }
+    resultSet->Close();
+    return 0;
+}
+
+int32_t DailyDbHelper::UpsertEventInfos(const std::vector<EventInfo>& infos)
+{
+    if (dbStore_ == nullptr) {
+        return -1;
+    }
+
+    // all records are updated in one transaction instead of one transaction per record
+    if (auto ret = dbStore_->BeginTransaction(); ret != NativeRdb::E_OK) {
+        HIVIEW_LOGW("failed to begin transaction, ret=%{public}d", ret);
+        return -1;
+    }
+    for (const auto& info : infos) {
+        NativeRdb::ValuesBucket bucket;
+        bucket.PutInt(EVENTS_COLUMIN_COUNT, info.count);
+        if (info.exceedTime != 0) {
+            bucket.PutLong(EVENTS_COLUMIN_EXCEED_TIME, info.exceedTime);
+        }
+        NativeRdb::AbsRdbPredicates predicates(EVENTS_TABLE);
+        predicates.EqualTo(EVENTS_COLUMIN_DOMAIN, info.domain);
+        predicates.EqualTo(EVENTS_COLUMIN_NAME, info.name);
+        int32_t changeRows = 0;
+        if (dbStore_->Update(changeRows, bucket, predicates) != NativeRdb::E_OK) {
+            HIVIEW_LOGW("failed to update event, domain=%{public}s, name=%{public}s",
+                info.domain.c_str(), info.name.c_str());
+            dbStore_->RollBack();
+            return -1;
+        }
+        if (changeRows != 0) {
+            continue;
+        }
+
+        // the record does not exist in the db, need to init the record
+        bucket.PutString(EVENTS_COLUMIN_DOMAIN, info.domain);
+        bucket.PutString(EVENTS_COLUMIN_NAME, info.name);
+        bucket.PutLong(EVENTS_COLUMIN_EXCEED_TIME, info.exceedTime);
+        int64_t seq = 0;
+        if (dbStore_->Insert(seq, EVENTS_TABLE, bucket) != NativeRdb::E_OK) {
+            HIVIEW_LOGW("failed to insert event, domain=%{public}s, name=%{public}s",
+                info.domain.c_str(), info.name.c_str());
+            dbStore_->RollBack();
+            return -1;
+        }
+    }
+    if (auto ret = dbStore_->Commit(); ret != NativeRdb::E_OK) {
+        HIVIEW_LOGW("failed to commit transaction, ret=%{public}d", ret);
+        dbStore_->RollBack();
+        return -1;
+    }
+    HIVIEW_LOGD("succ to upsert events, size=%{public}zu", infos.size());
+    return 0;
+}
+
 bool DailyDbHelper::NeedReport(int64_t nowTime)
 {
     std::string dateOfDbFile = HiviewDbUtil::GetDateFromDbFile(dbPath_);
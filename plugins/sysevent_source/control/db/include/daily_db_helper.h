@@ -36,6 +36,8 @@ public:
     int32_t InsertEventInfo(const EventInfo& info);
     int32_t UpdateEventInfo(const EventInfo& info);
     int32_t QueryEventInfo(EventInfo& info);
+    int32_t QueryEventInfos(std::vector<EventInfo>& infos);
+    int32_t UpsertEventInfos(const std::vector<EventInfo>& infos);
 
     bool NeedReport(int64_t nowTime);
     void Report();
@@ -15,6 +15,13 @@
 #ifndef HIVIEW_PLUGINS_SYS_EVENT_SOURCE_CONTROL_INCLUDE_DAILY_CONTROLLER_H
 #define HIVIEW_PLUGINS_SYS_EVENT_SOURCE_CONTROL_INCLUDE_DAILY_CONTROLLER_H
 
+#include <array>
+#include <atomic>
+#include <mutex>
+#include <shared_mutex>
+#include <vector>
+
+#include "ffrt.h"
 #include "i_controller.h"
 #include "daily_config.h"
 #include "daily_db_helper.h"
@@ -24,33 +31,53 @@ namespace HiviewDFX {
 class DailyController : public IController {
 public:
     DailyController(const std::string& workPath, const std::string& configPath);
-    ~DailyController() = default;
+    ~DailyController();
     bool CheckThreshold(std::shared_ptr<SysEvent> event) override;
 
 private:
     typedef std::pair<std::string, std::string> CacheKey;
     struct ControlInfo {
-        int32_t threshold = 0;
-        int32_t count = 0;
-        int64_t exceedTime = 0;
+        std::atomic<int32_t> threshold { -1 }; // -1 means not resolved from the config yet
+        std::atomic<int32_t> count { 0 };
+        std::atomic<int64_t> exceedTime { 0 };
+        std::atomic<bool> isDirty { false };
+    };
+    using ControlInfoPtr = std::shared_ptr<ControlInfo>;
+    /* <<domain, name>, ControlInfo> */
+    using CacheMap = std::unordered_map<CacheKey, ControlInfoPtr, EventPairHash>;
+    struct CacheShard {
+        std::shared_mutex mutex;
+        CacheMap infos;
     };
+    static constexpr size_t SHARD_NUM = 16;
 
+    void LoadCacheFromDb();
     void TryToUpdateCacheToDb(int64_t nowTime);
     void TryToReportDb(int64_t nowTime);
-    bool CheckTimeOfCache(int64_t nowTime);
-    bool CheckSizeOfCache();
+    void ReportDb(const std::string& date, int64_t nowTime);
     void UpdateCacheToDb();
-    int32_t GetThreshold(const CacheKey& cachekey, int32_t type);
-    int32_t GetCount(const CacheKey& cachekey);
-    void UpdateCacheAndDb(const CacheKey& cachekey, int32_t threshold, int32_t count);
-    void UpdateCache(const CacheKey& cachekey, int32_t threshold, int32_t count, int64_t exceedTime);
-    void UpdateDb(const CacheKey& cachekey, int32_t count, int64_t exceedTime);
+    void UpdateCacheToDb(const std::string& date);
+    void UpdateCacheToDb(const std::vector<CacheMap>& caches);
+    void CollectDirtyInfos(const CacheMap& cache, std::vector<DailyDbHelper::EventInfo>& eventInfos,
+        std::vector<ControlInfoPtr>& dirtyInfos);
+    void UpdateDb(const std::vector<DailyDbHelper::EventInfo>& eventInfos,
+        const std::vector<ControlInfoPtr>& dirtyInfos);
+    CacheShard& GetShard(const CacheKey& cacheKey);
+    ControlInfoPtr GetControlInfo(const CacheKey& cacheKey);
+    int32_t GetThreshold(const CacheKey& cacheKey, ControlInfo& info, int32_t type);
 
 private:
     std::unique_ptr<DailyConfig> config_;
     std::unique_ptr<DailyDbHelper> dbHelper_;
-    /* <<domain, name>, ControlInfo> */
-    std::unordered_map<std::pair<std::string, std::string>, ControlInfo, EventPairHash> cache_;
+    std::array<CacheShard, SHARD_NUM> shards_;
+    /* held shared while a count is increased, so the counts are not swapped out by a date change meanwhile */
+    std::shared_mutex dateMutex_;
+    std::string curDate_;
+    std::atomic<int64_t> lastDateCheckTime_ { 0 };
+    std::atomic<int64_t> lastUpdateTime_ { 0 };
+
+    /* all db accesses after the construction are serialized on this queue */
+    std::unique_ptr<ffrt::queue> dbQueue_;
 };
 } // namespace HiviewDFX
 } // namespace OHOS
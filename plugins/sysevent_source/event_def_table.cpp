@@ -0,0 +1,392 @@
+/*
+ * Copyright (c) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "event_def_table.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <cinttypes>
+#include <cstring>
+#include <fcntl.h>
+#include <map>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "file_util.h"
+#include "hiview_logger.h"
+
+namespace OHOS {
+namespace HiviewDFX {
+namespace {
+DEFINE_LOG_TAG("Event-DefTable");
+
+constexpr uint32_t DEF_IMAGE_MAGIC = 0x46454453; // "SDEF"
+constexpr uint32_t DEF_IMAGE_VERSION = 1;
+constexpr uint32_t MAX_DEF_IMAGE_SIZE = 64 * 1024 * 1024; // 64M
+
+struct DefStrRef {
+    uint32_t offset = 0;
+    uint32_t len = 0;
+};
+
+struct DefImageHeader {
+    uint32_t magic = DEF_IMAGE_MAGIC;
+    uint32_t version = DEF_IMAGE_VERSION;
+    uint64_t srcSize = 0;
+    int64_t srcMtime = 0;
+    uint64_t srcIno = 0;
+    DefStrRef srcPath;
+    uint32_t domainCnt = 0;
+    uint32_t eventCnt = 0;
+    uint32_t poolSize = 0;
+    uint32_t reserved = 0;
+};
+
+struct DefDomainEntry {
+    DefStrRef name;
+    uint32_t firstEvent = 0;
+    uint32_t eventCnt = 0;
+};
+
+struct DefEventEntry {
+    DefStrRef name;
+    DefStrRef level;
+    DefStrRef tag;
+    uint8_t type = INVALID_EVENT_TYPE;
+    uint8_t privacy = DEFAULT_PRIVACY;
+    uint8_t preserve = 1;
+    uint8_t reserved = 0;
+};
+
+static_assert(sizeof(DefImageHeader) % sizeof(uint64_t) == 0, "image header must keep entries aligned");
+static_assert(sizeof(DefDomainEntry) % sizeof(uint32_t) == 0, "domain entry must keep entries aligned");
+static_assert(sizeof(DefEventEntry) % sizeof(uint32_t) == 0, "event entry must keep pool aligned");
+
+const DefImageHeader* GetHeader(const char* data)
+{
+    return reinterpret_cast<const DefImageHeader*>(data);
+}
+
+const DefDomainEntry* GetDomains(const char* data)
+{
+    return reinterpret_cast<const DefDomainEntry*>(data + sizeof(DefImageHeader));
+}
+
+const DefEventEntry* GetEvents(const char* data)
+{
+    return reinterpret_cast<const DefEventEntry*>(data + sizeof(DefImageHeader) +
+        GetHeader(data)->domainCnt * sizeof(DefDomainEntry));
+}
+
+const char* GetPool(const char* data)
+{
+    return reinterpret_cast<const char*>(GetEvents(data) + GetHeader(data)->eventCnt);
+}
+
+uint64_t GetImageSize(uint64_t domainCnt, uint64_t eventCnt, uint64_t poolSize)
+{
+    return sizeof(DefImageHeader) + domainCnt * sizeof(DefDomainEntry) + eventCnt * sizeof(DefEventEntry) + poolSize;
+}
+
+int CompareString(const char* str, size_t len, const char* key, size_t keyLen)
+{
+    size_t minLen = std::min(len, keyLen);
+    int ret = (minLen == 0) ? 0 : memcmp(str, key, minLen);
+    if (ret != 0) {
+        return ret;
+    }
+    if (len == keyLen) {
+        return 0;
+    }
+    return (len < keyLen) ? -1 : 1;
+}
+
+class StringPool {
+public:
+    DefStrRef Intern(const std::string& str)
+    {
+        auto iter = refs_.find(str);
+        if (iter != refs_.end()) {
+            return iter->second;
+        }
+        DefStrRef ref = { static_cast<uint32_t>(pool_.size()), static_cast<uint32_t>(str.size()) };
+        pool_.append(str);
+        refs_[str] = ref;
+        return ref;
+    }
+
+    const std::string& GetPool() const
+    {
+        return pool_;
+    }
+
+private:
+    std::string pool_;
+    std::unordered_map<std::string, DefStrRef> refs_;
+};
+}
+
+EventDefTable::~EventDefTable()
+{
+    if (mapAddr_ != nullptr) {
+        munmap(mapAddr_, mapSize_);
+        mapAddr_ = nullptr;
+    }
+}
+
+bool EventDefTable::ReadSourceStat(const std::string& srcPath, DefSourceStat& srcStat)
+{
+    struct stat st;
+    if (stat(srcPath.c_str(), &st) != 0) {
+        HIVIEW_LOGD("failed to stat file=%{public}s, errno=%{public}d", srcPath.c_str(), errno);
+        return false;
+    }
+    srcStat.size = static_cast<uint64_t>(st.st_size);
+    srcStat.mtime = static_cast<int64_t>(st.st_mtim.tv_sec) * 1000000000 + st.st_mtim.tv_nsec; // 1000000000: s to ns
+    srcStat.ino = static_cast<uint64_t>(st.st_ino);
+    return true;
+}
+
+std::shared_ptr<const EventDefTable> EventDefTable::Compile(const DOMAIN_INFO_MAP& defMap,
+    const std::string& srcPath, const DefSourceStat& srcStat)
+{
+    std::map<std::string, std::map<std::string, const BaseInfo*>> sortedMap;
+    for (const auto& domain : defMap) {
+        auto& names = sortedMap[domain.first];
+        for (const auto& name : domain.second) {
+            names[name.first] = &(name.second);
+        }
+    }
+
+    StringPool pool;
+    DefImageHeader header;
+    header.srcSize = srcStat.size;
+    header.srcMtime = srcStat.mtime;
+    header.srcIno = srcStat.ino;
+    header.srcPath = pool.Intern(srcPath);
+    std::vector<DefDomainEntry> domains;
+    std::vector<DefEventEntry> events;
+    domains.reserve(sortedMap.size());
+    for (const auto& domain : sortedMap) {
+        DefDomainEntry domainEntry;
+        domainEntry.name = pool.Intern(domain.first);
+        domainEntry.firstEvent = static_cast<uint32_t>(events.size());
+        domainEntry.eventCnt = static_cast<uint32_t>(domain.second.size());
+        domains.emplace_back(domainEntry);
+        for (const auto& name : domain.second) {
+            DefEventEntry eventEntry;
+            eventEntry.name = pool.Intern(name.first);
+            eventEntry.level = pool.Intern(name.second->level);
+            eventEntry.tag = pool.Intern(name.second->tag);
+            eventEntry.type = name.second->type;
+            eventEntry.privacy = name.second->privacy;
+            eventEntry.preserve = name.second->preserve ? 1 : 0;
+            events.emplace_back(eventEntry);
+        }
+    }
+    header.domainCnt = static_cast<uint32_t>(domains.size());
+    header.eventCnt = static_cast<uint32_t>(events.size());
+    header.poolSize = static_cast<uint32_t>(pool.GetPool().size());
+    uint64_t imageSize = GetImageSize(header.domainCnt, header.eventCnt, header.poolSize);
+    if (imageSize > MAX_DEF_IMAGE_SIZE) {
+        HIVIEW_LOGE("def table is too large, size=%{public}" PRIu64, imageSize);
+        return nullptr;
+    }
+
+    std::shared_ptr<EventDefTable> table(new EventDefTable());
+    table->buffer_.resize(imageSize);
+    char* dest = table->buffer_.data();
+    (void)memcpy(dest, &header, sizeof(header));
+    dest += sizeof(header);
+    if (!domains.empty()) {
+        (void)memcpy(dest, domains.data(), domains.size() * sizeof(DefDomainEntry));
+        dest += domains.size() * sizeof(DefDomainEntry);
+    }
+    if (!events.empty()) {
+        (void)memcpy(dest, events.data(), events.size() * sizeof(DefEventEntry));
+        dest += events.size() * sizeof(DefEventEntry);
+    }
+    (void)memcpy(dest, pool.GetPool().data(), pool.GetPool().size());
+    if (!table->Init(table->buffer_.data(), table->buffer_.size())) {
+        return nullptr;
+    }
+    return table;
+}
+
+std::shared_ptr<const EventDefTable> EventDefTable::LoadImage(const std::string& imagePath, const std::string& srcPath)
+{
+    DefSourceStat srcStat;
+    if (!ReadSourceStat(srcPath, srcStat)) {
+        return nullptr;
+    }
+    int fd = open(imagePath.c_str(), O_RDONLY);
+    if (fd < 0) {
+        HIVIEW_LOGD("failed to open image=%{public}s, errno=%{public}d", imagePath.c_str(), errno);
+        return nullptr;
+    }
+    struct stat st;
+    if (fstat(fd, &st) != 0 || st.st_size < static_cast<off_t>(sizeof(DefImageHeader)) ||
+        st.st_size > MAX_DEF_IMAGE_SIZE) {
+        HIVIEW_LOGW("invalid image=%{public}s", imagePath.c_str());
+        close(fd);
+        return nullptr;
+    }
+    size_t size = static_cast<size_t>(st.st_size);
+    void* addr = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (addr == MAP_FAILED) {
+        HIVIEW_LOGW("failed to map image=%{public}s, errno=%{public}d", imagePath.c_str(), errno);
+        return nullptr;
+    }
+
+    std::shared_ptr<EventDefTable> table(new EventDefTable());
+    table->mapAddr_ = addr;
+    table->mapSize_ = size;
+    if (!table->Init(static_cast<const char*>(addr), size)) {
+        HIVIEW_LOGW("image=%{public}s is corrupted", imagePath.c_str());
+        return nullptr;
+    }
+    const DefImageHeader* header = GetHeader(table->data_);
+    if (header->srcSize != srcStat.size || header->srcMtime != srcStat.mtime || header->srcIno != srcStat.ino ||
+        table->Compare(header->srcPath.offset, header->srcPath.len, srcPath) != 0) {
+        HIVIEW_LOGI("image=%{public}s is out of date", imagePath.c_str());
+        return nullptr;
+    }
+    return table;
+}
+
+bool EventDefTable::SaveImage(const std::string& imagePath) const
+{
+    if (buffer_.empty()) {
+        return false;
+    }
+    std::string tmpPath = imagePath + ".tmp";
+    if (!FileUtil::SaveBufferToFile(tmpPath, buffer_)) {
+        HIVIEW_LOGW("failed to save image=%{public}s", tmpPath.c_str());
+        return false;
+    }
+    if (!FileUtil::RenameFile(tmpPath, imagePath)) {
+        HIVIEW_LOGW("failed to rename image=%{public}s", imagePath.c_str());
+        (void)FileUtil::RemoveFile(tmpPath);
+        return false;
+    }
+    return true;
+}
+
+bool EventDefTable::Find(const std::string& domain, const std::string& name, BaseInfo& info) const
+{
+    const DefImageHeader* header = GetHeader(data_);
+    const DefDomainEntry* domainBegin = GetDomains(data_);
+    const DefDomainEntry* domainEnd = domainBegin + header->domainCnt;
+    auto domainIter = std::lower_bound(domainBegin, domainEnd, domain,
+        [this] (const DefDomainEntry& entry, const std::string& key) {
+            return Compare(entry.name.offset, entry.name.len, key) < 0;
+        });
+    if (domainIter == domainEnd || Compare(domainIter->name.offset, domainIter->name.len, domain) != 0) {
+        return false;
+    }
+    const DefEventEntry* eventBegin = GetEvents(data_) + domainIter->firstEvent;
+    const DefEventEntry* eventEnd = eventBegin + domainIter->eventCnt;
+    auto eventIter = std::lower_bound(eventBegin, eventEnd, name,
+        [this] (const DefEventEntry& entry, const std::string& key) {
+            return Compare(entry.name.offset, entry.name.len, key) < 0;
+        });
+    if (eventIter == eventEnd || Compare(eventIter->name.offset, eventIter->name.len, name) != 0) {
+        return false;
+    }
+    info.type = eventIter->type;
+    info.privacy = eventIter->privacy;
+    info.level = GetString(eventIter->level.offset, eventIter->level.len);
+    info.tag = GetString(eventIter->tag.offset, eventIter->tag.len);
+    info.preserve = (eventIter->preserve != 0);
+    return true;
+}
+
+uint32_t EventDefTable::GetDomainCount() const
+{
+    return GetHeader(data_)->domainCnt;
+}
+
+uint32_t EventDefTable::GetEventCount() const
+{
+    return GetHeader(data_)->eventCnt;
+}
+
+bool EventDefTable::Init(const char* data, size_t size)
+{
+    data_ = data;
+    size_ = size;
+    return IsValid();
+}
+
+bool EventDefTable::IsValid() const
+{
+    if (data_ == nullptr || size_ < sizeof(DefImageHeader)) {
+        return false;
+    }
+    const DefImageHeader* header = GetHeader(data_);
+    if (header->magic != DEF_IMAGE_MAGIC || header->version != DEF_IMAGE_VERSION ||
+        GetImageSize(header->domainCnt, header->eventCnt, header->poolSize) != size_ ||
+        !IsValidRange(header->srcPath.offset, header->srcPath.len)) {
+        return false;
+    }
+
+    // an image is only used after all entries are proved to be in bounds and sorted
+    const DefDomainEntry* domains = GetDomains(data_);
+    const DefEventEntry* events = GetEvents(data_);
+    const char* pool = GetPool(data_);
+    auto isAscending = [pool] (const DefStrRef& prev, const DefStrRef& cur) {
+        return CompareString(pool + prev.offset, prev.len, pool + cur.offset, cur.len) < 0;
+    };
+    for (uint32_t i = 0; i < header->domainCnt; ++i) {
+        const DefDomainEntry& domain = domains[i];
+        if (!IsValidRange(domain.name.offset, domain.name.len) ||
+            static_cast<uint64_t>(domain.firstEvent) + domain.eventCnt > header->eventCnt) {
+            return false;
+        }
+        if (i > 0 && !isAscending(domains[i - 1].name, domain.name)) {
+            return false;
+        }
+        for (uint32_t j = domain.firstEvent; j < domain.firstEvent + domain.eventCnt; ++j) {
+            const DefEventEntry& event = events[j];
+            if (!IsValidRange(event.name.offset, event.name.len) || !IsValidRange(event.level.offset, event.level.len) ||
+                !IsValidRange(event.tag.offset, event.tag.len)) {
+                return false;
+            }
+            if (j > domain.firstEvent && !isAscending(events[j - 1].name, event.name)) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+bool EventDefTable::IsValidRange(uint32_t offset, uint32_t len) const
+{
+    return static_cast<uint64_t>(offset) + len <= GetHeader(data_)->poolSize;
+}
+
+int EventDefTable::Compare(uint32_t offset, uint32_t len, const std::string& key) const
+{
+    return CompareString(GetPool(data_) + offset, len, key.data(), key.size());
+}
+
+std::string EventDefTable::GetString(uint32_t offset, uint32_t len) const
+{
+    return std::string(GetPool(data_) + offset, len);
+}
+} // namespace HiviewDFX
+} // namespace OHOS
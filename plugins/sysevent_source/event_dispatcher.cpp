@@ -0,0 +1,203 @@
+/*
+ * Copyright (c) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "event_dispatcher.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cinttypes>
+#include <string>
+
+#include <unistd.h>
+
+#include "base/raw_data_base_def.h"
+#include "base/raw_data_pool.h"
+#include "hiview_logger.h"
+#include "thread_util.h"
+
+namespace OHOS {
+namespace HiviewDFX {
+DEFINE_LOG_TAG("HiView-EventDispatcher");
+namespace {
+constexpr uint32_t MAX_DISPATCH_WORKER_NUM = 8;
+constexpr uint32_t MIN_DISPATCH_QUEUE_SIZE = 16;
+constexpr uint32_t MAX_DISPATCH_QUEUE_SIZE = 64 * 1024;
+// bounds the wait of a worker in case its wakeup is missed
+constexpr auto WORKER_WAIT_TIMEOUT = std::chrono::milliseconds(100);
+constexpr size_t PID_POS = sizeof(int32_t) + EventRaw::POS_OF_PID_IN_HEADER;
+}
+
+void DispatchRawData(const std::vector<std::shared_ptr<EventReceiver>>& receivers,
+    std::shared_ptr<EventRaw::RawData> rawData)
+{
+    if (receivers.empty() || rawData == nullptr) {
+        return;
+    }
+    // all copies are made before any handoff, so no receiver sees the data modified by another one
+    std::vector<std::shared_ptr<EventRaw::RawData>> rawDatas;
+    rawDatas.reserve(receivers.size());
+    for (size_t i = 1; i < receivers.size(); ++i) {
+        auto copiedData = EventRaw::RawDataPool::GetInstance().Acquire(rawData->GetDataLength());
+        if (copiedData == nullptr || !copiedData->Append(rawData->GetData(), rawData->GetDataLength())) {
+            HIVIEW_LOGE("failed to copy raw data.");
+            return;
+        }
+        rawDatas.emplace_back(copiedData);
+    }
+    rawDatas.emplace_back(rawData);
+    for (size_t i = 0; i < receivers.size(); ++i) {
+        receivers[i]->HandlerEvent(rawDatas[i]);
+    }
+}
+
+EventDispatcher::EventDispatcher(const std::vector<std::shared_ptr<EventReceiver>>& receivers,
+    uint32_t workerNum, uint32_t queueSize) : receivers_(receivers)
+{
+    workerNum = std::clamp<uint32_t>(workerNum, 1, MAX_DISPATCH_WORKER_NUM);
+    queueSize = std::clamp<uint32_t>(queueSize, MIN_DISPATCH_QUEUE_SIZE, MAX_DISPATCH_QUEUE_SIZE);
+    for (uint32_t i = 0; i < workerNum; ++i) {
+        workers_.emplace_back(std::make_unique<Worker>(queueSize));
+    }
+}
+
+EventDispatcher::~EventDispatcher()
+{
+    Stop();
+}
+
+void EventDispatcher::Start()
+{
+    if (isRunning_.exchange(true)) {
+        return;
+    }
+    for (uint32_t i = 0; i < workers_.size(); ++i) {
+        Worker& worker = *workers_[i];
+        worker.thread = std::thread([this, &worker, i] {
+            Run(worker, i);
+        });
+    }
+    HIVIEW_LOGI("start dispatcher, worker num=%{public}zu, queue size=%{public}zu", workers_.size(),
+        workers_.front()->queue.Capacity());
+}
+
+void EventDispatcher::Stop()
+{
+    if (!isRunning_.exchange(false)) {
+        return;
+    }
+    for (auto& worker : workers_) {
+        {
+            std::lock_guard<std::mutex> lock(worker->mutex);
+            worker->cond.notify_one();
+        }
+        if (worker->thread.joinable()) {
+            worker->thread.join();
+        }
+    }
+    HIVIEW_LOGI("stop dispatcher");
+}
+
+void EventDispatcher::HandlerEvent(std::shared_ptr<EventRaw::RawData> rawData)
+{
+    if (rawData == nullptr) {
+        return;
+    }
+    if (!isRunning_.load(std::memory_order_acquire)) {
+        // no worker to hand off to, dispatch in place
+        DispatchRawData(receivers_, rawData);
+        return;
+    }
+    Worker& worker = *workers_[SelectWorker(rawData)];
+    if (!worker.queue.Push(std::move(rawData))) {
+        worker.dropCnt.fetch_add(1, std::memory_order_relaxed);
+        if (!worker.isFull) {
+            HIVIEW_LOGW("dispatch queue is full, capacity=%{public}zu", worker.queue.Capacity());
+            worker.isFull = true;
+        }
+        return;
+    }
+    worker.isFull = false;
+    uint64_t depth = worker.queue.Size();
+    if (depth > worker.maxDepth.load(std::memory_order_relaxed)) {
+        worker.maxDepth.store(depth, std::memory_order_relaxed);
+    }
+    Notify(worker);
+}
+
+uint32_t EventDispatcher::GetWorkerNum() const
+{
+    return static_cast<uint32_t>(workers_.size());
+}
+
+void EventDispatcher::Dump(int fd)
+{
+    dprintf(fd, "EventDispatcher: worker_num=%zu, is_running=%d\n", workers_.size(), isRunning_.load() ? 1 : 0);
+    for (size_t i = 0; i < workers_.size(); ++i) {
+        Worker& worker = *workers_[i];
+        dprintf(fd, "worker[%zu]: queue_depth=%zu, max_depth=%" PRIu64 ", capacity=%zu, dispatch_count=%" PRIu64
+            ", drop_count=%" PRIu64 "\n", i, worker.queue.Size(), worker.maxDepth.load(std::memory_order_relaxed),
+            worker.queue.Capacity(), worker.dispatchCnt.load(std::memory_order_relaxed),
+            worker.dropCnt.load(std::memory_order_relaxed));
+    }
+}
+
+void EventDispatcher::Run(Worker& worker, uint32_t index)
+{
+    Thread::SetThreadDescription("EventDispatch" + std::to_string(index));
+    std::shared_ptr<EventRaw::RawData> rawData;
+    while (true) {
+        if (worker.queue.Pop(rawData)) {
+            DispatchRawData(receivers_, std::move(rawData));
+            rawData = nullptr;
+            worker.dispatchCnt.fetch_add(1, std::memory_order_relaxed);
+            continue;
+        }
+        // the events left in queue are dispatched before stopping
+        if (!isRunning_.load(std::memory_order_acquire)) {
+            if (worker.queue.Size() == 0) {
+                break;
+            }
+            continue;
+        }
+        std::unique_lock<std::mutex> lock(worker.mutex);
+        worker.isWaiting.store(true, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (worker.queue.Size() == 0 && isRunning_.load(std::memory_order_acquire)) {
+            worker.cond.wait_for(lock, WORKER_WAIT_TIMEOUT);
+        }
+        worker.isWaiting.store(false, std::memory_order_relaxed);
+    }
+}
+
+void EventDispatcher::Notify(Worker& worker)
+{
+    // pairs with the fence in Run, either the worker sees the event pushed or it is seen waiting here
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (worker.isWaiting.load(std::memory_order_relaxed)) {
+        std::lock_guard<std::mutex> lock(worker.mutex);
+        worker.cond.notify_one();
+    }
+}
+
+uint32_t EventDispatcher::SelectWorker(const std::shared_ptr<EventRaw::RawData>& rawData)
+{
+    if (workers_.size() == 1 || rawData->GetData() == nullptr ||
+        rawData->GetDataLength() < PID_POS + sizeof(int32_t)) {
+        return 0;
+    }
+    uint32_t pid = *(reinterpret_cast<uint32_t*>(rawData->GetData() + PID_POS));
+    return pid % static_cast<uint32_t>(workers_.size());
+}
+} // namespace HiviewDFX
+} // namespace OHOS
@@ -51,7 +51,8 @@ bool ReadSysEventDefFromFile(const std::string& path, Json::Value& hiSysEventDef
 }
 }
 
-EventJsonParser::EventJsonParser(const std::string& defFilePath)
+EventJsonParser::EventJsonParser(const std::string& defFilePath, const std::string& imageFilePath)
+    : imageFilePath_(imageFilePath)
 {
     // read json file
     ReadDefFile(defFilePath);
@@ -75,22 +76,17 @@ bool EventJsonParser::GetPreserveByDomainAndName(const std::string& domain, cons
 BaseInfo EventJsonParser::GetDefinedBaseInfoByDomainName(const std::string& domain,
     const std::string& name) const
 {
-    if (hiSysEventDefMap_ == nullptr) {
-        HIVIEW_LOGD("sys def map is null");
+    auto defTable = std::atomic_load(&defTable_);
+    if (defTable == nullptr) {
+        HIVIEW_LOGD("sys def table is null");
         return BaseInfo();
     }
-    auto domainIter = hiSysEventDefMap_->find(domain);
-    if (domainIter == hiSysEventDefMap_->end()) {
-        HIVIEW_LOGD("domain %{public}s is not defined.", domain.c_str());
-        return BaseInfo();
-    }
-    auto domainNames = hiSysEventDefMap_->at(domain);
-    auto nameIter = domainNames.find(name);
-    if (nameIter == domainNames.end()) {
+    BaseInfo baseInfo;
+    if (!defTable->Find(domain, name, baseInfo)) {
         HIVIEW_LOGD("%{public}s is not defined in domain %{public}s.", name.c_str(), domain.c_str());
         return BaseInfo();
     }
-    return nameIter->second;
+    return baseInfo;
 }
 
 bool EventJsonParser::HasIntMember(const Json::Value& jsonObj, const std::string& name) const
@@ -189,14 +185,41 @@ NAME_INFO_MAP EventJsonParser::ParseNameConfig(const Json::Value& domainJson) co
 
 void EventJsonParser::ReadDefFile(const std::string& defFilePath)
 {
+    // readers keep using the old table until the new one is published
+    std::lock_guard<std::mutex> lock(updateMutex_);
+    std::shared_ptr<const EventDefTable> defTable = nullptr;
+    if (!imageFilePath_.empty()) {
+        defTable = EventDefTable::LoadImage(imageFilePath_, defFilePath);
+    }
+    if (defTable == nullptr) {
+        defTable = CompileDefFile(defFilePath);
+        if (defTable == nullptr) {
+            return;
+        }
+        if (!imageFilePath_.empty() && !defTable->SaveImage(imageFilePath_)) {
+            HIVIEW_LOGW("failed to save def image: %{public}s", imageFilePath_.c_str());
+        }
+    }
+    HIVIEW_LOGI("def table is loaded, domain count=%{public}u, event count=%{public}u",
+        defTable->GetDomainCount(), defTable->GetEventCount());
+    std::atomic_store(&defTable_, defTable);
+}
+
+std::shared_ptr<const EventDefTable> EventJsonParser::CompileDefFile(const std::string& defFilePath)
+{
+    DefSourceStat srcStat;
+    if (!EventDefTable::ReadSourceStat(defFilePath, srcStat)) {
+        HIVIEW_LOGE("def file is not accessible: %{public}s", defFilePath.c_str());
+        return nullptr;
+    }
     Json::Value hiSysEventDef;
     if (!ReadSysEventDefFromFile(defFilePath, hiSysEventDef)) {
         HIVIEW_LOGE("parse json file failed, please check the style of json file: %{public}s", defFilePath.c_str());
-        return;
+        return nullptr;
     }
     auto tmpMap = std::make_shared<DOMAIN_INFO_MAP>();
     ParseHiSysEventDef(hiSysEventDef, tmpMap);
-    hiSysEventDefMap_ = tmpMap;
+    return EventDefTable::Compile(*tmpMap, defFilePath, srcStat);
 }
 } // namespace HiviewDFX
 } // namespace OHOS
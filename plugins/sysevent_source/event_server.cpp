@@ -15,8 +15,11 @@
 
 #include "event_server.h"
 
+#include <algorithm>
+#include <cinttypes>
 #include <fstream>
 #include <memory>
+#include <new>
 #include <string>
 #include <vector>
 
@@ -31,10 +34,13 @@
 #include <securec.h>
 
 #include "base/raw_data_base_def.h"
+#include "base/raw_data_pool.h"
 #include "decoded/decoded_event.h"
 #include "device_node.h"
+#include "event_dispatcher.h"
 #include "init_socket.h"
 #include "hiview_logger.h"
+#include "monitor_config.h"
 #include "socket_util.h"
 
 #define SOCKET_FILE_DIR "/dev/unix/socket/hisysevent"
@@ -44,6 +50,10 @@ namespace HiviewDFX {
 DEFINE_LOG_TAG("HiView-EventServer");
 namespace {
 constexpr int BUFFER_SIZE = 384 * 1024;
+constexpr uint32_t MAX_RECV_BATCH_SIZE = 32;
+constexpr size_t RECV_SLOT_SIZE = BUFFER_SIZE + 1; // one more byte for the terminator set by IsValidMsg
+constexpr size_t RECV_CTRL_SIZE = CMSG_SPACE(sizeof(struct ucred));
+constexpr char MONITOR_CONFIG_PATH[] = "/system/etc/hiview/monitor.cfg";
 #ifndef KERNEL_DEVICE_BUFFER
 constexpr int EVENT_READ_BUFFER = 2048;
 #else
@@ -89,51 +99,49 @@ std::shared_ptr<EventRaw::RawData> ConverRawData(char* source)
         return nullptr;
     }
     uint32_t sourceLen = *(reinterpret_cast<uint32_t*>(source));
-    uint32_t desLen = sourceLen + sizeof(uint8_t);
-    uint8_t* des = reinterpret_cast<uint8_t*>(malloc(desLen));
-    if (des == nullptr) {
-        HIVIEW_LOGE("malloc failed.");
+    uint32_t sourceHeaderLen = sizeof(int32_t) + sizeof(EventRaw::HiSysEventHeader) - sizeof(uint8_t);
+    if (sourceLen < sourceHeaderLen) {
+        HIVIEW_LOGE("invalid source length=%{public}u.", sourceLen);
         return nullptr;
     }
-    uint32_t sourceHeaderLen = sizeof(int32_t) + sizeof(EventRaw::HiSysEventHeader) - sizeof(uint8_t);
-    if (memcpy_s(des, desLen, source, sourceHeaderLen) != EOK) {
-        HIVIEW_LOGE("copy failed.");
-        free(des);
+    // copy straight from the receive buffer into the raw data and insert the log flag on the way,
+    // so each event is copied only once before it reaches the pipeline
+    int32_t desLen = static_cast<int32_t>(sourceLen + sizeof(uint8_t));
+    auto rawData = EventRaw::RawDataPool::GetInstance().Acquire(static_cast<size_t>(desLen));
+    if (rawData == nullptr) {
+        HIVIEW_LOGE("failed to acquire raw data.");
         return nullptr;
     }
-    *(reinterpret_cast<uint8_t*>(des + sourceHeaderLen)) = 0; // init header.log flag
-    uint32_t desPos = sourceHeaderLen + sizeof(uint8_t);
-    if (memcpy_s(des + desPos, desLen - desPos, source + sourceHeaderLen, sourceLen - sourceHeaderLen) != EOK) {
+    uint8_t* sourceData = reinterpret_cast<uint8_t*>(source);
+    uint8_t logFlag = 0; // init header.log flag
+    if (rawData->GetData() == nullptr ||
+        !rawData->Append(reinterpret_cast<uint8_t*>(&desLen), sizeof(int32_t)) ||
+        !rawData->Append(sourceData + sizeof(int32_t), sourceHeaderLen - sizeof(int32_t)) ||
+        !rawData->Append(&logFlag, sizeof(uint8_t)) ||
+        !rawData->Append(sourceData + sourceHeaderLen, sourceLen - sourceHeaderLen)) {
         HIVIEW_LOGE("copy failed.");
-        free(des);
         return nullptr;
     }
-    *(reinterpret_cast<int32_t*>(des)) = desLen;
-    auto rawData = std::make_shared<EventRaw::RawData>(des, desLen);
-    free(des);
     return rawData;
 }
 
-void InitMsgh(char* buffer, int bufferLen, std::array<char, CMSG_SPACE(sizeof(struct ucred))>& control,
-    struct msghdr& msgh, struct iovec& iov)
+void DispatchRawData(std::vector<std::shared_ptr<EventReceiver>>& receivers, char* buffer)
 {
-    iov.iov_base = buffer;
-    iov.iov_len = static_cast<uint32_t>(bufferLen);
-    msgh.msg_iov = &iov;
-    msgh.msg_iovlen = 1; // 1 is length of io vector
-
-    msgh.msg_control = control.data();
-    msgh.msg_controllen = control.size();
-
-    msgh.msg_name = nullptr;
-    msgh.msg_namelen = 0;
-    msgh.msg_flags = 0;
+    if (receivers.empty()) {
+        return;
+    }
+    // the receive buffer is reused at once, so the event is copied out before being handed off
+    auto rawData = ConverRawData(buffer);
+    if (rawData == nullptr) {
+        return;
+    }
+    HiviewDFX::DispatchRawData(receivers, rawData);
 }
 
 pid_t ReadPidFromMsgh(struct msghdr& msgh)
 {
     struct cmsghdr* cmsg = CMSG_FIRSTHDR(&msgh);
-    if (cmsg == nullptr) {
+    if (cmsg == nullptr || cmsg->cmsg_level != SOL_SOCKET || cmsg->cmsg_type != SCM_CREDENTIALS) {
         return UN_INIT_INT_TYPE_VAL;
     }
     struct ucred* uCredRecv = reinterpret_cast<struct ucred*>(CMSG_DATA(cmsg));
@@ -144,6 +152,16 @@ pid_t ReadPidFromMsgh(struct msghdr& msgh)
 }
 }
 
+SocketDevice::SocketDevice(uint32_t batchSize)
+{
+    batchSize_ = std::clamp<uint32_t>(batchSize, 1, MAX_RECV_BATCH_SIZE);
+}
+
+SocketDevice::~SocketDevice()
+{
+    Close();
+}
+
 void SocketDevice::InitSocket(int &socketId)
 {
     struct sockaddr_un serverAddr;
@@ -184,6 +202,10 @@ int SocketDevice::Open()
         HIVIEW_LOGE("hisysevent create socket failed");
         return -1;
     }
+    if (!InitRecvRing()) {
+        Close();
+        return -1;
+    }
     return socketId_;
 }
 
@@ -232,35 +254,101 @@ void SocketDevice::SetUCredPid(const pid_t pid)
     uCredPid_ = pid;
 }
 
+bool SocketDevice::InitRecvRing()
+{
+    if (msgs_ != nullptr) {
+        return true;
+    }
+    // the slots are not zeroed, so only the pages really written by the kernel become resident
+    recvBuf_.reset(new(std::nothrow) char[RECV_SLOT_SIZE * batchSize_]);
+    ctrlBuf_.reset(new(std::nothrow) char[RECV_CTRL_SIZE * batchSize_]);
+    msgs_.reset(new(std::nothrow) struct mmsghdr[batchSize_]);
+    iovs_.reset(new(std::nothrow) struct iovec[batchSize_]);
+    if (recvBuf_ == nullptr || ctrlBuf_ == nullptr || msgs_ == nullptr || iovs_ == nullptr) {
+        HIVIEW_LOGE("failed to alloc receive ring, batch size=%{public}u", batchSize_);
+        recvBuf_.reset();
+        ctrlBuf_.reset();
+        msgs_.reset();
+        iovs_.reset();
+        return false;
+    }
+    HIVIEW_LOGI("init receive ring, batch size=%{public}u", batchSize_);
+    return true;
+}
+
+void SocketDevice::ResetRecvRing(uint32_t count)
+{
+    for (uint32_t i = 0; i < count; ++i) {
+        iovs_[i].iov_base = recvBuf_.get() + i * RECV_SLOT_SIZE;
+        iovs_[i].iov_len = BUFFER_SIZE;
+        struct msghdr& msgh = msgs_[i].msg_hdr;
+        msgh.msg_name = nullptr;
+        msgh.msg_namelen = 0;
+        msgh.msg_iov = &iovs_[i];
+        msgh.msg_iovlen = 1; // 1 is length of io vector
+        msgh.msg_control = ctrlBuf_.get() + i * RECV_CTRL_SIZE;
+        msgh.msg_controllen = RECV_CTRL_SIZE; // updated by kernel on each receive, so reset every time
+        msgh.msg_flags = 0;
+        msgs_[i].msg_len = 0;
+    }
+}
+
+void SocketDevice::UpdateRecvStat(uint32_t msgCnt, uint32_t dropCnt)
+{
+    batchCnt_.fetch_add(1, std::memory_order_relaxed);
+    msgCnt_.fetch_add(msgCnt, std::memory_order_relaxed);
+    if (dropCnt > 0) {
+        dropCnt_.fetch_add(dropCnt, std::memory_order_relaxed);
+    }
+    if (msgCnt > maxBatchMsgCnt_.load(std::memory_order_relaxed)) {
+        maxBatchMsgCnt_.store(msgCnt, std::memory_order_relaxed);
+    }
+}
+
 int SocketDevice::ReceiveMsg(std::vector<std::shared_ptr<EventReceiver>> &receivers)
 {
-    char* buffer = new char[BUFFER_SIZE + 1]();
-    std::array<char, CMSG_SPACE(sizeof(struct ucred))> control = {0};
-    struct msghdr msgh = {0};
-    struct iovec iov = {
-        .iov_base = nullptr,
-        .iov_len = 0
-    };
-    InitMsgh(buffer, BUFFER_SIZE, control, msgh, iov);
+    if (msgs_ == nullptr && !InitRecvRing()) {
+        return -1;
+    }
     while (true) {
-        int ret = recvmsg(socketId_, &msgh, 0);
-        if (ret <= 0) {
+        ResetRecvRing(batchSize_);
+        int msgCnt = recvmmsg(socketId_, msgs_.get(), batchSize_, MSG_DONTWAIT, nullptr);
+        if (msgCnt <= 0) {
             HIVIEW_LOGD("failed to recv msg from socket");
             break;
         }
-        pid_t uCredPid = ReadPidFromMsgh(msgh);
-        SetUCredPid(uCredPid);
-        if (!IsValidMsg(buffer, ret)) {
-            break;
-        }
-        for (auto receiver = receivers.begin(); receiver != receivers.end(); receiver++) {
-            (*receiver)->HandlerEvent(ConverRawData(buffer));
+        uint32_t dropCnt = 0;
+        for (int i = 0; i < msgCnt; ++i) {
+            char* buffer = static_cast<char*>(iovs_[i].iov_base);
+            struct msghdr& msgh = msgs_[i].msg_hdr;
+            if ((msgh.msg_flags & MSG_TRUNC) != 0) {
+                HIVIEW_LOGW("msg is truncated, len=%{public}u", msgs_[i].msg_len);
+                ++dropCnt;
+                continue;
+            }
+            // credentials are verified per message since one batch may come from different processes
+            SetUCredPid(ReadPidFromMsgh(msgh));
+            if (!IsValidMsg(buffer, static_cast<int32_t>(msgs_[i].msg_len))) {
+                ++dropCnt;
+                continue;
+            }
+            DispatchRawData(receivers, buffer);
         }
+        UpdateRecvStat(static_cast<uint32_t>(msgCnt), dropCnt);
     }
-    delete[] buffer;
     return 0;
 }
 
+void SocketDevice::Dump(int fd)
+{
+    uint64_t batchCnt = batchCnt_.load(std::memory_order_relaxed);
+    uint64_t msgCnt = msgCnt_.load(std::memory_order_relaxed);
+    dprintf(fd, "%s: batch_size=%u, batch_count=%" PRIu64 ", msg_count=%" PRIu64 ", avg_msg_per_batch=%.2f, "
+        "max_msg_per_batch=%" PRIu64 ", drop_count=%" PRIu64 "\n", GetName().c_str(), batchSize_, batchCnt, msgCnt,
+        (batchCnt == 0) ? 0.0 : (static_cast<double>(msgCnt) / batchCnt),
+        maxBatchMsgCnt_.load(std::memory_order_relaxed), dropCnt_.load(std::memory_order_relaxed));
+}
+
 int BBoxDevice::Close()
 {
     if (fd_ > 0) {
@@ -320,9 +408,7 @@ int BBoxDevice::ReceiveMsg(std::vector<std::shared_ptr<EventReceiver>> &receiver
     if (!IsValidMsg(buffer, ret)) {
         return -1;
     }
-    for (auto receiver = receivers.begin(); receiver != receivers.end(); receiver++) {
-        (*receiver)->HandlerEvent(ConverRawData(buffer));
-    }
+    DispatchRawData(receivers, buffer);
     return 0;
 }
 
@@ -333,6 +419,7 @@ void EventServer::AddDev(std::shared_ptr<DeviceNode> dev)
         HIVIEW_LOGI("open device %{public}s failed", dev->GetName().c_str());
         return;
     }
+    std::lock_guard<std::mutex> lock(devMutex_);
     devs_[fd] = dev;
 }
 
@@ -350,6 +437,7 @@ int EventServer::OpenDevs()
 
 int EventServer::AddToMonitor(int pollFd, struct epoll_event pollEvents[])
 {
+    std::lock_guard<std::mutex> lock(devMutex_);
     int index = 0;
     auto it = devs_.begin();
     while (it != devs_.end()) {
@@ -376,6 +464,23 @@ int EventServer::AddToMonitor(int pollFd, struct epoll_event pollEvents[])
     return 0;
 }
 
+void EventServer::InitDispatcher()
+{
+    uint32_t workerNum = DEFAULT_DISPATCH_WORKER_NUM;
+    uint32_t queueSize = DEFAULT_DISPATCH_QUEUE_SIZE;
+    MonitorConfig monitorConfig(MONITOR_CONFIG_PATH);
+    if (monitorConfig.Parse()) {
+        monitorConfig.ReadParam("dispatchWorkerNum", workerNum);
+        monitorConfig.ReadParam("dispatchQueueSize", queueSize);
+    }
+    auto dispatcher = std::make_shared<EventDispatcher>(receivers_, workerNum, queueSize);
+    dispatcher->Start();
+    std::lock_guard<std::mutex> lock(devMutex_);
+    dispatcher_ = dispatcher;
+    // devices only hand the events received to the dispatcher, the receivers run on its workers
+    dispatchReceivers_ = { dispatcher_ };
+}
+
 void EventServer::Start()
 {
     HIVIEW_LOGD("start event server");
@@ -394,6 +499,7 @@ void EventServer::Start()
         return;
     }
 
+    InitDispatcher();
     HIVIEW_LOGI("go into event loop");
     isStart_ = true;
     while (isStart_) {
@@ -405,14 +511,16 @@ void EventServer::Start()
         }
         for (int ii = 0; ii < eventCount; ii++) {
             auto it = devs_.find(chkPollEvents[ii].data.fd);
-            it->second->ReceiveMsg(receivers_);
+            it->second->ReceiveMsg(dispatchReceivers_);
         }
     }
     CloseDevs();
+    dispatcher_->Stop();
 }
 
 void EventServer::CloseDevs()
 {
+    std::lock_guard<std::mutex> lock(devMutex_);
     for (auto devItem : devs_) {
         devItem.second->Close();
     }
@@ -427,5 +535,20 @@ void EventServer::AddReceiver(std::shared_ptr<EventReceiver> receiver)
 {
     receivers_.emplace_back(receiver);
 }
+
+void EventServer::Dump(int fd)
+{
+    if (!isStart_) {
+        dprintf(fd, "event server is not started\n");
+        return;
+    }
+    std::lock_guard<std::mutex> lock(devMutex_);
+    for (auto& devItem : devs_) {
+        devItem.second->Dump(fd);
+    }
+    if (dispatcher_ != nullptr) {
+        dispatcher_->Dump(fd);
+    }
+}
 } // namespace HiviewDFX
 } // namespace OHOS
@@ -0,0 +1,85 @@
+/*
+ * Copyright (c) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef HIVIEW_PLUGINS_EVENT_SERVICE_INCLUDE_EVENT_DEF_TABLE_H
+#define HIVIEW_PLUGINS_EVENT_SERVICE_INCLUDE_EVENT_DEF_TABLE_H
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace OHOS {
+namespace HiviewDFX {
+constexpr uint8_t INVALID_EVENT_TYPE = 0;
+constexpr uint8_t DEFAULT_PRIVACY = 4;
+
+struct BaseInfo {
+    uint8_t type = INVALID_EVENT_TYPE;
+    uint8_t privacy = DEFAULT_PRIVACY;
+    std::string level;
+    std::string tag;
+    bool preserve = true;
+};
+using NAME_INFO_MAP = std::unordered_map<std::string, BaseInfo>;
+using DOMAIN_INFO_MAP = std::unordered_map<std::string, NAME_INFO_MAP>;
+
+struct DefSourceStat {
+    uint64_t size = 0;
+    int64_t mtime = 0;
+    uint64_t ino = 0;
+};
+
+/*
+ * Read-only, flattened view of hisysevent.def. Domains and names are sorted
+ * and interned into one string pool, so a lookup is two binary searches over
+ * contiguous arrays. The same layout is saved as a binary image which can be
+ * mapped directly at the next boot instead of parsing the json again.
+ */
+class EventDefTable {
+public:
+    ~EventDefTable();
+    EventDefTable(const EventDefTable&) = delete;
+    EventDefTable& operator=(const EventDefTable&) = delete;
+
+    static bool ReadSourceStat(const std::string& srcPath, DefSourceStat& srcStat);
+    static std::shared_ptr<const EventDefTable> Compile(const DOMAIN_INFO_MAP& defMap,
+        const std::string& srcPath, const DefSourceStat& srcStat);
+    static std::shared_ptr<const EventDefTable> LoadImage(const std::string& imagePath, const std::string& srcPath);
+
+    bool SaveImage(const std::string& imagePath) const;
+    bool Find(const std::string& domain, const std::string& name, BaseInfo& info) const;
+    uint32_t GetDomainCount() const;
+    uint32_t GetEventCount() const;
+
+private:
+    EventDefTable() = default;
+    bool Init(const char* data, size_t size);
+    bool IsValid() const;
+    bool IsValidRange(uint32_t offset, uint32_t len) const;
+    int Compare(uint32_t offset, uint32_t len, const std::string& key) const;
+    std::string GetString(uint32_t offset, uint32_t len) const;
+
+private:
+    std::vector<char> buffer_;
+    void* mapAddr_ = nullptr;
+    size_t mapSize_ = 0;
+    const char* data_ = nullptr;
+    size_t size_ = 0;
+}; // EventDefTable
+} // namespace HiviewDFX
+} // namespace OHOS
+#endif
@@ -0,0 +1,135 @@
+/*
+ * Copyright (c) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef EVENT_DISPATCHER_H
+#define EVENT_DISPATCHER_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "base/raw_data.h"
+#include "device_node.h"
+
+namespace OHOS {
+namespace HiviewDFX {
+// the pipeline plugins get OnEvent from every worker, keep one until all of them can take concurrent events
+constexpr uint32_t DEFAULT_DISPATCH_WORKER_NUM = 1;
+constexpr uint32_t DEFAULT_DISPATCH_QUEUE_SIZE = 1024;
+
+// bounded ring buffer, lock free as long as only one thread pushes and only one thread pops
+template<typename T>
+class SpscQueue {
+public:
+    explicit SpscQueue(size_t capacity)
+    {
+        size_t size = 1;
+        while (size < capacity) {
+            size <<= 1;
+        }
+        items_.resize(size);
+        mask_ = size - 1;
+    }
+
+    bool Push(T&& item)
+    {
+        size_t tail = tail_.load(std::memory_order_relaxed);
+        if (tail - head_.load(std::memory_order_acquire) > mask_) {
+            return false;
+        }
+        items_[tail & mask_] = std::move(item);
+        tail_.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    bool Pop(T& item)
+    {
+        size_t head = head_.load(std::memory_order_relaxed);
+        if (head == tail_.load(std::memory_order_acquire)) {
+            return false;
+        }
+        item = std::move(items_[head & mask_]);
+        head_.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    size_t Size() const
+    {
+        return tail_.load(std::memory_order_acquire) - head_.load(std::memory_order_acquire);
+    }
+
+    size_t Capacity() const
+    {
+        return mask_ + 1;
+    }
+
+private:
+    static constexpr size_t CACHE_LINE_SIZE = 64;
+    std::vector<T> items_;
+    size_t mask_ = 0;
+    alignas(CACHE_LINE_SIZE) std::atomic<size_t> head_ { 0 };
+    alignas(CACHE_LINE_SIZE) std::atomic<size_t> tail_ { 0 };
+};
+
+// hands raw data to every receiver, all but the last one get a copy since receivers may modify it
+void DispatchRawData(const std::vector<std::shared_ptr<EventReceiver>>& receivers,
+    std::shared_ptr<EventRaw::RawData> rawData);
+
+/*
+ * Decouples receiving from validating and dispatching: raw datas received are queued to a worker chosen
+ * by the pid of the producer, so events of one process keep their order while the receive thread goes
+ * back to the devices at once. HandlerEvent must only be called by the receive thread.
+ */
+class EventDispatcher : public EventReceiver {
+public:
+    EventDispatcher(const std::vector<std::shared_ptr<EventReceiver>>& receivers,
+        uint32_t workerNum = DEFAULT_DISPATCH_WORKER_NUM, uint32_t queueSize = DEFAULT_DISPATCH_QUEUE_SIZE);
+    ~EventDispatcher() override;
+    void Start();
+    void Stop();
+    void HandlerEvent(std::shared_ptr<EventRaw::RawData> rawData) override;
+    uint32_t GetWorkerNum() const;
+    void Dump(int fd);
+
+private:
+    struct Worker {
+        explicit Worker(size_t queueSize): queue(queueSize) {}
+        SpscQueue<std::shared_ptr<EventRaw::RawData>> queue;
+        std::thread thread;
+        std::mutex mutex;
+        std::condition_variable cond;
+        std::atomic<bool> isWaiting { false };
+        bool isFull = false; // only accessed by the receive thread
+
+        // statistics, read by dump thread
+        std::atomic<uint64_t> dispatchCnt { 0 };
+        std::atomic<uint64_t> dropCnt { 0 };
+        std::atomic<uint64_t> maxDepth { 0 };
+    };
+    void Run(Worker& worker, uint32_t index);
+    void Notify(Worker& worker);
+    uint32_t SelectWorker(const std::shared_ptr<EventRaw::RawData>& rawData);
+
+private:
+    std::vector<std::shared_ptr<EventReceiver>> receivers_;
+    std::vector<std::unique_ptr<Worker>> workers_;
+    std::atomic<bool> isRunning_ { false };
+};
+} // namespace HiviewDFX
+} // namespace OHOS
+#endif // EVENT_DISPATCHER_H
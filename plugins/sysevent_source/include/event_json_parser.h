@@ -20,32 +20,22 @@
 #include <functional>
 #include <list>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <unordered_map>
 #include <vector>
 
+#include "event_def_table.h"
 #include "json/json.h"
 #include "sys_event.h"
 
 namespace OHOS {
 namespace HiviewDFX {
-constexpr uint8_t INVALID_EVENT_TYPE = 0;
-constexpr uint8_t DEFAULT_PRIVACY = 4;
-
-struct BaseInfo {
-    uint8_t type = INVALID_EVENT_TYPE;
-    uint8_t privacy = DEFAULT_PRIVACY;
-    std::string level;
-    std::string tag;
-    bool preserve = true;
-};
-using NAME_INFO_MAP = std::unordered_map<std::string, BaseInfo>;
-using DOMAIN_INFO_MAP = std::unordered_map<std::string, NAME_INFO_MAP>;
 using JSON_VALUE_LOOP_HANDLER = std::function<void(const std::string&, const Json::Value&)>;
 
 class EventJsonParser {
 public:
-    EventJsonParser(const std::string& defFilePath);
+    EventJsonParser(const std::string& defFilePath, const std::string& imageFilePath = "");
     ~EventJsonParser() {};
 
 public:
@@ -64,9 +54,12 @@ private:
     void ParseHiSysEventDef(const Json::Value& hiSysEventDef, std::shared_ptr<DOMAIN_INFO_MAP> sysDefMap);
     NAME_INFO_MAP ParseNameConfig(const Json::Value& domainJson) const;
     void WatchTestTypeParameter();
+    std::shared_ptr<const EventDefTable> CompileDefFile(const std::string& defFilePath);
 
 private:
-    std::shared_ptr<DOMAIN_INFO_MAP> hiSysEventDefMap_ = nullptr;
+    std::string imageFilePath_;
+    std::mutex updateMutex_;
+    std::shared_ptr<const EventDefTable> defTable_ = nullptr;
 }; // EventJsonParser
 } // namespace HiviewDFX
 } // namespace OHOS
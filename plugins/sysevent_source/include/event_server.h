@@ -16,35 +16,58 @@
 #ifndef COER_EVENT_SERVER_H
 #define COER_EVENT_SERVER_H
 
+#include <atomic>
 #include <map>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <vector>
 
 #include "device_node.h"
+#include "event_dispatcher.h"
 
 struct epoll_event;
+struct mmsghdr;
+struct iovec;
 namespace OHOS {
 namespace HiviewDFX {
 constexpr int UN_INIT_INT_TYPE_VAL = -1;
+constexpr uint32_t DEFAULT_RECV_BATCH_SIZE = 8;
 class SocketDevice : public DeviceNode {
 public:
-    SocketDevice() {};
-    virtual ~SocketDevice() {};
+    explicit SocketDevice(uint32_t batchSize = DEFAULT_RECV_BATCH_SIZE);
+    virtual ~SocketDevice();
     int Close() override;
     int Open() override;
     uint32_t GetEvents() override;
     std::string GetName() override;
     int ReceiveMsg(std::vector<std::shared_ptr<EventReceiver>> &receivers) override;
     bool IsValidMsg(char* msg, int32_t len) override;
+    void Dump(int fd) override;
 
 private:
     void InitSocket(int &socketId);
     void SetUCredPid(const pid_t pid);
+    bool InitRecvRing();
+    void ResetRecvRing(uint32_t count);
+    void UpdateRecvStat(uint32_t msgCnt, uint32_t dropCnt);
 
 private:
     int socketId_ = UN_INIT_INT_TYPE_VAL;
     pid_t uCredPid_ = UN_INIT_INT_TYPE_VAL;
+
+    // buffer ring allocated once and reused by every recvmmsg call
+    uint32_t batchSize_ = DEFAULT_RECV_BATCH_SIZE;
+    std::unique_ptr<char[]> recvBuf_;
+    std::unique_ptr<char[]> ctrlBuf_;
+    std::unique_ptr<struct mmsghdr[]> msgs_;
+    std::unique_ptr<struct iovec[]> iovs_;
+
+    // receive statistics, read by dump thread
+    std::atomic<uint64_t> batchCnt_ { 0 };
+    std::atomic<uint64_t> msgCnt_ { 0 };
+    std::atomic<uint64_t> maxBatchMsgCnt_ { 0 };
+    std::atomic<uint64_t> dropCnt_ { 0 };
 };
 
 class BBoxDevice : public DeviceNode {
@@ -70,14 +93,19 @@ public:
     void Start();
     void Stop();
     void AddReceiver(std::shared_ptr<EventReceiver> receiver);
+    void Dump(int fd);
 private:
     void AddDev(std::shared_ptr<DeviceNode> dev);
     int OpenDevs();
     void CloseDevs();
     int AddToMonitor(int pollFd, struct epoll_event pollEvents[]);
+    void InitDispatcher();
+    std::mutex devMutex_;
     std::map<int, std::shared_ptr<DeviceNode>> devs_;
     std::vector<std::shared_ptr<EventReceiver>> receivers_;
-    bool isStart_;
+    std::shared_ptr<EventDispatcher> dispatcher_;
+    std::vector<std::shared_ptr<EventReceiver>> dispatchReceivers_;
+    std::atomic<bool> isStart_;
 };
 } // namespace HiviewDFX
 } // namespace OHOS
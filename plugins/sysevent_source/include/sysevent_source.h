@@ -16,8 +16,9 @@
 #ifndef SYS_EVENT_SOURCE_H
 #define SYS_EVENT_SOURCE_H
 
-#include <atomic>
+#include <array>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <vector>
 
@@ -72,9 +73,13 @@ private:
     std::unique_ptr<SysEventStat> sysEventStat_ = nullptr;
     std::shared_ptr<EventJsonParser> sysEventParser_ = nullptr;
     std::shared_ptr<IController> controller_;
-    std::atomic<bool> isConfigUpdated_ { false };
     std::string testType_;
-    std::list<uint64_t> eventIdList_;
+    // ids of the latest events, checked by all dispatch workers
+    static constexpr size_t EVENT_ID_CACHE_SIZE = 25;
+    std::array<uint64_t, EVENT_ID_CACHE_SIZE> eventIds_ {};
+    size_t eventIdCnt_ = 0;
+    size_t eventIdPos_ = 0;
+    std::mutex eventIdMutex_;
 };
 } // namespace HiviewDFX
 } // namespace OHOS
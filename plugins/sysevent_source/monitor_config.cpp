@@ -46,7 +46,7 @@ bool MonitorConfig::Parse()
         }
         std::smatch result;
         if (!regex_search(strTmp, result, std::regex("(collectPeriod|reportPeriod|totalSizeBenchMark|"
-            "realTimeBenchMark|processTimeBenchMark)\\s*=\\s*(\\d+)"))) {
+            "realTimeBenchMark|processTimeBenchMark|dispatchWorkerNum|dispatchQueueSize)\\s*=\\s*(\\d+)"))) {
             HIVIEW_LOGW("match field failed %{public}s", strTmp.c_str());
             continue;
         }
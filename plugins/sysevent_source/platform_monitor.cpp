@@ -89,15 +89,17 @@ void PlatformMonitor::CollectPerfProfiler()
     HIVIEW_LOGI("collect performance profiler");
     // collect data every 5 minute
     // collect event max size and max count
-    if (maxTotalCount_ < SysEvent::totalCount_) {
-        maxTotalCount_.store(SysEvent::totalCount_);
+    uint32_t curTotalCount = SysEvent::GetTotalCount();
+    int64_t curTotalSize = SysEvent::GetTotalSize();
+    if (maxTotalCount_ < curTotalCount) {
+        maxTotalCount_.store(curTotalCount);
     }
-    if (maxTotalSize_ < SysEvent::totalSize_) {
-        maxTotalSize_.store(SysEvent::totalSize_);
+    if (maxTotalSize_ < curTotalSize) {
+        maxTotalSize_.store(static_cast<uint32_t>(curTotalSize));
     }
     // total count, total size
-    totalCount_ = SysEvent::totalCount_;
-    totalSize_ = static_cast<uint32_t>(SysEvent::totalSize_);
+    totalCount_ = curTotalCount;
+    totalSize_ = static_cast<uint32_t>(curTotalSize);
     // min speed, max speed
     uint32_t onceTotalRealTime = onceTotalRealTime_;
     uint32_t onceTotalProcTime = onceTotalProcTime_;
@@ -323,8 +325,8 @@ void PlatformMonitor::GetTopEvents(std::vector<std::string> &events, std::vector
 void PlatformMonitor::ReportBreakProfile()
 {
     // report current event size and count
-    uint32_t curTotalCount_ = SysEvent::totalCount_;
-    uint32_t curTotalSize_ = static_cast<uint32_t>(SysEvent::totalSize_);
+    uint32_t curTotalCount_ = SysEvent::GetTotalCount();
+    uint32_t curTotalSize_ = static_cast<uint32_t>(SysEvent::GetTotalSize());
 
     // report current speed
     uint32_t curRealSpeed = curRealSpeed_;
@@ -368,16 +370,17 @@ void PlatformMonitor::ReportRecoverProfile()
 void PlatformMonitor::Breaking()
 {
     // collect break count and duration every break
-    if (SysEvent::totalSize_ <= totalSizeBenchMark_) {
+    int64_t curTotalSize = SysEvent::GetTotalSize();
+    if (curTotalSize <= totalSizeBenchMark_) {
         return;
     }
 
-    HIVIEW_LOGE("break as event reach critical size %{public}" PRId64, SysEvent::totalSize_.load());
+    HIVIEW_LOGE("break as event reach critical size %{public}" PRId64, curTotalSize);
     breakTimestamp_ = TimeUtil::GenerateTimestamp();
     ReportBreakProfile();
     int64_t recoveryBenchMark = static_cast<int64_t>(totalSizeBenchMark_ * 0.8); // 0.8 of total size will recover
     while (true) {
-        if (SysEvent::totalSize_ <= recoveryBenchMark) {
+        if (SysEvent::GetTotalSize() <= recoveryBenchMark) {
             break;
         }
         TimeUtil::Sleep(SLEEP_TEN_SECONDS);
@@ -15,6 +15,7 @@
 
 #include "sysevent_source.h"
 
+#include <algorithm>
 #include <functional>
 #include <memory>
 
@@ -27,6 +28,7 @@
 #include "hiview_config_util.h"
 #include "hiview_logger.h"
 #include "plugin_factory.h"
+#include "pool_allocator.h"
 #include "time_util.h"
 #include "sys_event.h"
 #include "hiview_platform.h"
@@ -43,6 +45,7 @@ DEFINE_LOG_TAG("HiView-SysEventSource");
 constexpr char DEF_FILE_NAME[] = "hisysevent.def";
 constexpr char DEF_ZIP_NAME[] = "hisysevent.zip";
 constexpr char DEF_CFG_DIR[] = "sys_event_def";
+constexpr char DEF_IMAGE_NAME[] = "hisysevent_def.img";
 constexpr char TEST_TYPE_PARAM_KEY[] = "hiviewdfx.hiview.testtype";
 constexpr char TEST_TYPE_KEY[] = "test_type_";
 
@@ -112,8 +115,9 @@ void SysEventReceiver::HandlerEvent(std::shared_ptr<EventRaw::RawData> rawData)
         HIVIEW_LOGW("raw data of sys event is null");
         return;
     }
-    std::shared_ptr<PipelineEvent> event = std::make_shared<SysEvent>("SysEventSource",
-        static_cast<PipelineEventProducer*>(&eventSource), rawData);
+    // events are created for every message received, take the memory from a pool instead of the heap
+    std::shared_ptr<PipelineEvent> event = std::allocate_shared<SysEvent>(PoolAllocator<SysEvent>(),
+        "SysEventSource", static_cast<PipelineEventProducer*>(&eventSource), rawData);
     if (eventSource.CheckEvent(event)) {
         eventSource.PublishPipelineEvent(event);
     }
@@ -137,7 +141,9 @@ void SysEventSource::OnLoad()
 
     auto defFilePath = HiViewConfigUtil::GetConfigFilePath(DEF_ZIP_NAME, DEF_CFG_DIR, DEF_FILE_NAME);
     HIVIEW_LOGI("init json parser with %{public}s", defFilePath.c_str());
-    sysEventParser_ = std::make_shared<EventJsonParser>(defFilePath);
+    std::string workPath = GetHiviewContext()->GetHiViewDirectory(HiviewContext::DirectoryType::WORK_DIRECTORY);
+    sysEventParser_ = std::make_shared<EventJsonParser>(defFilePath,
+        FileUtil::IncludeTrailingPathDelimiter(workPath).append(DEF_IMAGE_NAME));
 
     SysEventServiceAdapter::BindGetTagFunc(
         [this] (const std::string& domain, const std::string& name) {
@@ -205,28 +211,17 @@ bool SysEventSource::PublishPipelineEvent(std::shared_ptr<PipelineEvent> event)
         HIVIEW_LOGW("hiviewPlatform is null");
         return false;
     }
-    auto const &pipelineRules = hiviewPlatform->GetPipelineConfigMap();
-    auto const &pipelineMap = hiviewPlatform->GetPipelineMap();
-    for (auto it = pipelineRules.begin(); it != pipelineRules.end(); it++) {
-        std::string pipelineName = it->first;
-        auto dispathRule = it->second;
-        if (dispathRule->FindEvent(event->domain_, event->eventName_)) {
-            pipelineMap.at(pipelineName)->ProcessEvent(event);
-            return true;
-        }
+    if (auto pipeline = hiviewPlatform->GetPipelineByEvent(event->domain_, event->eventName_); pipeline != nullptr) {
+        pipeline->ProcessEvent(event);
+        return true;
     }
+    auto const &pipelineMap = hiviewPlatform->GetPipelineMap();
     pipelineMap.at("SysEventPipeline")->ProcessEvent(event);
     return true;
 }
 
 bool SysEventSource::CheckEvent(std::shared_ptr<Event> event)
 {
-    if (isConfigUpdated_) {
-        auto defFilePath = HiViewConfigUtil::GetConfigFilePath(DEF_ZIP_NAME, DEF_CFG_DIR, DEF_FILE_NAME);
-        HIVIEW_LOGI("update json parser with %{public}s", defFilePath.c_str());
-        sysEventParser_->ReadDefFile(defFilePath);
-        isConfigUpdated_.store(false);
-    }
     std::shared_ptr<SysEvent> sysEvent = Convert2SysEvent(event);
     if (sysEvent == nullptr) {
         HIVIEW_LOGE("event or event parser is null.");
@@ -273,7 +268,7 @@ static void ShowUsage(int fd, const std::vector<std::string>& cmds)
         dprintf(fd, "%s ", it->c_str());
     }
     dprintf(fd, "\n");
-    dprintf(fd, "usage: SysEventService [sum|detail|invalid|clear]\n");
+    dprintf(fd, "usage: SysEventService [sum|detail|invalid|clear|recv]\n");
 }
 
 void SysEventSource::Dump(int fd, const std::vector<std::string>& cmds)
@@ -288,6 +283,8 @@ void SysEventSource::Dump(int fd, const std::vector<std::string>& cmds)
             sysEventStat_->StatInvalidDetail(fd);
         } else if (arg1 == "clear") {
             sysEventStat_->Clear(fd);
+        } else if (arg1 == "recv") {
+            eventServer_.Dump(fd);
         } else {
             ShowUsage(fd, cmds);
         }
@@ -298,7 +295,13 @@ void SysEventSource::Dump(int fd, const std::vector<std::string>& cmds)
 
 void SysEventSource::OnConfigUpdate(const std::string& localCfgPath, const std::string& cloudCfgPath)
 {
-    this->isConfigUpdated_.store(true);
+    if (sysEventParser_ == nullptr) {
+        return;
+    }
+    // the new table is swapped in atomically, so events in flight are never blocked by the reload
+    auto defFilePath = HiViewConfigUtil::GetConfigFilePath(DEF_ZIP_NAME, DEF_CFG_DIR, DEF_FILE_NAME);
+    HIVIEW_LOGI("update json parser with %{public}s", defFilePath.c_str());
+    sysEventParser_->ReadDefFile(defFilePath);
 }
 
 bool SysEventSource::IsValidSysEvent(const std::shared_ptr<SysEvent> event)
@@ -354,16 +357,14 @@ void SysEventSource::DecorateSysEvent(const std::shared_ptr<SysEvent> event, con
 
 bool SysEventSource::IsDuplicateEvent(const uint64_t eventId)
 {
-    for (auto iter = eventIdList_.rbegin(); iter != eventIdList_.rend(); ++iter) {
-        if (*iter == eventId) {
-            return true;
-        }
-    }
-    std::list<uint64_t>::size_type maxSize { 25 }; // size of queue limit to 25
-    if (eventIdList_.size() >= maxSize) {
-        eventIdList_.pop_front();
-    }
-    eventIdList_.emplace_back(eventId);
+    std::lock_guard<std::mutex> lock(eventIdMutex_);
+    if (std::find(eventIds_.begin(), eventIds_.begin() + eventIdCnt_, eventId) != eventIds_.begin() + eventIdCnt_) {
+        return true;
+    }
+    // the oldest id is overwritten once the cache is full
+    eventIds_[eventIdPos_] = eventId;
+    eventIdPos_ = (eventIdPos_ + 1) % EVENT_ID_CACHE_SIZE;
+    eventIdCnt_ = std::min(eventIdCnt_ + 1, EVENT_ID_CACHE_SIZE);
     return false;
 }
 } // namespace HiviewDFX
@@ -259,3 +259,25 @@ HWTEST_F(DailyControllerTest, DailyControllerTest012, TestSize.Level0)
     constexpr uint32_t threshold = 10000;
     EventWithoutThresholdTest(controller, event, threshold);
 }
+
+/**
+ * @tc.name: DailyControllerTest013
+ * @tc.desc: counts of the day survive the restart of controller.
+ * @tc.type: FUNC
+ * @tc.require: issueI9MZ5Z
+ */
+HWTEST_F(DailyControllerTest, DailyControllerTest013, TestSize.Level0)
+{
+    auto event = CreateEvent(TEST_DOMAIN, TEST_NAME, SysEventCreator::FAULT);
+    constexpr uint32_t thresholdOnBeta = 100;
+    constexpr uint32_t thresholdOnCommercial = 20;
+    uint32_t threshold = Parameter::IsBetaVersion() ? thresholdOnBeta : thresholdOnCommercial;
+    constexpr uint32_t countBeforeRestart = 10;
+    {
+        DailyController controller(WORK_PATH, CONFIG_PATH);
+        EventWithoutThresholdTest(controller, event, countBeforeRestart);
+    }
+
+    DailyController controller(WORK_PATH, CONFIG_PATH);
+    EventThresholdTest(controller, event, threshold - countBeforeRestart);
+}
@@ -15,12 +15,14 @@
 #include "event_json_parser_test.h"
 
 #include "event_json_parser.h"
+#include "file_util.h"
 
 namespace OHOS {
 namespace HiviewDFX {
 namespace {
 constexpr char TEST_DEF_FILE_PATH[] = "/data/test/hiview/sys_def_parser/hisysevent.def";
 constexpr char INVALID_TEST_DEF_FILE_PATH[] = "/data/test/hiview/sys_def_parser/hisysevent_.def";
+constexpr char TEST_DEF_IMAGE_PATH[] = "/data/test/hiview/sys_def_parser/hisysevent_def.img";
 constexpr char FIRST_TEST_DOMAIN[] = "FIRST_TEST_DOMAIN";
 constexpr char FIRST_TEST_NAME[] = "FIRST_TEST_NAME";
 constexpr int FIRST_TEST_EVENT_TYPE = 4;
@@ -68,5 +70,34 @@ HWTEST_F(EventJsonParserTest, EventJsonParserTest001, testing::ext::TestSize.Lev
     ASSERT_TRUE(configBaseInfo.preserve);
     ASSERT_EQ(configBaseInfo.privacy, DEFAULT_PRIVACY);
 }
+
+/**
+ * @tc.name: EventJsonParserTest002
+ * @tc.desc: compile def file into an image and load definitions from the image
+ * @tc.type: FUNC
+ * @tc.require: issueIAKF5E
+ */
+HWTEST_F(EventJsonParserTest, EventJsonParserTest002, testing::ext::TestSize.Level0)
+{
+    (void)FileUtil::RemoveFile(TEST_DEF_IMAGE_PATH);
+    EventJsonParser compiledParser(TEST_DEF_FILE_PATH, TEST_DEF_IMAGE_PATH);
+    ASSERT_TRUE(FileUtil::FileExists(TEST_DEF_IMAGE_PATH));
+    ASSERT_EQ(compiledParser.GetTagByDomainAndName(FIRST_TEST_DOMAIN, FIRST_TEST_NAME), "FIRST_TEST_CASE");
+
+    auto imageTable = EventDefTable::LoadImage(TEST_DEF_IMAGE_PATH, TEST_DEF_FILE_PATH);
+    ASSERT_NE(imageTable, nullptr);
+    BaseInfo baseInfo;
+    ASSERT_TRUE(imageTable->Find(SECOND_TEST_DOMAIN, SECOND_TEST_NAME, baseInfo));
+    ASSERT_EQ(baseInfo.type, SECOND_TEST_EVENT_TYPE);
+    ASSERT_EQ(baseInfo.tag, "SECOND_TEST_CASE");
+    ASSERT_FALSE(imageTable->Find(SECOND_TEST_DOMAIN, FIRST_TEST_NAME, baseInfo));
+    ASSERT_EQ(EventDefTable::LoadImage(TEST_DEF_IMAGE_PATH, INVALID_TEST_DEF_FILE_PATH), nullptr);
+
+    EventJsonParser imageParser(TEST_DEF_FILE_PATH, TEST_DEF_IMAGE_PATH);
+    ASSERT_EQ(imageParser.GetTypeByDomainAndName(FIRST_TEST_DOMAIN, FIRST_TEST_NAME), FIRST_TEST_EVENT_TYPE);
+    ASSERT_EQ(imageParser.GetPreserveByDomainAndName(FIRST_TEST_DOMAIN, FIRST_TEST_NAME), false);
+    ASSERT_EQ(imageParser.GetDefinedBaseInfoByDomainName(FIRST_TEST_DOMAIN, FIRST_TEST_NAME).privacy, TEST_PRIVACY);
+    (void)FileUtil::RemoveFile(TEST_DEF_IMAGE_PATH);
+}
 } // namespace HiviewDFX
 } // namespace OHOS
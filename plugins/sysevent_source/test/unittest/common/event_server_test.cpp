@@ -14,6 +14,13 @@
  */
 #include "event_server_test.h"
 
+#include <fcntl.h>
+#include <map>
+#include <mutex>
+#include <unistd.h>
+
+#include "base/raw_data_base_def.h"
+#include "event_dispatcher.h"
 #include "event_server.h"
 #include "file_util.h"
 
@@ -22,6 +29,38 @@ using namespace OHOS::HiviewDFX;
 
 namespace {
 const std::string BBOX_PATH = "/dev/bbox";
+constexpr size_t PID_POS = sizeof(int32_t) + EventRaw::POS_OF_PID_IN_HEADER;
+constexpr size_t SEQ_POS = sizeof(int32_t) + sizeof(EventRaw::HiSysEventHeader);
+
+std::shared_ptr<EventRaw::RawData> CreateRawData(int32_t pid, uint32_t seq)
+{
+    uint8_t data[SEQ_POS + sizeof(uint32_t)] = { 0 };
+    *(reinterpret_cast<int32_t*>(data)) = static_cast<int32_t>(sizeof(data));
+    *(reinterpret_cast<int32_t*>(data + PID_POS)) = pid;
+    *(reinterpret_cast<uint32_t*>(data + SEQ_POS)) = seq;
+    return std::make_shared<EventRaw::RawData>(data, sizeof(data));
+}
+
+class OrderRecorder : public EventReceiver {
+public:
+    void HandlerEvent(std::shared_ptr<EventRaw::RawData> rawData) override
+    {
+        int32_t pid = *(reinterpret_cast<int32_t*>(rawData->GetData() + PID_POS));
+        uint32_t seq = *(reinterpret_cast<uint32_t*>(rawData->GetData() + SEQ_POS));
+        std::lock_guard<std::mutex> lock(mutex_);
+        records_[pid].emplace_back(seq);
+    }
+
+    std::map<int32_t, std::vector<uint32_t>> GetRecords()
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return records_;
+    }
+
+private:
+    std::mutex mutex_;
+    std::map<int32_t, std::vector<uint32_t>> records_;
+};
 }
 
 void EventServerTest::SetUp()
@@ -59,3 +98,107 @@ HWTEST_F(EventServerTest, EventServerTest001, TestSize.Level3)
     res = bbox.Close();
     ASSERT_TRUE(res >= 0);
 }
+
+/**
+ * @tc.name: EventServerTest002
+ * @tc.desc: SocketDevice batch receive statistics test.
+ * @tc.type: FUNC
+ * @tc.require: issueI5NULM
+ */
+HWTEST_F(EventServerTest, EventServerTest002, TestSize.Level3)
+{
+    /**
+     * @tc.steps: step1. create socket device with invalid batch size.
+     * @tc.steps: step2. check the batch size is clamped and statistics are empty.
+     */
+    SocketDevice socket(0);
+    const std::string dumpFile = "/data/test/socket_device_dump.txt";
+    int fd = open(dumpFile.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+    ASSERT_GE(fd, 0);
+    socket.Dump(fd);
+    close(fd);
+    std::string content;
+    ASSERT_TRUE(FileUtil::LoadStringFromFile(dumpFile, content));
+    ASSERT_NE(content.find("batch_size=1,"), std::string::npos);
+    ASSERT_NE(content.find("msg_count=0,"), std::string::npos);
+    ASSERT_NE(content.find("drop_count=0"), std::string::npos);
+    (void)FileUtil::RemoveFile(dumpFile);
+}
+
+/**
+ * @tc.name: EventServerTest003
+ * @tc.desc: SpscQueue bounded push and pop test.
+ * @tc.type: FUNC
+ * @tc.require: issueI5NULM
+ */
+HWTEST_F(EventServerTest, EventServerTest003, TestSize.Level3)
+{
+    /**
+     * @tc.steps: step1. create queue with capacity which is not power of two.
+     * @tc.steps: step2. check the queue rejects items when full and pops them in order.
+     */
+    SpscQueue<uint32_t> queue(3); // 3 is rounded up to 4
+    ASSERT_EQ(queue.Capacity(), 4); // 4 is the capacity expected
+    for (uint32_t i = 0; i < queue.Capacity(); ++i) {
+        ASSERT_TRUE(queue.Push(std::move(i)));
+    }
+    uint32_t item = 0;
+    ASSERT_FALSE(queue.Push(std::move(item)));
+    ASSERT_EQ(queue.Size(), queue.Capacity());
+    for (uint32_t i = 0; i < queue.Capacity(); ++i) {
+        ASSERT_TRUE(queue.Pop(item));
+        ASSERT_EQ(item, i);
+    }
+    ASSERT_FALSE(queue.Pop(item));
+    ASSERT_EQ(queue.Size(), 0);
+}
+
+/**
+ * @tc.name: EventServerTest004
+ * @tc.desc: EventDispatcher keeps the order of events from the same process.
+ * @tc.type: FUNC
+ * @tc.require: issueI5NULM
+ */
+HWTEST_F(EventServerTest, EventServerTest004, TestSize.Level3)
+{
+    /**
+     * @tc.steps: step1. dispatch events of several processes by several workers.
+     * @tc.steps: step2. check all events are received in the order of each process.
+     */
+    auto recorder = std::make_shared<OrderRecorder>();
+    std::vector<std::shared_ptr<EventReceiver>> receivers = { recorder };
+    constexpr uint32_t workerNum = 3;
+    constexpr uint32_t eventNum = 1000;
+    const std::vector<int32_t> pids = { 100, 101, 102, 103, 104 };
+    EventDispatcher dispatcher(receivers, workerNum, eventNum * pids.size());
+    ASSERT_EQ(dispatcher.GetWorkerNum(), workerNum);
+    dispatcher.Start();
+    for (uint32_t seq = 0; seq < eventNum; ++seq) {
+        for (auto pid : pids) {
+            dispatcher.HandlerEvent(CreateRawData(pid, seq));
+        }
+    }
+    dispatcher.Stop(); // the events queued are dispatched before stopping
+
+    auto records = recorder->GetRecords();
+    ASSERT_EQ(records.size(), pids.size());
+    for (auto pid : pids) {
+        const auto& seqs = records[pid];
+        ASSERT_EQ(seqs.size(), eventNum);
+        for (uint32_t seq = 0; seq < eventNum; ++seq) {
+            ASSERT_EQ(seqs[seq], seq);
+        }
+    }
+
+    const std::string dumpFile = "/data/test/event_dispatcher_dump.txt";
+    int fd = open(dumpFile.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+    ASSERT_GE(fd, 0);
+    dispatcher.Dump(fd);
+    close(fd);
+    std::string content;
+    ASSERT_TRUE(FileUtil::LoadStringFromFile(dumpFile, content));
+    ASSERT_NE(content.find("worker_num=3"), std::string::npos);
+    ASSERT_NE(content.find("queue_depth=0"), std::string::npos);
+    ASSERT_NE(content.find("drop_count=0"), std::string::npos);
+    (void)FileUtil::RemoveFile(dumpFile);
+}
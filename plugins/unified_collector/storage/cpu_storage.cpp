@@ -14,6 +14,8 @@
  */
 #include "cpu_storage.h"
 
+#include <algorithm>
+#include <cinttypes>
 #include <functional>
 #include <map>
 
@@ -28,6 +30,7 @@
 #include "rdb_predicates.h"
 #include "sql_util.h"
 #include "string_util.h"
+#include "time_util.h"
 
 namespace OHOS {
 namespace HiviewDFX {
@@ -51,6 +54,7 @@ const std::string COLUMN_THREAD_CNT = "thread_cnt";
 const std::string COLUMN_VERSION_NAME = "name";
 constexpr uint32_t DEFAULT_PRECISION_OF_DECIMAL = 6; // 0.123456
 constexpr int32_t MEM_CG_PROCESS_FLAG = 100;
+constexpr uint64_t NS_PER_US = 1000;
 
 std::string CreateDbFileName()
 {
@@ -251,6 +255,7 @@ int CpuStorageDbCallback::OnUpgrade(NativeRdb::RdbStore& rdbStore, int oldVersio
 
 CpuStorage::CpuStorage(const std::string& workPath) : workPath_(workPath)
 {
+    processCollector_ = UCollectUtil::ProcessCollector::Create();
     InitDbStorePath();
     InitDbStore();
     if (dbStore_!= nullptr && GetStoredSysVersion() != Parameter::GetDisplayVersionStr()) {
@@ -287,64 +292,143 @@ void CpuStorage::InitDbStore()
     }
 }
 
-void CpuStorage::StoreProcessDatas(const std::vector<ProcessCpuStatInfo>& cpuCollectionInfos)
+void CpuStorage::StoreProcessDatas(const std::vector<ProcessCpuStatInfo>& cpuCollections)
+{
+    StoreCpuDatas(cpuCollections, {});
+}
+
+void CpuStorage::StoreThreadDatas(const std::vector<ThreadCpuStatInfo>& cpuCollections)
+{
+    StoreCpuDatas({}, cpuCollections);
+}
+
+void CpuStorage::StoreCpuDatas(const std::vector<ProcessCpuStatInfo>& processCollections,
+    const std::vector<ThreadCpuStatInfo>& threadCollections)
 {
     if (dbStore_ == nullptr) {
         HIVIEW_LOGW("db store is null, path=%{public}s", dbStorePath_.c_str());
         return;
     }
-    auto processCollector = UCollectUtil::ProcessCollector::Create();
-    auto result = processCollector->GetMemCgProcesses();
-    for (auto& cpuCollectionInfo : cpuCollectionInfos) {
-        if (NeedStoreInDb(cpuCollectionInfo)) {
-            StoreProcessData(cpuCollectionInfo, result.data);
+    std::vector<TableBuckets> tableBucketsList;
+    if (!processCollections.empty()) {
+        TableBuckets processBuckets {CPU_COLLECTION_TABLE_NAME, {}};
+        CreateProcessBuckets(processCollections, processBuckets.second);
+        tableBucketsList.emplace_back(std::move(processBuckets));
+    }
+    if (!threadCollections.empty()) {
+        TableBuckets threadBuckets {THREAD_CPU_COLLECTION_TABLE_NAME, {}};
+        CreateThreadBuckets(threadCollections, threadBuckets.second);
+        tableBucketsList.emplace_back(std::move(threadBuckets));
+    }
+    BatchInsert(tableBucketsList);
+}
+
+void CpuStorage::CreateProcessBuckets(const std::vector<ProcessCpuStatInfo>& cpuCollections,
+    std::vector<NativeRdb::ValuesBucket>& buckets)
+{
+    std::unordered_set<int32_t> memCgProcs;
+    if (processCollector_ != nullptr) {
+        memCgProcs = processCollector_->GetMemCgProcesses().data;
+    }
+    buckets.reserve(cpuCollections.size());
+    for (const auto& cpuCollectionInfo : cpuCollections) {
+        if (!NeedStoreInDb(cpuCollectionInfo)) {
+            continue;
         }
+        NativeRdb::ValuesBucket bucket;
+        bucket.PutLong(COLUMN_START_TIME, static_cast<int64_t>(cpuCollectionInfo.startTime));
+        bucket.PutLong(COLUMN_END_TIME, static_cast<int64_t>(cpuCollectionInfo.endTime));
+        bucket.PutInt(COLUMN_PID, cpuCollectionInfo.pid);
+        bucket.PutInt(COLUMN_PROC_STATE, GetPowerProcessStateInCollectionPeriod(cpuCollectionInfo, memCgProcs));
+        bucket.PutString(COLUMN_PROC_NAME, cpuCollectionInfo.procName);
+        bucket.PutDouble(COLUMN_CPU_LOAD, TruncateDecimalWithNBitPrecision(cpuCollectionInfo.cpuLoad));
+        bucket.PutDouble(COLUMN_CPU_USAGE, TruncateDecimalWithNBitPrecision(cpuCollectionInfo.cpuUsage));
+        bucket.PutInt(COLUMN_THREAD_CNT, cpuCollectionInfo.threadCount);
+        buckets.emplace_back(std::move(bucket));
     }
 }
 
-void CpuStorage::StoreThreadDatas(const std::vector<ThreadCpuStatInfo>& cpuCollections)
+void CpuStorage::CreateThreadBuckets(const std::vector<ThreadCpuStatInfo>& cpuCollections,
+    std::vector<NativeRdb::ValuesBucket>& buckets)
 {
-    if (dbStore_ == nullptr) {
-        HIVIEW_LOGW("db store is null, path=%{public}s", dbStorePath_.c_str());
-        return;
+    buckets.reserve(cpuCollections.size());
+    for (const auto& cpuCollection : cpuCollections) {
+        NativeRdb::ValuesBucket bucket;
+        bucket.PutLong(COLUMN_START_TIME, static_cast<int64_t>(cpuCollection.startTime));
+        bucket.PutLong(COLUMN_END_TIME, static_cast<int64_t>(cpuCollection.endTime));
+        bucket.PutInt(COLUMN_TID, cpuCollection.tid);
+        bucket.PutString(COLUMN_THREAD_NAME, "");
+        bucket.PutDouble(COLUMN_CPU_LOAD, TruncateDecimalWithNBitPrecision(cpuCollection.cpuLoad));
+        bucket.PutDouble(COLUMN_CPU_USAGE, TruncateDecimalWithNBitPrecision(cpuCollection.cpuUsage));
+        buckets.emplace_back(std::move(bucket));
     }
-    for (auto& cpuCollectionInfo : cpuCollections) {
-        StoreThreadData(cpuCollectionInfo);
+}
+
+void CpuStorage::BatchInsert(const std::vector<TableBuckets>& tableBucketsList)
+{
+    bool hasRows = std::any_of(tableBucketsList.begin(), tableBucketsList.end(), [] (const auto& tableBuckets) {
+        return !tableBuckets.second.empty();
+    });
+    if (!hasRows) {
+        return;
     }
+    uint64_t beginTime = TimeUtil::GetNanoTime();
+    uint64_t rowCnt = 0;
+    bool isSucc = BatchInsertInTransaction(tableBucketsList, rowCnt);
+    uint64_t costUs = (TimeUtil::GetNanoTime() - beginTime) / NS_PER_US;
+    UpdateStat(isSucc, rowCnt, costUs);
+    HIVIEW_LOGD("store cpu datas, succ=%{public}d, rows=%{public}" PRIu64 ", cost=%{public}" PRIu64 "us",
+        isSucc, rowCnt, costUs);
 }
 
-void CpuStorage::StoreProcessData(const ProcessCpuStatInfo& cpuCollectionInfo,
-    const std::unordered_set<int32_t>& memCgProcs)
+bool CpuStorage::BatchInsertInTransaction(const std::vector<TableBuckets>& tableBucketsList, uint64_t& rowCnt)
 {
-    NativeRdb::ValuesBucket bucket;
-    bucket.PutLong(COLUMN_START_TIME, static_cast<int64_t>(cpuCollectionInfo.startTime));
-    bucket.PutLong(COLUMN_END_TIME, static_cast<int64_t>(cpuCollectionInfo.endTime));
-    bucket.PutInt(COLUMN_PID, cpuCollectionInfo.pid);
-    bucket.PutInt(COLUMN_PROC_STATE, GetPowerProcessStateInCollectionPeriod(cpuCollectionInfo, memCgProcs));
-    bucket.PutString(COLUMN_PROC_NAME, cpuCollectionInfo.procName);
-    bucket.PutDouble(COLUMN_CPU_LOAD, TruncateDecimalWithNBitPrecision(cpuCollectionInfo.cpuLoad));
-    bucket.PutDouble(COLUMN_CPU_USAGE, TruncateDecimalWithNBitPrecision(cpuCollectionInfo.cpuUsage));
-    bucket.PutInt(COLUMN_THREAD_CNT, cpuCollectionInfo.threadCount);
-    int64_t seq = 0;
-    if (dbStore_->Insert(seq, CPU_COLLECTION_TABLE_NAME, bucket) != NativeRdb::E_OK) {
-        HIVIEW_LOGE("failed to insert cpu data to db store, pid=%{public}d, proc_name=%{public}s",
-            cpuCollectionInfo.pid, cpuCollectionInfo.procName.c_str());
+    // all rows of one collection cycle are inserted in one transaction instead of one transaction per row,
+    // and BatchInsert reuses one prepared statement for the rows of the same table
+    if (auto ret = dbStore_->BeginTransaction(); ret != NativeRdb::E_OK) {
+        HIVIEW_LOGW("failed to begin transaction, ret=%{public}d", ret);
+        return false;
     }
+    for (const auto& [tableName, buckets] : tableBucketsList) {
+        if (buckets.empty()) {
+            continue;
+        }
+        int64_t insertNum = 0;
+        if (auto ret = dbStore_->BatchInsert(insertNum, tableName, buckets); ret != NativeRdb::E_OK || insertNum < 0) {
+            HIVIEW_LOGE("failed to insert cpu datas to %{public}s, size=%{public}zu, ret=%{public}d",
+                tableName.c_str(), buckets.size(), ret);
+            dbStore_->RollBack();
+            rowCnt = 0;
+            return false;
+        }
+        rowCnt += static_cast<uint64_t>(insertNum);
+    }
+    if (auto ret = dbStore_->Commit(); ret != NativeRdb::E_OK) {
+        HIVIEW_LOGW("failed to commit transaction, ret=%{public}d", ret);
+        dbStore_->RollBack();
+        rowCnt = 0;
+        return false;
+    }
+    return true;
 }
 
-void CpuStorage::StoreThreadData(const ThreadCpuStatInfo& cpuCollection)
+void CpuStorage::UpdateStat(bool isSucc, uint64_t rowCnt, uint64_t costUs)
 {
-    NativeRdb::ValuesBucket bucket;
-    bucket.PutLong(COLUMN_START_TIME, static_cast<int64_t>(cpuCollection.startTime));
-    bucket.PutLong(COLUMN_END_TIME, static_cast<int64_t>(cpuCollection.endTime));
-    bucket.PutInt(COLUMN_TID, cpuCollection.tid);
-    bucket.PutString(COLUMN_THREAD_NAME, "");
-    bucket.PutDouble(COLUMN_CPU_LOAD, TruncateDecimalWithNBitPrecision(cpuCollection.cpuLoad));
-    bucket.PutDouble(COLUMN_CPU_USAGE, TruncateDecimalWithNBitPrecision(cpuCollection.cpuUsage));
-    int64_t seq = 0;
-    if (dbStore_->Insert(seq, THREAD_CPU_COLLECTION_TABLE_NAME, bucket) != NativeRdb::E_OK) {
-        HIVIEW_LOGE("failed to insert cpu data to db store, tid=%{public}d", cpuCollection.tid);
+    std::lock_guard<std::mutex> lock(statMutex_);
+    stat_.cycleCnt++;
+    if (!isSucc) {
+        stat_.failedCycleCnt++;
     }
+    stat_.insertedRowCnt += rowCnt;
+    stat_.totalCostUs += costUs;
+    stat_.lastCostUs = costUs;
+    stat_.maxCostUs = std::max(stat_.maxCostUs, costUs);
+}
+
+CpuStorageStat CpuStorage::GetStat()
+{
+    std::lock_guard<std::mutex> lock(statMutex_);
+    return stat_;
 }
 
 void CpuStorage::Report()
@@ -17,8 +17,13 @@
 #define HIVIEW_PLUGINS_UNIFIED_COLLECTOR_STORAGE_INCLUDE_CPU_STORAGE_H
 
 #include <memory>
+#include <mutex>
+#include <string>
 #include <unordered_set>
+#include <utility>
+#include <vector>
 
+#include "process_collector.h"
 #include "resource/cpu.h"
 #include "rdb_helper.h"
 #include "rdb_store.h"
@@ -31,19 +36,38 @@ public:
     int OnUpgrade(NativeRdb::RdbStore& rdbStore, int oldVersion, int newVersion) override;
 }; // CpuStorageDbCallback
 
+struct CpuStorageStat {
+    uint64_t cycleCnt = 0;
+    uint64_t failedCycleCnt = 0;
+    uint64_t insertedRowCnt = 0;
+    uint64_t totalCostUs = 0;
+    uint64_t lastCostUs = 0;
+    uint64_t maxCostUs = 0;
+}; // CpuStorageStat
+
 class CpuStorage {
 public:
     CpuStorage(const std::string& workPath);
     ~CpuStorage() = default;
     void StoreProcessDatas(const std::vector<ProcessCpuStatInfo>& cpuCollections);
     void StoreThreadDatas(const std::vector<ThreadCpuStatInfo>& cpuCollections);
+    void StoreCpuDatas(const std::vector<ProcessCpuStatInfo>& processCollections,
+        const std::vector<ThreadCpuStatInfo>& threadCollections);
     void Report();
+    CpuStorageStat GetStat();
 
 private:
+    using TableBuckets = std::pair<std::string, std::vector<NativeRdb::ValuesBucket>>;
+
     void InitDbStorePath();
     void InitDbStore();
-    void StoreProcessData(const ProcessCpuStatInfo& cpuCollection, const std::unordered_set<int32_t>& memcgProcs);
-    void StoreThreadData(const ThreadCpuStatInfo& cpuCollection);
+    void CreateProcessBuckets(const std::vector<ProcessCpuStatInfo>& cpuCollections,
+        std::vector<NativeRdb::ValuesBucket>& buckets);
+    void CreateThreadBuckets(const std::vector<ThreadCpuStatInfo>& cpuCollections,
+        std::vector<NativeRdb::ValuesBucket>& buckets);
+    void BatchInsert(const std::vector<TableBuckets>& tableBucketsList);
+    bool BatchInsertInTransaction(const std::vector<TableBuckets>& tableBucketsList, uint64_t& rowCnt);
+    void UpdateStat(bool isSucc, uint64_t rowCnt, uint64_t costUs);
     bool NeedReport();
     void PrepareOldDbFilesBeforeReport();
     void ResetDbStore();
@@ -57,6 +81,9 @@ private:
     std::string dbStorePath_;
     std::string dbStoreUploadPath_;
     std::shared_ptr<NativeRdb::RdbStore> dbStore_;
+    std::shared_ptr<UCollectUtil::ProcessCollector> processCollector_;
+    std::mutex statMutex_;
+    CpuStorageStat stat_;
 }; // CpuStorage
 } // namespace HiviewDFX
 } // namespace OHOS
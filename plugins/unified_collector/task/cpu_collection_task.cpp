@@ -52,6 +52,15 @@ void CpuCollectionTask::Collect()
     CollectCpuData();
 }
 
+bool CpuCollectionTask::GetStorageStat(CpuStorageStat& stat)
+{
+    if (cpuStorage_ == nullptr) {
+        return false;
+    }
+    stat = cpuStorage_->GetStat();
+    return true;
+}
+
 void CpuCollectionTask::InitCpuCollector()
 {
     cpuCollector_ = UCollectUtil::CpuCollector::Create();
@@ -108,22 +117,25 @@ void CpuCollectionTask::CheckAndDumpTraceData()
 
 void CpuCollectionTask::CollectCpuData()
 {
+    std::vector<ProcessCpuStatInfo> processCpuStatInfos;
     auto cpuCollectionsResult = cpuCollector_->CollectProcessCpuStatInfos(true);
     if (cpuCollectionsResult.retCode == UCollect::UcError::SUCCESS) {
-        if (Parameter::IsBetaVersion()) {
-            cpuStorage_->StoreProcessDatas(cpuCollectionsResult.data);
-        }
-
 #ifdef HAS_HIPERF
         cpuPerfDump_->CheckAndDumpPerfData(cpuCollectionsResult.data);
 #endif
+        processCpuStatInfos = std::move(cpuCollectionsResult.data);
     }
+    std::vector<ThreadCpuStatInfo> threadCpuStatInfos;
     if (threadCpuCollector_ != nullptr) {
         auto threadCpuCollectResult = threadCpuCollector_ ->CollectThreadStatInfos(true);
-        if (Parameter::IsBetaVersion() && threadCpuCollectResult.retCode == UCollect::UcError::SUCCESS) {
-            cpuStorage_->StoreThreadDatas(threadCpuCollectResult.data);
+        if (threadCpuCollectResult.retCode == UCollect::UcError::SUCCESS) {
+            threadCpuStatInfos = std::move(threadCpuCollectResult.data);
         }
     }
+    // process and thread datas of one collection cycle are stored in one transaction
+    if (Parameter::IsBetaVersion()) {
+        cpuStorage_->StoreCpuDatas(processCpuStatInfos, threadCpuStatInfos);
+    }
     // collect the system cpu usage periodically for hidumper
     cpuCollector_->CollectSysCpuUsage(true);
 
@@ -29,6 +29,7 @@ public:
     CpuCollectionTask(const std::string& workPath);
     ~CpuCollectionTask() = default;
     void Collect();
+    bool GetStorageStat(CpuStorageStat& stat);
 
 private:
     void InitCpuCollector();
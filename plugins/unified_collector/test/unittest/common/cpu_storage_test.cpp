@@ -15,11 +15,16 @@
 
 #include "cpu_storage_test.h"
 
+#include "cpu_storage.h"
+#include "file_util.h"
 #include "gmock/gmock-matchers.h"
 #include "power_status_manager.h"
 
 using namespace testing::ext;
 using namespace OHOS::HiviewDFX;
+namespace {
+const std::string CPU_STORAGE_TEST_PATH = "/data/test/cpu_storage_test/";
+}
 
 void CpuStorageTest::SetUpTestCase()
 {
@@ -57,3 +62,47 @@ HWTEST_F(CpuStorageTest, CpuStorageTest001, TestSize.Level3)
     ASSERT_EQ(powerState3, UCollectUtil::SCREEN_OFF);
 }
 #endif
+
+/**
+ * @tc.name: CpuStorageTest002
+ * @tc.desc: CpuStorage stores process and thread datas of one cycle in batch
+ * @tc.type: FUNC
+ * @tc.require: issueI5NULM
+ */
+HWTEST_F(CpuStorageTest, CpuStorageTest002, TestSize.Level1)
+{
+    FileUtil::ForceRemoveDirectory(CPU_STORAGE_TEST_PATH);
+    CpuStorage cpuStorage(CPU_STORAGE_TEST_PATH);
+    ASSERT_EQ(cpuStorage.GetStat().cycleCnt, 0);
+
+    const int32_t procCnt = 300;
+    std::vector<ProcessCpuStatInfo> processInfos;
+    for (int32_t i = 1; i <= procCnt; ++i) {
+        ProcessCpuStatInfo info;
+        info.startTime = 1000; // 1000: start time
+        info.endTime = 2000; // 2000: end time
+        info.pid = i;
+        info.procName = "proc_" + std::to_string(i);
+        info.cpuLoad = 0.01; // 0.01: 1% cpu load
+        info.cpuUsage = 0.01; // 0.01: 1% cpu usage
+        processInfos.emplace_back(info);
+    }
+    ProcessCpuStatInfo invalidInfo;
+    processInfos.emplace_back(invalidInfo);
+    std::vector<ThreadCpuStatInfo> threadInfos(10); // 10: thread count
+    cpuStorage.StoreCpuDatas(processInfos, threadInfos);
+    auto stat = cpuStorage.GetStat();
+    ASSERT_EQ(stat.cycleCnt, 1);
+    ASSERT_EQ(stat.failedCycleCnt, 0);
+    ASSERT_EQ(stat.insertedRowCnt, procCnt + threadInfos.size());
+    ASSERT_EQ(stat.lastCostUs, stat.totalCostUs);
+
+    cpuStorage.StoreProcessDatas(processInfos);
+    cpuStorage.StoreThreadDatas(threadInfos);
+    stat = cpuStorage.GetStat();
+    ASSERT_EQ(stat.cycleCnt, 3); // 3: cycle count
+    ASSERT_EQ(stat.insertedRowCnt, (procCnt + threadInfos.size()) * 2); // 2: stored twice
+
+    cpuStorage.StoreCpuDatas({invalidInfo}, {});
+    ASSERT_EQ(cpuStorage.GetStat().cycleCnt, 3); // 3: no rows to store, cycle count is not changed
+}
@@ -14,6 +14,7 @@
  */
 #include "unified_collector.h"
 
+#include <cinttypes>
 #include <memory>
 
 #include "app_caller_event.h"
@@ -314,6 +315,17 @@ void UnifiedCollector::Dump(int fd, const std::vector<std::string>& cmds)
 
     TraceManager traceManager;
     dprintf(fd, "trace mode is %d.\n", traceManager.GetTraceMode());
+
+    CpuStorageStat cpuStorageStat;
+    if (auto cpuCollectionTask = std::atomic_load(&cpuCollectionTask_);
+        cpuCollectionTask != nullptr && cpuCollectionTask->GetStorageStat(cpuStorageStat)) {
+        uint64_t rowsPerSec = (cpuStorageStat.totalCostUs == 0) ? 0 :
+            (cpuStorageStat.insertedRowCnt * 1000000 / cpuStorageStat.totalCostUs); // 1000000: us per second
+        dprintf(fd, "cpu storage: cycles=%" PRIu64 ", failed cycles=%" PRIu64 ", rows=%" PRIu64
+            ", rows per second=%" PRIu64 ", last cycle cost=%" PRIu64 "us, max cycle cost=%" PRIu64 "us.\n",
+            cpuStorageStat.cycleCnt, cpuStorageStat.failedCycleCnt, cpuStorageStat.insertedRowCnt, rowsPerSec,
+            cpuStorageStat.lastCostUs, cpuStorageStat.maxCostUs);
+    }
 }
 
 void UnifiedCollector::Init()
@@ -439,7 +451,7 @@ void UnifiedCollector::RunCpuCollectionTask()
 
 void UnifiedCollector::CpuCollectionFfrtTask()
 {
-    cpuCollectionTask_ = std::make_shared<CpuCollectionTask>(workPath_);
+    std::atomic_store(&cpuCollectionTask_, std::make_shared<CpuCollectionTask>(workPath_));
     while (true) {
         if (!isCpuTaskRunning_) {
             HIVIEW_LOGE("exit cpucollection task");
@@ -119,6 +119,7 @@ void HiviewService::DumpDetailedInfo(int fd)
         parser_.reset();
     }
     DumpLoadedPluginInfo(fd);
+    HiviewPlatform::GetInstance().DumpRouteIndex(fd);
     parser_ = std::make_unique<AuditLogParser>();
     parser_->StartParse();
     std::string timeScope = parser_->GetAuditLogTimeScope();
@@ -12,15 +12,23 @@
  * See the License for the specific language governing permissions and
  * limitations under the License.
  */
+#include <algorithm>
+#include <chrono>
 #include <dlfcn.h>
 #include <fcntl.h>
 #include <fstream>
+#include <functional>
 #include <iostream>
+#include <limits>
+#include <map>
 #include <regex>
+#include <sstream>
 #include <string>
+#include <unistd.h>
 
 #include "common_utils.h"
 #include "file_util.h"
+#include "proc_scanner.h"
 #include "string_util.h"
 #include "memory_collector.h"
 
@@ -73,6 +81,55 @@ const std::string RAW_SLAB_STR4("( <\\w{1,}>){5} : tunables( <\\w{1,}>){3} : sla
 const std::regex RAW_SLAB_INFO2(RAW_SLAB_STR3 + RAW_SLAB_STR4);
 const std::regex RAW_SLAB_INFO3("-{52}");
 
+// the way of collecting memory of all processes before ProcScanner, used as the baseline of benchmark
+std::vector<ProcessMemory> LegacyCollectAllProcessMemory()
+{
+    static std::map<std::string, std::function<void(ProcessMemory&, int32_t)>> assignFuncMap = {
+        {"Rss", [] (ProcessMemory& memory, int32_t value) {
+            memory.rss = value;
+        }},
+        {"Pss", [] (ProcessMemory& memory, int32_t value) {
+            memory.pss = value;
+        }},
+        {"SwapPss", [] (ProcessMemory& memory, int32_t value) {
+            memory.swapPss = value;
+        }},
+    };
+    std::vector<ProcessMemory> procMems;
+    std::vector<std::string> procFiles;
+    FileUtil::GetDirFiles("/proc/", procFiles, false);
+    for (const auto& procFile : procFiles) {
+        std::string fileName = FileUtil::ExtractFileName(procFile);
+        int pid = 0;
+        if (!StringUtil::StrToInt(fileName, pid) || !FileUtil::FileExists(procFile)) {
+            continue;
+        }
+        ProcessMemory procMem;
+        procMem.pid = pid;
+        procMem.name = CommonUtils::GetProcFullNameByPid(pid);
+        if (procMem.name.empty()) {
+            continue;
+        }
+        std::string content;
+        FileUtil::LoadStringFromFile(procFile + "/smaps_rollup", content);
+        std::vector<std::string> lines;
+        StringUtil::SplitStr(content, "\n", lines);
+        for (const auto& line : lines) {
+            auto typePos = line.find(":");
+            if (typePos == std::string::npos) {
+                continue;
+            }
+            int32_t value = 0;
+            std::istringstream(line.substr(typePos + 1)) >> value;
+            if (auto iter = assignFuncMap.find(line.substr(0, typePos)); iter != assignFuncMap.end()) {
+                iter->second(procMem, value);
+            }
+        }
+        procMems.emplace_back(procMem);
+    }
+    return procMems;
+}
+
 bool HasValidAILibrary()
 {
     const std::string libName = "libai_mnt_client.so";
@@ -356,3 +413,71 @@ HWTEST_F(MemoryCollectorTest, MemoryCollectorTest016, TestSize.Level1)
         ASSERT_GT(data.data, 0);
     }
 }
+
+/**
+ * @tc.name: MemoryCollectorTest017
+ * @tc.desc: used to test the parsers of ProcScanner
+ * @tc.type: FUNC
+*/
+HWTEST_F(MemoryCollectorTest, MemoryCollectorTest017, TestSize.Level1)
+{
+    int64_t value = 0;
+    ASSERT_TRUE(ProcParser::ParseInt("   1234 kB", value));
+    ASSERT_EQ(value, 1234);
+    ASSERT_TRUE(ProcParser::ParseInt("-1000\n", value));
+    ASSERT_EQ(value, -1000);
+    ASSERT_FALSE(ProcParser::ParseInt("  kB", value));
+
+    std::string smaps = "00400000-ffffffff ---p 00000000 00:00 0  [rollup]\nRss:  100 kB\nPss:   50 kB\n"
+        "SwapPss:  7 kB\nLocked:  0 kB";
+    std::map<std::string, int64_t> values;
+    ProcParser::ParseKeyValueLines(smaps, [&values] (std::string_view key, int64_t value) {
+        values[std::string(key)] = value;
+    });
+    ASSERT_EQ(values.size(), 4); // 4: lines with key
+    ASSERT_EQ(values["Rss"], 100);
+    ASSERT_EQ(values["Pss"], 50);
+    ASSERT_EQ(values["SwapPss"], 7);
+
+    const char cmdlineContent[] = "/system/bin/hiview\0-d\0";
+    std::string cmdline(cmdlineContent, sizeof(cmdlineContent) - 1);
+    ASSERT_EQ(ProcParser::ParseProcNameFromCmdline(cmdline), "hiview");
+    ASSERT_EQ(ProcParser::ParseProcNameFromStat("40 (kworker/0:1) I 2"), "kworker/0:1");
+    ASSERT_EQ(ProcParser::TrimLine("hiview\n"), "hiview");
+    ASSERT_EQ(ProcParser::ToInt32(5000000000), std::numeric_limits<int32_t>::max()); // 5000000000 overflows int32
+    ASSERT_EQ(ProcParser::ToInt32(-5000000000), std::numeric_limits<int32_t>::min()); // -5000000000 overflows int32
+
+    ProcScanner scanner;
+    ASSERT_TRUE(scanner.IsValid());
+    auto reader = scanner.CreateReader();
+    ASSERT_EQ(reader.ReadProcName(getpid()), CommonUtils::GetProcFullNameByPid(getpid()));
+
+    // the reader of a single pid reads by the /proc fd shared by the process
+    ProcFileReader sharedReader;
+    ASSERT_EQ(sharedReader.ReadProcName(getpid()), CommonUtils::GetProcFullNameByPid(getpid()));
+}
+
+/**
+ * @tc.name: MemoryCollectorTest018
+ * @tc.desc: used to compare the cost of MemoryCollector.CollectAllProcessMemory with the legacy way
+ * @tc.type: FUNC
+*/
+HWTEST_F(MemoryCollectorTest, MemoryCollectorTest018, TestSize.Level3)
+{
+    std::shared_ptr<MemoryCollector> collector = MemoryCollector::Create();
+    auto begin = std::chrono::steady_clock::now();
+    auto legacyProcMems = LegacyCollectAllProcessMemory();
+    auto legacyCost = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - begin);
+    begin = std::chrono::steady_clock::now();
+    CollectResult<std::vector<ProcessMemory>> data = collector->CollectAllProcessMemory();
+    auto scannerCost = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - begin);
+    printf("legacy scan: %zu processes in %lldus, proc scanner: %zu processes in %lldus\n", legacyProcMems.size(),
+        static_cast<long long>(legacyCost.count()), data.data.size(), static_cast<long long>(scannerCost.count()));
+    ASSERT_EQ(data.retCode, UcError::SUCCESS);
+    ASSERT_FALSE(data.data.empty());
+    auto iter = std::find_if(data.data.begin(), data.data.end(), [] (const ProcessMemory& procMem) {
+        return procMem.pid == getpid();
+    });
+    ASSERT_TRUE(iter != data.data.end());
+    ASSERT_GT(iter->rss, 0);
+}